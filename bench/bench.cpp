@@ -0,0 +1,417 @@
+// Copyright (c) 2017-2019 Michael C. Heiber
+// This source file is part of the Excimontec project, which is subject to the MIT License.
+// For more information, see the LICENSE file that accompanies this software.
+// The Excimontec project can be found on Github at https://github.com/MikeHeiber/Excimontec
+
+#include "benchmark/benchmark.h"
+#include "EventHeap.h"
+#include "OSC_Sim.h"
+#include "Parameters.h"
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace KMC_Lattice;
+
+namespace Excimontec {
+
+	//! \brief This class gives the benchmark suite access to the private simulation kernels of the OSC_Sim class.
+	class OSC_SimBenchmark {
+	public:
+		static double calculateCoulomb(const OSC_Sim& sim, const list<Polaron>::const_iterator polaron_it, const Coords& coords) {
+			return sim.calculateCoulomb(polaron_it, coords);
+		}
+
+		static double calculateCoulomb(const OSC_Sim& sim, const bool charge, const Coords& coords) {
+			return sim.calculateCoulomb(charge, coords);
+		}
+
+		static void calculateDOSCorrelation(OSC_Sim& sim, const double cutoff_radius) {
+			sim.DOS_correlation_data.clear();
+			sim.calculateDOSCorrelation(cutoff_radius);
+		}
+
+		static void calculateExcitonEvents(OSC_Sim& sim, Exciton* exciton_ptr) {
+			sim.calculateExcitonEvents(exciton_ptr);
+		}
+
+		static void calculatePolaronEvents(OSC_Sim& sim, Polaron* polaron_ptr) {
+			sim.calculatePolaronEvents(polaron_ptr);
+		}
+
+		static Coords calculateRandomExcitonCreationCoords(OSC_Sim& sim) {
+			return sim.calculateRandomExcitonCreationCoords();
+		}
+
+		static void createCorrelatedDOS(OSC_Sim& sim, const double correlation_length) {
+			sim.createCorrelatedDOS(correlation_length);
+		}
+
+		static bool createImportedMorphology(OSC_Sim& sim) {
+			// The site counters are incremented during the import, so they are reset before each import
+			sim.N_donor_sites = 0;
+			sim.N_acceptor_sites = 0;
+			return sim.createImportedMorphology();
+		}
+
+		static Coords deleteFirstHole(OSC_Sim& sim) {
+			Coords coords = sim.holes.front().getCoords();
+			sim.deleteObject(&sim.holes.front());
+			sim.N_holes--;
+			return coords;
+		}
+
+		static vector<Exciton*> getExcitonPtrs(OSC_Sim& sim) {
+			vector<Exciton*> exciton_ptrs;
+			for (auto& item : sim.excitons) {
+				exciton_ptrs.push_back(&item);
+			}
+			return exciton_ptrs;
+		}
+
+		static void generateHole(OSC_Sim& sim, const Coords& coords) {
+			sim.generateHole(coords, 0);
+			sim.calculatePolaronEvents(&sim.holes.back());
+		}
+
+		static vector<list<Polaron>::iterator> getHoleIts(OSC_Sim& sim) {
+			vector<list<Polaron>::iterator> hole_its;
+			for (auto it = sim.holes.begin(); it != sim.holes.end(); ++it) {
+				hole_its.push_back(it);
+			}
+			return hole_its;
+		}
+
+		static list<Polaron>::iterator getPolaronIt(OSC_Sim& sim, const Object* object_ptr) {
+			return sim.getPolaronIt(object_ptr);
+		}
+
+		static void updateSteadyData(OSC_Sim& sim) {
+			// The event counter is set so that both the density of states and the density of occupied states are sampled
+			sim.N_events_executed = sim.params.N_equilibration_events + (long int)sim.Steady_hops_per_DOS_sample * sim.Steady_hops_per_DOOS_sample;
+			sim.updateSteadyData();
+		}
+	};
+
+}
+
+using namespace Excimontec;
+
+namespace OSC_SimBenchmarks {
+
+	// Synthetic lattice sizes and carrier densities (as log10 of the density in cm^-3) used by the steady transport benchmarks
+	const vector<int64_t> Lattice_sizes = { 30, 50, 80 };
+	const vector<int64_t> Density_exponents = { 17, 18, 19 };
+
+	// Loads the default parameters and sets up a steady transport test on a neat cubic lattice with a Gaussian DOS
+	Parameters createSteadyParameters(const int length, const double density) {
+		Parameters params;
+		ifstream parameter_file("parameters_default.txt");
+		if (!params.importParameters(parameter_file)) {
+			cout << "Error! The benchmarks must be run from the root directory, where parameters_default.txt is located." << endl;
+		}
+		parameter_file.close();
+		params.Params_lattice.Length = length;
+		params.Params_lattice.Width = length;
+		params.Params_lattice.Height = length;
+		params.Enable_exciton_diffusion_test = false;
+		params.Enable_steady_transport_test = true;
+		params.Steady_carrier_density = density;
+		params.N_equilibration_events = 1000000000;
+		params.N_tests = 1000000000;
+		params.Internal_potential = -1.0;
+		params.Enable_gaussian_dos = true;
+		params.Energy_stdev_donor = 0.075;
+		params.Coulomb_cutoff = 15;
+		return params;
+	}
+
+	// Initializes a steady transport simulation and skips the benchmark if the initialization fails
+	bool initSteadySim(benchmark::State& state, OSC_Sim& sim) {
+		auto params = createSteadyParameters((int)state.range(0), pow(10.0, (double)state.range(1)));
+		if (!sim.init(params, 0)) {
+			state.SkipWithError(("Simulation initialization failed: " + sim.getErrorMessage()).c_str());
+			return false;
+		}
+		state.counters["polarons"] = (double)OSC_SimBenchmark::getHoleIts(sim).size();
+		return true;
+	}
+
+	void SteadyArguments(benchmark::internal::Benchmark* bench) {
+		bench->ArgNames({ "length", "log_density" });
+		for (auto length : Lattice_sizes) {
+			for (auto exponent : Density_exponents) {
+				bench->Args({ length, exponent });
+			}
+		}
+	}
+
+	void BM_calculateCoulomb_polaron(benchmark::State& state) {
+		OSC_Sim sim;
+		if (!initSteadySim(state, sim)) {
+			return;
+		}
+		auto hole_its = OSC_SimBenchmark::getHoleIts(sim);
+		int length = (int)state.range(0);
+		int n = 0;
+		for (auto _ : state) {
+			Coords coords(n % length, (n / 3) % length, (n / 7) % length);
+			benchmark::DoNotOptimize(OSC_SimBenchmark::calculateCoulomb(sim, hole_its[n % hole_its.size()], coords));
+			n++;
+		}
+		state.SetItemsProcessed(state.iterations());
+	}
+	BENCHMARK(BM_calculateCoulomb_polaron)->Apply(SteadyArguments);
+
+	void BM_calculateCoulomb_charge(benchmark::State& state) {
+		OSC_Sim sim;
+		if (!initSteadySim(state, sim)) {
+			return;
+		}
+		int length = (int)state.range(0);
+		int n = 0;
+		for (auto _ : state) {
+			Coords coords(n % length, (n / 3) % length, (n / 7) % length);
+			benchmark::DoNotOptimize(OSC_SimBenchmark::calculateCoulomb(sim, true, coords));
+			n++;
+		}
+		state.SetItemsProcessed(state.iterations());
+	}
+	BENCHMARK(BM_calculateCoulomb_charge)->Apply(SteadyArguments);
+
+	void BM_calculatePolaronEvents(benchmark::State& state) {
+		OSC_Sim sim;
+		if (!initSteadySim(state, sim)) {
+			return;
+		}
+		auto hole_its = OSC_SimBenchmark::getHoleIts(sim);
+		int n = 0;
+		for (auto _ : state) {
+			OSC_SimBenchmark::calculatePolaronEvents(sim, &(*hole_its[n % hole_its.size()]));
+			n++;
+		}
+		state.SetItemsProcessed(state.iterations());
+	}
+	BENCHMARK(BM_calculatePolaronEvents)->Apply(SteadyArguments);
+
+	void BM_executeNextEvent(benchmark::State& state) {
+		OSC_Sim sim;
+		if (!initSteadySim(state, sim)) {
+			return;
+		}
+		for (auto _ : state) {
+			if (!sim.executeNextEvent()) {
+				state.SkipWithError(("Event execution failed: " + sim.getErrorMessage()).c_str());
+				break;
+			}
+		}
+		state.SetItemsProcessed(state.iterations());
+	}
+	BENCHMARK(BM_executeNextEvent)->Apply(SteadyArguments);
+
+	void BM_deleteObject(benchmark::State& state) {
+		OSC_Sim sim;
+		if (!initSteadySim(state, sim)) {
+			return;
+		}
+		for (auto _ : state) {
+			Coords coords = OSC_SimBenchmark::deleteFirstHole(sim);
+			// The deleted hole is replaced at the end of the hole list so that the carrier density stays constant
+			state.PauseTiming();
+			OSC_SimBenchmark::generateHole(sim, coords);
+			state.ResumeTiming();
+		}
+		state.SetItemsProcessed(state.iterations());
+	}
+	BENCHMARK(BM_deleteObject)->Apply(SteadyArguments);
+
+	void BM_getPolaronIt(benchmark::State& state) {
+		OSC_Sim sim;
+		if (!initSteadySim(state, sim)) {
+			return;
+		}
+		vector<Object*> object_ptrs;
+		for (auto it : OSC_SimBenchmark::getHoleIts(sim)) {
+			object_ptrs.push_back(&(*it));
+		}
+		int n = 0;
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(OSC_SimBenchmark::getPolaronIt(sim, object_ptrs[n % object_ptrs.size()]));
+			n++;
+		}
+		state.SetItemsProcessed(state.iterations());
+	}
+	BENCHMARK(BM_getPolaronIt)->Apply(SteadyArguments);
+
+	void BM_updateSteadyData(benchmark::State& state) {
+		OSC_Sim sim;
+		if (!initSteadySim(state, sim)) {
+			return;
+		}
+		for (auto _ : state) {
+			OSC_SimBenchmark::updateSteadyData(sim);
+		}
+		state.SetItemsProcessed(state.iterations());
+	}
+	BENCHMARK(BM_updateSteadyData)->Apply(SteadyArguments)->Unit(benchmark::kMillisecond);
+
+	// Each iteration moves the execution time of one random event later, as after the event of an object is executed, and then finds the earliest event
+	void BM_eventSelection_heap(benchmark::State& state) {
+		mt19937_64 generator(0);
+		uniform_real_distribution<double> dist(0.0, 1.0);
+		EventHeap heap;
+		vector<double> times(state.range(0));
+		for (int i = 0; i < (int)times.size(); i++) {
+			times[i] = dist(generator);
+			heap.setTime(heap.addSlot(), times[i]);
+		}
+		for (auto _ : state) {
+			int slot = heap.getTop();
+			times[slot] += dist(generator);
+			heap.setTime(slot, times[slot]);
+			benchmark::DoNotOptimize(heap.getTop());
+		}
+		state.SetItemsProcessed(state.iterations());
+	}
+	BENCHMARK(BM_eventSelection_heap)->ArgName("events")->RangeMultiplier(10)->Range(10, 100000);
+
+	// Same as BM_eventSelection_heap, but the earliest event is found with a linear search like the event list of KMC_Lattice::Simulation
+	void BM_eventSelection_scan(benchmark::State& state) {
+		mt19937_64 generator(0);
+		uniform_real_distribution<double> dist(0.0, 1.0);
+		list<double> times;
+		for (int i = 0; i < state.range(0); i++) {
+			times.push_back(dist(generator));
+		}
+		auto it_min = min_element(times.begin(), times.end());
+		for (auto _ : state) {
+			*it_min += dist(generator);
+			it_min = min_element(times.begin(), times.end());
+			benchmark::DoNotOptimize(it_min);
+		}
+		state.SetItemsProcessed(state.iterations());
+	}
+	BENCHMARK(BM_eventSelection_scan)->ArgName("events")->RangeMultiplier(10)->Range(10, 100000);
+
+	void BM_calculateExcitonEvents(benchmark::State& state) {
+		// Excitons are created on a neat lattice with the default exciton parameters
+		auto params = createSteadyParameters((int)state.range(0), 1e15);
+		params.Enable_steady_transport_test = false;
+		params.Enable_exciton_diffusion_test = true;
+		OSC_Sim sim;
+		if (!sim.init(params, 0)) {
+			state.SkipWithError(("Simulation initialization failed: " + sim.getErrorMessage()).c_str());
+			return;
+		}
+		for (int i = 0; i < state.range(1); i++) {
+			sim.createExciton(OSC_SimBenchmark::calculateRandomExcitonCreationCoords(sim), true);
+		}
+		auto exciton_ptrs = OSC_SimBenchmark::getExcitonPtrs(sim);
+		int n = 0;
+		for (auto _ : state) {
+			OSC_SimBenchmark::calculateExcitonEvents(sim, exciton_ptrs[n % exciton_ptrs.size()]);
+			n++;
+		}
+		state.SetItemsProcessed(state.iterations());
+	}
+	BENCHMARK(BM_calculateExcitonEvents)->ArgNames({ "length", "excitons" })->ArgsProduct({ Lattice_sizes, { 10, 100, 1000 } });
+
+	void BM_createImportedMorphology(benchmark::State& state, const string& filename) {
+		auto params = createSteadyParameters(50, 1e15);
+		params.Enable_steady_transport_test = false;
+		params.Enable_exciton_diffusion_test = true;
+		params.Enable_neat = false;
+		params.Enable_import_morphology = true;
+		params.Morphology_filename = filename;
+		OSC_Sim sim;
+		if (!sim.init(params, 0)) {
+			state.SkipWithError(("Simulation initialization failed: " + sim.getErrorMessage()).c_str());
+			return;
+		}
+		for (auto _ : state) {
+			if (!OSC_SimBenchmark::createImportedMorphology(sim)) {
+				state.SkipWithError("Morphology import failed.");
+				break;
+			}
+		}
+		state.SetItemsProcessed(state.iterations());
+	}
+	BENCHMARK_CAPTURE(BM_createImportedMorphology, v3-2_compressed, string("./test/morphology_v3-2_compressed.txt"))->Unit(benchmark::kMillisecond);
+	BENCHMARK_CAPTURE(BM_createImportedMorphology, v3-2_uncompressed, string("./test/morphology_v3-2_uncompressed.txt"))->Unit(benchmark::kMillisecond);
+	BENCHMARK_CAPTURE(BM_createImportedMorphology, v4-0_compressed, string("./test/morphology_v4-0_compressed.txt"))->Unit(benchmark::kMillisecond);
+	BENCHMARK_CAPTURE(BM_createImportedMorphology, v4-0_uncompressed, string("./test/morphology_v4-0_uncompressed.txt"))->Unit(benchmark::kMillisecond);
+
+	// Sets up a neat lattice with a Gaussian DOS and correlated disorder
+	bool initCorrelatedSim(benchmark::State& state, OSC_Sim& sim) {
+		auto params = createSteadyParameters((int)state.range(0), 1e15);
+		params.Enable_steady_transport_test = false;
+		params.Enable_exciton_diffusion_test = true;
+		params.Enable_correlated_disorder = true;
+		params.Enable_gaussian_kernel = true;
+		params.Enable_power_kernel = false;
+		params.Disorder_correlation_length = 1.0;
+		if (!sim.init(params, 0)) {
+			state.SkipWithError(("Simulation initialization failed: " + sim.getErrorMessage()).c_str());
+			return false;
+		}
+		return true;
+	}
+
+	void BM_createCorrelatedDOS(benchmark::State& state) {
+		OSC_Sim sim;
+		if (!initCorrelatedSim(state, sim)) {
+			return;
+		}
+		for (auto _ : state) {
+			// Each correlated DOS is created from a new uncorrelated DOS
+			state.PauseTiming();
+			sim.reassignSiteEnergies();
+			state.ResumeTiming();
+			OSC_SimBenchmark::createCorrelatedDOS(sim, 1.0);
+		}
+		state.SetItemsProcessed(state.iterations());
+	}
+	BENCHMARK(BM_createCorrelatedDOS)->ArgName("length")->Arg(20)->Arg(30)->Arg(50)->Unit(benchmark::kMillisecond);
+
+	void BM_calculateDOSCorrelation(benchmark::State& state) {
+		OSC_Sim sim;
+		if (!initCorrelatedSim(state, sim)) {
+			return;
+		}
+		for (auto _ : state) {
+			OSC_SimBenchmark::calculateDOSCorrelation(sim, (double)state.range(1));
+		}
+		state.SetItemsProcessed(state.iterations());
+	}
+	BENCHMARK(BM_calculateDOSCorrelation)->ArgNames({ "length", "cutoff_radius" })->ArgsProduct({ { 20, 30, 50 }, { 2, 4 } })->Unit(benchmark::kMillisecond);
+
+}
+
+int main(int argc, char **argv) {
+	// The results are written in JSON format to bench_results.json unless another output file is specified
+	vector<char*> args(argv, argv + argc);
+	string out_arg = "--benchmark_out=bench_results.json";
+	string format_arg = "--benchmark_out_format=json";
+	bool has_out = false;
+	for (int i = 1; i < argc; i++) {
+		if (string(argv[i]).find("--benchmark_out=") == 0) {
+			has_out = true;
+		}
+	}
+	if (!has_out) {
+		args.push_back(&out_arg[0]);
+		args.push_back(&format_arg[0]);
+	}
+	int args_count = (int)args.size();
+	benchmark::Initialize(&args_count, args.data());
+	if (benchmark::ReportUnrecognizedArguments(args_count, args.data())) {
+		return 1;
+	}
+	benchmark::RunSpecifiedBenchmarks();
+	benchmark::Shutdown();
+	return 0;
+}
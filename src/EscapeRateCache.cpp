@@ -0,0 +1,125 @@
+// Copyright (c) 2017-2019 Michael C. Heiber
+// This source file is part of the Excimontec project, which is subject to the MIT License.
+// For more information, see the LICENSE file that accompanies this software.
+// The Excimontec project can be found on Github at https://github.com/MikeHeiber/Excimontec
+
+#include "EscapeRateCache.h"
+
+using namespace std;
+
+namespace Excimontec {
+
+	EscapeRateCache::EscapeRateCache(const int capacity) : Capacity(capacity > 0 ? capacity : 1) {
+
+	}
+
+	void EscapeRateCache::clear() {
+		entries.clear();
+		entry_its.clear();
+		N_evictions = 0;
+		N_hits = 0;
+		N_misses = 0;
+	}
+
+	const EscapeRateCache::Entry* EscapeRateCache::find(const long int key) {
+		auto map_it = entry_its.find(key);
+		if (map_it == entry_its.end()) {
+			N_misses++;
+			return nullptr;
+		}
+		N_hits++;
+		entries.splice(entries.begin(), entries, map_it->second);
+		return &(map_it->second->second);
+	}
+
+	int EscapeRateCache::getCapacity() const {
+		return Capacity;
+	}
+
+	long int EscapeRateCache::getN_evictions() const {
+		return N_evictions;
+	}
+
+	long int EscapeRateCache::getN_hits() const {
+		return N_hits;
+	}
+
+	long int EscapeRateCache::getN_misses() const {
+		return N_misses;
+	}
+
+	const EscapeRateCache::Entry& EscapeRateCache::insert(const long int key, const vector<int>& targets, const vector<double>& rates) {
+		auto map_it = entry_its.find(key);
+		if (map_it != entry_its.end()) {
+			entries.erase(map_it->second);
+			entry_its.erase(map_it);
+		}
+		while ((int)entries.size() >= Capacity) {
+			entry_its.erase(entries.back().first);
+			entries.pop_back();
+			N_evictions++;
+		}
+		entries.emplace_front(key, Entry());
+		entry_its[key] = entries.begin();
+		Entry& entry = entries.front().second;
+		const int N_targets = (int)targets.size();
+		entry.targets = targets;
+		entry.probabilities.assign(N_targets, 1.0);
+		entry.aliases.resize(N_targets);
+		for (int n = 0; n < N_targets; n++) {
+			entry.rate_total += rates[n];
+			entry.aliases[n] = n;
+		}
+		if (!(entry.rate_total > 0)) {
+			return entry;
+		}
+		// Vose's method: the columns are scaled so that the mean probability is one, and each column with a probability less than one
+		// is filled up by an alias column with a probability greater than one
+		vector<double> scaled(N_targets);
+		vector<int> small;
+		vector<int> large;
+		for (int n = 0; n < N_targets; n++) {
+			scaled[n] = rates[n] * N_targets / entry.rate_total;
+			if (scaled[n] < 1.0) {
+				small.push_back(n);
+			}
+			else {
+				large.push_back(n);
+			}
+		}
+		while (!small.empty() && !large.empty()) {
+			int column_small = small.back();
+			small.pop_back();
+			int column_large = large.back();
+			entry.probabilities[column_small] = scaled[column_small];
+			entry.aliases[column_small] = column_large;
+			scaled[column_large] -= (1.0 - scaled[column_small]);
+			if (scaled[column_large] < 1.0) {
+				large.pop_back();
+				small.push_back(column_large);
+			}
+		}
+		// The remaining columns only differ from a probability of one by round-off error
+		for (auto column : small) {
+			entry.probabilities[column] = 1.0;
+		}
+		for (auto column : large) {
+			entry.probabilities[column] = 1.0;
+		}
+		return entry;
+	}
+
+	void EscapeRateCache::setCapacity(const int capacity) {
+		Capacity = (capacity > 0) ? capacity : 1;
+		while ((int)entries.size() > Capacity) {
+			entry_its.erase(entries.back().first);
+			entries.pop_back();
+			N_evictions++;
+		}
+	}
+
+	int EscapeRateCache::size() const {
+		return (int)entries.size();
+	}
+
+}
@@ -0,0 +1,107 @@
+// Copyright (c) 2017-2019 Michael C. Heiber
+// This source file is part of the Excimontec project, which is subject to the MIT License.
+// For more information, see the LICENSE file that accompanies this software.
+// The Excimontec project can be found on Github at https://github.com/MikeHeiber/Excimontec
+
+#ifndef EXCIMONTEC_ESCAPE_RATE_CACHE_H
+#define EXCIMONTEC_ESCAPE_RATE_CACHE_H
+
+#include <list>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace Excimontec {
+
+	//! \brief This class stores the total escape rate and a Walker alias table of the hop targets of each cached site, so that the destination of a
+	//! hop can be sampled from the static hop rates of a site in O(1) time.
+	//! \details Each entry is identified by an integer key that is chosen by the caller, and the alias table of an entry is built with Vose's method
+	//! when the entry is inserted.  The number of entries is limited by the capacity, and when the cache is full, the least recently used entry is
+	//! removed to make room for a new entry.
+	//! \copyright MIT License.  For more information, see the LICENSE file that accompanies this software package.
+	//! \author Michael C. Heiber
+	//! \date 2017-2019
+	class EscapeRateCache {
+	public:
+
+		//! \brief This struct holds the escape rate and the alias table of one site.
+		struct Entry {
+			//! The sum of the rates of all hop targets.
+			double rate_total = 0.0;
+			//! The hop targets.
+			std::vector<int> targets;
+			//! The probability of choosing the target of each column of the alias table instead of its alias.
+			std::vector<double> probabilities;
+			//! The column index of the alias of each column of the alias table.
+			std::vector<int> aliases;
+		};
+
+		//! \brief Constructs an empty cache.
+		//! \param capacity is the maximum number of entries.
+		EscapeRateCache(const int capacity = 1);
+
+		//! \brief Removes all entries from the cache and resets the counters.
+		void clear();
+
+		//! \brief Gets the entry for a key and marks it as the most recently used entry.
+		//! \param key is the key of the entry.
+		//! \return A pointer to the entry, or nullptr if the cache does not contain the key.
+		const Entry* find(const long int key);
+
+		//! \brief Gets the maximum number of entries.
+		int getCapacity() const;
+
+		//! \brief Gets the number of entries that have been removed to make room for new entries.
+		long int getN_evictions() const;
+
+		//! \brief Gets the number of calls to find that found an entry.
+		long int getN_hits() const;
+
+		//! \brief Gets the number of calls to find that did not find an entry.
+		long int getN_misses() const;
+
+		//! \brief Builds the alias table of a new entry and adds it to the cache as the most recently used entry.
+		//! \details If the cache already contains the key, the existing entry is replaced.
+		//! \param key is the key of the entry.
+		//! \param targets is the vector of hop targets.
+		//! \param rates is the vector of the rates of the hop targets, which must not be negative.
+		//! \return A reference to the new entry.
+		const Entry& insert(const long int key, const std::vector<int>& targets, const std::vector<double>& rates);
+
+		//! \brief Chooses a hop target of an entry with a probability proportional to its rate.
+		//! \param entry is the cache entry.
+		//! \param random_num1 is a uniform random number in the range [0,1) that chooses the column of the alias table.
+		//! \param random_num2 is a uniform random number in the range [0,1) that chooses between the target and the alias of the column.
+		//! \return The chosen hop target, or -1 if the entry has no targets.
+		static int sample(const Entry& entry, const double random_num1, const double random_num2) {
+			const int N_targets = (int)entry.targets.size();
+			if (N_targets == 0) {
+				return -1;
+			}
+			int column = (int)(random_num1*N_targets);
+			if (column >= N_targets) {
+				column = N_targets - 1;
+			}
+			return (random_num2 < entry.probabilities[column]) ? entry.targets[column] : entry.targets[entry.aliases[column]];
+		}
+
+		//! \brief Changes the maximum number of entries and removes the least recently used entries that no longer fit.
+		//! \param capacity is the maximum number of entries, which must be greater than zero.
+		void setCapacity(const int capacity);
+
+		//! \brief Gets the number of entries in the cache.
+		int size() const;
+
+	private:
+		int Capacity;
+		long int N_evictions = 0;
+		long int N_hits = 0;
+		long int N_misses = 0;
+		// Entries ordered from the most recently used to the least recently used
+		std::list<std::pair<long int, Entry>> entries;
+		std::unordered_map<long int, std::list<std::pair<long int, Entry>>::iterator> entry_its;
+	};
+
+}
+
+#endif // EXCIMONTEC_ESCAPE_RATE_CACHE_H
@@ -0,0 +1,110 @@
+// Copyright (c) 2017-2019 Michael C. Heiber
+// This source file is part of the Excimontec project, which is subject to the MIT License.
+// For more information, see the LICENSE file that accompanies this software.
+// The Excimontec project can be found on Github at https://github.com/MikeHeiber/Excimontec
+
+#include "EventHeap.h"
+
+using namespace std;
+
+namespace Excimontec {
+
+	EventHeap::EventHeap() {
+
+	}
+
+	int EventHeap::addSlot() {
+		int slot;
+		if (!free_slots.empty()) {
+			slot = free_slots.back();
+			free_slots.pop_back();
+		}
+		else {
+			slot = (int)positions.size();
+			positions.push_back(-1);
+		}
+		// A slot with an infinite time can be placed at the end of the heap without moving any other nodes
+		Node node;
+		node.time = numeric_limits<double>::infinity();
+		node.slot = slot;
+		positions[slot] = (int)nodes.size();
+		nodes.push_back(node);
+		return slot;
+	}
+
+	void EventHeap::clear() {
+		nodes.clear();
+		positions.clear();
+		free_slots.clear();
+	}
+
+	int EventHeap::getN_slots() const {
+		return (int)nodes.size();
+	}
+
+	double EventHeap::getTime(const int slot) const {
+		return nodes[positions[slot]].time;
+	}
+
+	void EventHeap::removeSlot(const int slot) {
+		int position = positions[slot];
+		double time = nodes[position].time;
+		// Move the last node into the position of the removed slot and then restore the heap order around it
+		nodes[position] = nodes.back();
+		positions[nodes[position].slot] = position;
+		nodes.pop_back();
+		positions[slot] = -1;
+		free_slots.push_back(slot);
+		if (position < (int)nodes.size()) {
+			if (nodes[position].time < time) {
+				siftUp(position);
+			}
+			else {
+				siftDown(position);
+			}
+		}
+	}
+
+	void EventHeap::siftDown(int position) {
+		Node node = nodes[position];
+		const int N_nodes = (int)nodes.size();
+		while (true) {
+			int child_first = Arity * position + 1;
+			if (child_first >= N_nodes) {
+				break;
+			}
+			// Find the earliest child
+			int child_min = child_first;
+			int child_end = min(child_first + Arity, N_nodes);
+			for (int i = child_first + 1; i < child_end; i++) {
+				if (nodes[i].time < nodes[child_min].time) {
+					child_min = i;
+				}
+			}
+			if (!(nodes[child_min].time < node.time)) {
+				break;
+			}
+			nodes[position] = nodes[child_min];
+			positions[nodes[position].slot] = position;
+			position = child_min;
+		}
+		nodes[position] = node;
+		positions[node.slot] = position;
+	}
+
+	void EventHeap::siftUp(int position) {
+		Node node = nodes[position];
+		while (position > 0) {
+			int parent = (position - 1) / Arity;
+			if (!(node.time < nodes[parent].time)) {
+				break;
+			}
+			nodes[position] = nodes[parent];
+			positions[nodes[position].slot] = position;
+			position = parent;
+		}
+		nodes[position] = node;
+		positions[node.slot] = position;
+	}
+
+}
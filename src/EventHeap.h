@@ -0,0 +1,88 @@
+// Copyright (c) 2017-2019 Michael C. Heiber
+// This source file is part of the Excimontec project, which is subject to the MIT License.
+// For more information, see the LICENSE file that accompanies this software.
+// The Excimontec project can be found on Github at https://github.com/MikeHeiber/Excimontec
+
+#ifndef EXCIMONTEC_EVENT_HEAP_H
+#define EXCIMONTEC_EVENT_HEAP_H
+
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+namespace Excimontec {
+
+	//! \brief This class stores a set of event execution times in an indexed 4-ary min-heap, so that the earliest time can be found in O(1) time
+	//! and the time of any slot can be changed in O(log N) time.
+	//! \details Each execution time is stored in a slot, and the heap keeps the position of every slot so that a slot can be updated or removed
+	//! without searching the heap.  Slots that are removed are reused by later calls to addSlot.  New slots have an infinite execution time,
+	//! which is also used for slots that have no pending event.
+	//! \copyright MIT License.  For more information, see the LICENSE file that accompanies this software package.
+	//! \author Michael C. Heiber
+	//! \date 2017-2019
+	class EventHeap {
+	public:
+
+		//! The number of children of each node of the heap.
+		static const int Arity = 4;
+
+		//! \brief Constructs an empty event heap with no slots.
+		EventHeap();
+
+		//! \brief Adds a new slot with an infinite execution time.
+		//! \return The index of the new slot.
+		int addSlot();
+
+		//! \brief Removes all slots from the heap.
+		void clear();
+
+		//! \brief Gets the number of slots that are in use.
+		int getN_slots() const;
+
+		//! \brief Gets the execution time of a slot.
+		//! \param slot is the index of the slot.
+		double getTime(const int slot) const;
+
+		//! \brief Gets the slot with the earliest execution time.
+		//! \return The index of the slot, or -1 if the heap has no slots.
+		int getTop() const {
+			return nodes.empty() ? -1 : nodes[0].slot;
+		}
+
+		//! \brief Removes a slot so that it can be reused by a later call to addSlot.
+		//! \param slot is the index of the slot.
+		void removeSlot(const int slot);
+
+		//! \brief Changes the execution time of a slot and moves it to its new position in the heap.
+		//! \param slot is the index of the slot.
+		//! \param time is the new execution time.
+		void setTime(const int slot, const double time) {
+			int position = positions[slot];
+			double time_prev = nodes[position].time;
+			nodes[position].time = time;
+			if (time < time_prev) {
+				siftUp(position);
+			}
+			else {
+				siftDown(position);
+			}
+		}
+
+	private:
+		// The execution time is stored with the slot index in each node so that the comparisons do not need to look up the slots
+		struct Node {
+			double time;
+			int slot;
+		};
+		std::vector<Node> nodes;
+		// Position of each slot in the heap, or -1 if the slot has been removed
+		std::vector<int> positions;
+		std::vector<int> free_slots;
+
+		void siftDown(int position);
+		void siftUp(int position);
+	};
+
+}
+
+#endif // EXCIMONTEC_EVENT_HEAP_H
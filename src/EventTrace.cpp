@@ -0,0 +1,182 @@
+// Copyright (c) 2017-2019 Michael C. Heiber
+// This source file is part of the Excimontec project, which is subject to the MIT License.
+// For more information, see the LICENSE file that accompanies this software.
+// The Excimontec project can be found on Github at https://github.com/MikeHeiber/Excimontec
+
+#include "EventTrace.h"
+
+using namespace std;
+
+namespace Excimontec {
+
+	const string EventTrace::Trace_identifier = "EXCMTCTR";
+	const int32_t EventTrace::Trace_version = 1;
+
+	EventTrace::EventTrace() : head_count(0), tail_count(0), stop_writer(false) {
+
+	}
+
+	EventTrace::~EventTrace() {
+		close();
+	}
+
+	void EventTrace::close() {
+		if (!writer_thread.joinable()) {
+			return;
+		}
+		stop_writer.store(true);
+		writer_cv.notify_one();
+		writer_thread.join();
+		Tracefile.close();
+	}
+
+	bool EventTrace::decode(const string& input_filename, const string& output_filename) {
+		ifstream infile(input_filename, ifstream::in | ifstream::binary);
+		if (!infile.good()) {
+			cout << "Error! Trace file " << input_filename << " could not be opened." << endl;
+			return false;
+		}
+		string identifier(Trace_identifier.size(), '\0');
+		int32_t version, byte_order, record_size;
+		int32_t dims[3];
+		infile.read(&identifier[0], identifier.size());
+		infile.read(reinterpret_cast<char*>(&version), sizeof(version));
+		infile.read(reinterpret_cast<char*>(&byte_order), sizeof(byte_order));
+		infile.read(reinterpret_cast<char*>(&record_size), sizeof(record_size));
+		infile.read(reinterpret_cast<char*>(dims), sizeof(dims));
+		if (!infile || identifier != Trace_identifier || version != Trace_version || byte_order != 0x01020304 || record_size != (int32_t)sizeof(Record)
+			|| dims[0] <= 0 || dims[1] <= 0 || dims[2] <= 0) {
+			cout << "Error! " << input_filename << " is not a valid trace file for this version of Excimontec." << endl;
+			return false;
+		}
+		ofstream outfile(output_filename);
+		if (!outfile.good()) {
+			cout << "Error! Output file " << output_filename << " could not be created." << endl;
+			return false;
+		}
+		// Converts a site index into the x,y,z text form of the simulation log
+		auto site_text = [&dims](const int32_t index) {
+			int x = index / (dims[1] * dims[2]);
+			int y = (index / dims[2]) % dims[1];
+			int z = index % dims[2];
+			return to_string(x) + "," + to_string(y) + "," + to_string(z);
+		};
+		Record record;
+		while (infile.read(reinterpret_cast<char*>(&record), sizeof(record))) {
+			if (record.kind >= N_kinds) {
+				cout << "Error! " << input_filename << " contains an invalid event record." << endl;
+				return false;
+			}
+			outfile << "Event " << record.event_number << ": Executing " << getEventType(record.kind) << " event" << "\n";
+			string polaron_name = record.flag ? "Hole " : "Electron ";
+			switch (record.kind) {
+			case Exciton_creation:
+				outfile << "Created exciton " << record.tag << " at site " << site_text(record.site_dest) << "." << "\n";
+				break;
+			case Exciton_hop:
+				outfile << "Exciton " << record.tag << " hopping to site " << site_text(record.site_dest) << "." << "\n";
+				break;
+			case Exciton_recombination:
+				outfile << "Exciton " << record.tag << " recombined at site " << site_text(record.site_initial) << "." << "\n";
+				break;
+			case Exciton_dissociation:
+				outfile << "Exciton " << record.tag << " dissociated at site " << site_text(record.site_initial) << " with site " << site_text(record.site_dest) << "." << "\n";
+				break;
+			case Exciton_exciton_annihilation:
+				outfile << "Exciton " << record.tag << " annihilated at site " << site_text(record.site_initial);
+				outfile << " with exciton " << record.target_tag << " at " << site_text(record.site_dest) << "." << "\n";
+				break;
+			case Exciton_polaron_annihilation:
+				outfile << "Exciton " << record.tag << " annihilated at site " << site_text(record.site_initial);
+				outfile << " with polaron " << record.target_tag << " at " << site_text(record.site_dest) << "." << "\n";
+				break;
+			case Exciton_intersystem_crossing:
+				if (record.flag) {
+					outfile << "Singlet exciton " << record.tag << " at site " << site_text(record.site_initial) << " has become a triplet exciton." << "\n";
+				}
+				else {
+					outfile << "Triplet exciton " << record.tag << " at site " << site_text(record.site_initial) << " has become a singlet exciton." << "\n";
+				}
+				break;
+			case Polaron_hop:
+				outfile << polaron_name << record.tag << " hopping to site " << site_text(record.site_dest) << "." << "\n";
+				break;
+			case Polaron_recombination:
+				outfile << "Electron " << record.tag << " at site " << site_text(record.site_initial) << " recombined with hole " << record.target_tag << " at site " << site_text(record.site_dest) << "." << "\n";
+				break;
+			case Polaron_extraction:
+				outfile << polaron_name << record.tag << " was extracted from site " << site_text(record.site_initial) << "." << "\n";
+				break;
+			default:
+				break;
+			}
+		}
+		if (infile.gcount() != 0) {
+			cout << "Error! " << input_filename << " ends with an incomplete event record." << endl;
+			return false;
+		}
+		return true;
+	}
+
+	string EventTrace::getEventType(const uint8_t kind) {
+		static const string event_types[N_kinds] = { "Exciton Creation", "Exciton Hop", "Exciton Recombination", "Exciton Dissociation",
+			"Exciton-Exciton Annihilation", "Exciton-Polaron Annihilation", "Exciton Intersystem Crossing", "Polaron Hop", "Polaron Recombination",
+			"Polaron Extraction" };
+		if (kind >= N_kinds) {
+			return "";
+		}
+		return event_types[kind];
+	}
+
+	bool EventTrace::isOpen() const {
+		return writer_thread.joinable();
+	}
+
+	bool EventTrace::open(const string& filename, const int length, const int width, const int height, const int capacity) {
+		if (isOpen() || capacity <= 0) {
+			return false;
+		}
+		Tracefile.open(filename, ofstream::out | ofstream::binary | ofstream::trunc);
+		if (!Tracefile.good()) {
+			Tracefile.close();
+			return false;
+		}
+		const int32_t byte_order = 0x01020304;
+		const int32_t record_size = (int32_t)sizeof(Record);
+		const int32_t dims[3] = { length, width, height };
+		Tracefile.write(Trace_identifier.data(), Trace_identifier.size());
+		Tracefile.write(reinterpret_cast<const char*>(&Trace_version), sizeof(Trace_version));
+		Tracefile.write(reinterpret_cast<const char*>(&byte_order), sizeof(byte_order));
+		Tracefile.write(reinterpret_cast<const char*>(&record_size), sizeof(record_size));
+		Tracefile.write(reinterpret_cast<const char*>(dims), sizeof(dims));
+		buffer.assign(capacity, Record());
+		head_count.store(0);
+		tail_count.store(0);
+		stop_writer.store(false);
+		writer_thread = thread(&EventTrace::writeRecords, this);
+		return true;
+	}
+
+	void EventTrace::writeRecords() {
+		while (true) {
+			size_t tail = tail_count.load(memory_order_relaxed);
+			size_t head = head_count.load(memory_order_acquire);
+			if (head == tail) {
+				// The stop flag is set after the last record is added, so the buffer is checked again before finishing
+				if (stop_writer.load() && head_count.load(memory_order_acquire) == tail) {
+					break;
+				}
+				unique_lock<mutex> lock(writer_mutex);
+				writer_cv.wait_for(lock, chrono::milliseconds(10));
+				continue;
+			}
+			// Write the records up to the end of the buffer in one block, and the wrapped records on the next pass
+			size_t start = tail % buffer.size();
+			size_t n_records = min(head - tail, buffer.size() - start);
+			Tracefile.write(reinterpret_cast<const char*>(&buffer[start]), n_records * sizeof(Record));
+			tail_count.store(tail + n_records, memory_order_release);
+		}
+		Tracefile.flush();
+	}
+
+}
@@ -0,0 +1,147 @@
+// Copyright (c) 2017-2019 Michael C. Heiber
+// This source file is part of the Excimontec project, which is subject to the MIT License.
+// For more information, see the LICENSE file that accompanies this software.
+// The Excimontec project can be found on Github at https://github.com/MikeHeiber/Excimontec
+
+#ifndef EXCIMONTEC_EVENT_TRACE_H
+#define EXCIMONTEC_EVENT_TRACE_H
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace Excimontec {
+
+	//! \brief This class records a compact binary trace of the events executed by a simulation.
+	//! \details Each executed event is stored as a fixed size record in an in-memory ring buffer, and a background writer thread drains the
+	//! buffer to the trace file, so the simulation thread never formats text or waits on the file system unless the buffer is full.
+	//! No records are dropped; when the buffer is full, the simulation thread waits until the writer has made room.
+	//! Lattice sites are stored as site indices, index = x*Width*Height + y*Height + z, and the lattice dimensions are stored in the file header
+	//! so that the decode function can convert a trace file back into the text form of the simulation log.
+	//! \copyright MIT License.  For more information, see the LICENSE file that accompanies this software package.
+	//! \author Michael C. Heiber
+	//! \date 2017-2019
+	class EventTrace {
+	public:
+
+		//! Identifies the type of event in a trace record.
+		enum Kind : uint8_t {
+			Exciton_creation = 0,
+			Exciton_hop,
+			Exciton_recombination,
+			Exciton_dissociation,
+			Exciton_exciton_annihilation,
+			Exciton_polaron_annihilation,
+			Exciton_intersystem_crossing,
+			Polaron_hop,
+			Polaron_recombination,
+			Polaron_extraction,
+			N_kinds
+		};
+
+		//! \brief This struct holds the data for one executed event.
+		//! \details The flag is the spin state of the exciton for exciton events (true for singlet) and the charge of the polaron for polaron
+		//! events (true for hole) before the event is executed.
+		struct Record {
+			//! The execution time of the event.
+			double time;
+			//! The rate constant of the event.
+			double rate;
+			//! The number of events that were executed before the event.
+			int64_t event_number;
+			//! The tag of the object that executes the event.
+			int32_t tag;
+			//! The tag of the target object, or -1 when the event has no target.
+			int32_t target_tag;
+			//! The site index of the object before the event.
+			int32_t site_initial;
+			//! The site index of the event destination.
+			int32_t site_dest;
+			//! The type of the event.
+			uint8_t kind;
+			//! The spin state or charge of the object.
+			uint8_t flag;
+		};
+
+		//! \brief Constructs an event trace that is not yet connected to a file.
+		EventTrace();
+
+		//! \brief Flushes all buffered records and closes the trace file.
+		~EventTrace();
+
+		EventTrace(const EventTrace&) = delete;
+		EventTrace& operator=(const EventTrace&) = delete;
+
+		//! \brief Flushes all buffered records to the trace file, stops the writer thread, and closes the trace file.
+		void close();
+
+		//! \brief Converts a binary trace file into the text form of the simulation log.
+		//! \param input_filename is the name of the binary trace file.
+		//! \param output_filename is the name of the text file to be written.
+		//! \return true if the trace file was converted successfully.
+		//! \return false if the trace file could not be opened or is not a valid trace file.
+		static bool decode(const std::string& input_filename, const std::string& output_filename);
+
+		//! \brief Gets the event type name that corresponds to a record kind.
+		//! \param kind is the record kind.
+		//! \return The event type name used by the event classes, or an empty string if the kind is not valid.
+		static std::string getEventType(const uint8_t kind);
+
+		//! \brief Checks whether the trace is connected to an open trace file.
+		bool isOpen() const;
+
+		//! \brief Creates the trace file, writes the file header, and starts the writer thread.
+		//! \param filename is the name of the trace file.
+		//! \param length is the length of the lattice.
+		//! \param width is the width of the lattice.
+		//! \param height is the height of the lattice.
+		//! \param capacity is the number of records that the ring buffer can hold.
+		//! \return true if the trace file was created successfully.
+		//! \return false if the trace is already open, the trace file could not be created, or the capacity is not positive.
+		bool open(const std::string& filename, const int length, const int width, const int height, const int capacity = 65536);
+
+		//! \brief Adds a record to the ring buffer.
+		//! \details This function must only be called by one thread at a time.
+		//! \param record is the event record to be added.
+		void record(const Record& record) {
+			size_t head = head_count.load(std::memory_order_relaxed);
+			// Wait for the writer when the buffer is full
+			while (head - tail_count.load(std::memory_order_acquire) >= buffer.size()) {
+				writer_cv.notify_one();
+				std::this_thread::yield();
+			}
+			buffer[head % buffer.size()] = record;
+			head_count.store(head + 1, std::memory_order_release);
+			// Wake the writer once half of the buffer is waiting to be written
+			if (head + 1 - tail_count.load(std::memory_order_relaxed) == buffer.size() / 2) {
+				writer_cv.notify_one();
+			}
+		}
+
+	private:
+		static const std::string Trace_identifier;
+		static const int32_t Trace_version;
+		std::ofstream Tracefile;
+		std::vector<Record> buffer;
+		// Total number of records added by the simulation thread and written by the writer thread
+		std::atomic<size_t> head_count;
+		std::atomic<size_t> tail_count;
+		std::atomic<bool> stop_writer;
+		std::mutex writer_mutex;
+		std::condition_variable writer_cv;
+		std::thread writer_thread;
+
+		void writeRecords();
+	};
+
+}
+
+#endif // EXCIMONTEC_EVENT_TRACE_H
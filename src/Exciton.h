@@ -83,6 +83,12 @@ namespace Excimontec {
 				}
 			}
 
+			//! \brief Sets the rate constant of the hop event directly.
+			//! \details This function is used to copy the rate constant of the chosen candidate event to the event in the main event list, which is the
+			//! total escape rate of the starting site for the hop events of the escape rate cache.
+			//! \param rate is the rate constant of the event.
+			void setRateConstant(const double rate) { rate_constant = rate; }
+
 			//! \brief Gets the event type string that denotes what type of derived event class this is.
 			//! \returns The string "Exciton_Hop".
 			std::string getEventType() const { return event_type; }
@@ -151,6 +157,11 @@ namespace Excimontec {
 				rate_constant = (prefactor / sqrt(4.0*KMC_Lattice::Pi*reorganization*KMC_Lattice::K_b*sim_ptr->getTemp()))*exp(-2.0*localization*distance)*exp(-KMC_Lattice::intpow(reorganization + E_delta, 2) / (4.0*reorganization*KMC_Lattice::K_b*sim_ptr->getTemp()));
 			}
 
+			//! \brief Sets the rate constant of the dissociation event directly.
+			//! \details This function is used to copy the rate constant of the chosen candidate event to the event in the main event list.
+			//! \param rate is the rate constant of the event.
+			void setRateConstant(const double rate) { rate_constant = rate; }
+
 			//! \brief Gets the event type string that denotes what type of derived event class this is.
 			//! \returns The string "Exciton_Dissociation".
 			std::string getEventType() const { return event_type; }
@@ -222,6 +233,11 @@ namespace Excimontec {
 				rate_constant = prefactor * exp(-2.0*localization*distance);
 			}
 
+			//! \brief Sets the rate constant of the exciton-exciton annihilation event directly.
+			//! \details This function is used to copy the rate constant of the chosen candidate event to the event in the main event list.
+			//! \param rate is the rate constant of the event.
+			void setRateConstant(const double rate) { rate_constant = rate; }
+
 			//! \brief Gets the event type string that denotes what type of derived event class this is.
 			//! \returns The string "Exciton_Exciton_Annihilation".
 			std::string getEventType() const { return event_type; }
@@ -260,6 +276,11 @@ namespace Excimontec {
 				rate_constant = prefactor * exp(-2.0*localization*distance);
 			}
 
+			//! \brief Sets the rate constant of the exciton-polaron annihilation event directly.
+			//! \details This function is used to copy the rate constant of the chosen candidate event to the event in the main event list.
+			//! \param rate is the rate constant of the event.
+			void setRateConstant(const double rate) { rate_constant = rate; }
+
 			//! \brief Gets the event type string that denotes what type of derived event class this is.
 			//! \returns The string "Exciton_Polaron_Annihilation".
 			std::string getEventType() const { return event_type; }
@@ -277,6 +298,7 @@ namespace Excimontec {
 		//! \param exciton_spin is the spin state of the exciton. (true for singlet and false for triplet)
 		Exciton(const double time, const int tag_num, const KMC_Lattice::Coords& coords_start, const bool exciton_spin) : KMC_Lattice::Object(time, tag_num, coords_start) {
 			spin_state = exciton_spin;
+			transient_energy_prev = 0;
 		}
 
 		//! \brief Flips the spin state of the exciton from singlet to triplet or from triplet to singlet.
@@ -291,12 +313,21 @@ namespace Excimontec {
 		//! \returns false if the exciton is in a triplet state.
 		bool getSpin() const { return spin_state; }
 
+		//! \brief Gets the site energy of the exciton that was recorded at the previous transient time interval.
+		//! \returns The recorded site energy in units of eV, which is 0 if no energy has been recorded.
+		double getTransientEnergyPrev() const { return transient_energy_prev; }
+
 		//! \brief Sets the spin state of the exciton.
 		//! \param spin_state_new indicates what the spin state will be set to.  True for singlet and false for triplet.
 		void setSpin(bool spin_state_new) { spin_state = spin_state_new; }
 
+		//! \brief Records the site energy of the exciton for use at the next transient time interval.
+		//! \param energy is the site energy in units of eV.
+		void setTransientEnergyPrev(const double energy) { transient_energy_prev = energy; }
+
 	private:
 		bool spin_state; // false represents triplet state, true represents singlet state
+		double transient_energy_prev; // site energy at the previous transient time interval
 
 	};
 
@@ -0,0 +1,102 @@
+// Copyright (c) 2017-2019 Michael C. Heiber
+// This source file is part of the Excimontec project, which is subject to the MIT License.
+// For more information, see the LICENSE file that accompanies this software.
+// The Excimontec project can be found on Github at https://github.com/MikeHeiber/Excimontec
+
+#include "Histogram.h"
+
+using namespace std;
+
+namespace Excimontec {
+
+	Histogram::Histogram() {
+
+	}
+
+	Histogram::Histogram(const double min_val, const double max_val, const double bin_size) {
+		Bin_size = bin_size;
+		Inv_bin_size = 1.0 / bin_size;
+		N_bins = max((int)floor((max_val - min_val) / bin_size + 0.5) + 1, 1);
+		Range_start = min_val - 0.5*bin_size;
+		counts.assign(N_bins + 2, 0.0);
+	}
+
+	void Histogram::clear() {
+		fill(counts.begin(), counts.end(), 0.0);
+	}
+
+	double Histogram::getBinSize() const {
+		return Bin_size;
+	}
+
+	vector<pair<double, double>> Histogram::getData() const {
+		vector<pair<double, double>> data;
+		data.reserve(N_bins);
+		for (int i = 0; i < N_bins; i++) {
+			data.push_back(make_pair(Range_start + (i + 0.5)*Bin_size, counts[i + 1]));
+		}
+		return data;
+	}
+
+	int Histogram::getNumBins() const {
+		return N_bins;
+	}
+
+	double Histogram::getOutOfRangeCount() const {
+		return counts.front() + counts.back();
+	}
+
+	double Histogram::getTotalCount() const {
+		return accumulate(counts.begin(), counts.end(), 0.0);
+	}
+
+	bool Histogram::merge(const Histogram& input) {
+		if (input.N_bins != N_bins || abs(input.Bin_size - Bin_size) > 1e-6*Bin_size || abs(input.Range_start - Range_start) > 1e-6*Bin_size) {
+			return false;
+		}
+		for (int i = 0; i < N_bins + 2; i++) {
+			counts[i] += input.counts[i];
+		}
+		return true;
+	}
+
+	bool Histogram::readBinary(istream& input) {
+		int32_t n_bins;
+		double bin_size;
+		double range_start;
+		if (!input.read(reinterpret_cast<char*>(&n_bins), sizeof(n_bins)) || !input.read(reinterpret_cast<char*>(&bin_size), sizeof(bin_size))
+			|| !input.read(reinterpret_cast<char*>(&range_start), sizeof(range_start)) || n_bins < 0 || !(bin_size > 0)) {
+			return false;
+		}
+		vector<double> counts_new(n_bins + 2, 0.0);
+		if (!input.read(reinterpret_cast<char*>(counts_new.data()), counts_new.size() * sizeof(double))) {
+			return false;
+		}
+		N_bins = n_bins;
+		Bin_size = bin_size;
+		Inv_bin_size = 1.0 / bin_size;
+		Range_start = range_start;
+		counts = counts_new;
+		return true;
+	}
+
+	void Histogram::writeBinary(ostream& output) const {
+		int32_t n_bins = N_bins;
+		output.write(reinterpret_cast<const char*>(&n_bins), sizeof(n_bins));
+		output.write(reinterpret_cast<const char*>(&Bin_size), sizeof(Bin_size));
+		output.write(reinterpret_cast<const char*>(&Range_start), sizeof(Range_start));
+		output.write(reinterpret_cast<const char*>(counts.data()), counts.size() * sizeof(double));
+	}
+
+	Histogram MPI_mergeHistograms(const Histogram& input, MPI_Comm comm) {
+		int procid;
+		MPI_Comm_rank(comm, &procid);
+		Histogram output = input;
+		MPI_Reduce(input.counts.data(), output.counts.data(), (int)input.counts.size(), MPI_DOUBLE, MPI_SUM, 0, comm);
+		if (procid != 0) {
+			return input;
+		}
+		return output;
+	}
+
+}
@@ -0,0 +1,108 @@
+// Copyright (c) 2017-2019 Michael C. Heiber
+// This source file is part of the Excimontec project, which is subject to the MIT License.
+// For more information, see the LICENSE file that accompanies this software.
+// The Excimontec project can be found on Github at https://github.com/MikeHeiber/Excimontec
+
+#ifndef EXCIMONTEC_HISTOGRAM_H
+#define EXCIMONTEC_HISTOGRAM_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <istream>
+#include <mpi.h>
+#include <numeric>
+#include <ostream>
+#include <utility>
+#include <vector>
+
+namespace Excimontec {
+
+	//! \brief This class represents a histogram with a fixed range of equally sized bins that is chosen when the histogram is constructed.
+	//! \details Values that fall outside of the range are counted in separate underflow and overflow bins, so adding a value never requires the
+	//! histogram to be resized.
+	//! \copyright MIT License.  For more information, see the LICENSE file that accompanies this software package.
+	//! \author Michael C. Heiber
+	//! \date 2017-2019
+	class Histogram {
+	public:
+
+		//! \brief Constructs an empty histogram with no bins.
+		Histogram();
+
+		//! \brief Constructs a histogram with zero counts in all bins.
+		//! \param min_val is the center of the first bin.
+		//! \param max_val is the center of the last bin, which is rounded to the nearest whole number of bins from min_val.
+		//! \param bin_size is the width of each bin.
+		Histogram(const double min_val, const double max_val, const double bin_size);
+
+		//! \brief Adds one count to the bin that contains the input value.
+		//! \details Values below or above the range of the histogram are counted in the underflow or overflow bin, respectively.
+		//! \param value is the value to be added to the histogram.
+		void add(const double value) {
+			// Clamp the bin position so that out of range values land in the underflow bin (0) or overflow bin (N_bins+1)
+			double position = std::max(0.0, (value - Range_start)*Inv_bin_size + 1.0);
+			position = std::min(position, (double)(N_bins + 1));
+			counts[(int)position] += 1.0;
+		}
+
+		//! \brief Resets the counts in all bins, including the underflow and overflow bins, to zero.
+		void clear();
+
+		//! \brief Gets the width of each bin.
+		//! \return The bin size.
+		double getBinSize() const;
+
+		//! \brief Gets the histogram data within the range of the histogram.
+		//! \return A vector of data pairs where the first value is the bin center and the second value is the bin count.
+		std::vector<std::pair<double, double>> getData() const;
+
+		//! \brief Gets the number of bins within the range of the histogram, not including the underflow and overflow bins.
+		//! \return The number of bins.
+		int getNumBins() const;
+
+		//! \brief Gets the total number of values that fell outside of the range of the histogram.
+		//! \return The sum of the underflow and overflow bin counts.
+		double getOutOfRangeCount() const;
+
+		//! \brief Gets the total number of values that have been added to the histogram.
+		//! \return The sum of the counts in all bins, including the underflow and overflow bins.
+		double getTotalCount() const;
+
+		//! \brief Adds the counts from another histogram to this histogram.
+		//! \details This can be used to combine histograms that were sampled in separate simulations or on separate processors.
+		//! \param input is the histogram to be merged, which must have the same range and bin size as this histogram.
+		//! \return true if the histograms were merged successfully.
+		//! \return false if the histograms do not have the same range and bin size.
+		bool merge(const Histogram& input);
+
+		//! \brief Reads the bin layout and bin counts from a binary stream that was written by writeBinary.
+		//! \param input is the input stream.
+		//! \return true if the data was read successfully.
+		//! \return false if the stream ended before all of the data could be read or the bin layout is not valid.
+		bool readBinary(std::istream& input);
+
+		//! \brief Writes the bin layout and bin counts, including the underflow and overflow bins, to a binary stream in the native byte order.
+		//! \param output is the output stream.
+		void writeBinary(std::ostream& output) const;
+
+	private:
+		friend Histogram MPI_mergeHistograms(const Histogram& input, MPI_Comm comm);
+		int N_bins = 0;
+		double Bin_size = 1.0;
+		double Inv_bin_size = 1.0;
+		double Range_start = 0.0;
+		// Bin counts, where the first element is the underflow bin and the last element is the overflow bin
+		std::vector<double> counts = std::vector<double>(2, 0.0);
+	};
+
+	//! \brief Sums the histograms from all processors in the communicator.
+	//! \details All processors must call this function with histograms that have the same range and bin size.
+	//! \param input is the histogram on the calling processor.
+	//! \param comm is the communicator of the processors whose histograms are summed.
+	//! \return The merged histogram on processor 0 of the communicator and the unchanged input histogram on all other processors.
+	Histogram MPI_mergeHistograms(const Histogram& input, MPI_Comm comm = MPI_COMM_WORLD);
+
+}
+
+#endif // EXCIMONTEC_HISTOGRAM_H
@@ -10,6 +10,12 @@ using namespace KMC_Lattice;
 
 namespace Excimontec {
 
+	const string OSC_Sim::Energies_binary_identifier = "EXCMTCEN";
+	const uint32_t OSC_Sim::Energies_binary_version = 1;
+	const uint32_t OSC_Sim::Energies_binary_flag_checksum = 1;
+	const string OSC_Sim::Checkpoint_identifier = "EXCMTCCP";
+	const uint32_t OSC_Sim::Checkpoint_version = 2;
+
 	OSC_Sim::OSC_Sim() {}
 
 	OSC_Sim::~OSC_Sim() {}
@@ -27,22 +33,19 @@ namespace Excimontec {
 		bool success;
 		// Set parameters of Simulation base class
 		Simulation::init(params_in, id);
+		// Reseed the random number generator when a fixed seed is specified, so that runs can be reproduced
+		if (params_in.Generator_seed >= 0) {
+			generator.seed((unsigned long)params_in.Generator_seed + (unsigned long)id);
+		}
 		// Initialize parameters object
 		params = params_in;
-		// Initialize derived parameters
-		if (params.Enable_ToF_test) {
-			Transient_start = params.ToF_transient_start;
-			Transient_end = params.ToF_transient_end;
-			Transient_pnts_per_decade = params.ToF_pnts_per_decade;
-		}
-		if (params.Enable_dynamics_test) {
-			Transient_start = params.Dynamics_transient_start;
-			Transient_end = params.Dynamics_transient_end;
-			Transient_pnts_per_decade = params.Dynamics_pnts_per_decade;
-		}
+		clearEventSlots();
+		escape_rate_cache.setCapacity(params.Escape_rate_cache_size);
+		escape_rate_cache.clear();
 		// Initialize Sites
 		Site_OSC site;
 		sites.assign(lattice.getNumSites(), site);
+		site_energies.reset();
 		// Initialize Film Architecture
 		success = initializeArchitecture();
 		if (!success) {
@@ -51,102 +54,23 @@ namespace Excimontec {
 			setErrorMessage("Error initializing the film architecture.");
 			return false;
 		}
-		// Assign energies to each site in the sites vector
-		reassignSiteEnergies();
-		// Initialize Coulomb interactions lookup table
-		AvgDielectric = (params.Dielectric_donor + params.Dielectric_acceptor) / 2;
-		Image_interaction_prefactor = (Elementary_charge / (16 * Pi*AvgDielectric*Vacuum_permittivity))*1e9;
-		double Unit_size = lattice.getUnitSize();
-		int range = (int)ceil(intpow(params.Coulomb_cutoff / lattice.getUnitSize(), 2));
-		Coulomb_table.assign(range + 1, 0);
-		for (int i = 1, imax = (int)Coulomb_table.size(); i < imax; i++) {
-			Coulomb_table[i] = ((Coulomb_constant*Elementary_charge) / AvgDielectric) / (1e-9*Unit_size*sqrt((double)i));
-			if (params.Enable_gaussian_polaron_delocalization) {
-				Coulomb_table[i] *= erf((Unit_size*sqrt((double)i)) / (params.Polaron_delocalization_length*sqrt(2)));
-			}
-		}
-		Coulomb_range = (int)ceil((params.Coulomb_cutoff / lattice.getUnitSize())*(params.Coulomb_cutoff / lattice.getUnitSize()));
-		// Initialize electrical potential vector
-		E_potential.assign(lattice.getHeight(), 0);
-		for (int i = 0; i < lattice.getHeight(); i++) {
-			E_potential[i] = (params.Internal_potential*lattice.getHeight() / (lattice.getHeight() + 1)) - (params.Internal_potential / (lattice.getHeight() + 1))*i;
+		return initializeTest();
+	}
+
+	bool OSC_Sim::addTests(const int N_tests_added) {
+		if (!(N_tests_added > 0) || params.Enable_steady_transport_test) {
+			return false;
 		}
-		// Initialize event calculation data
-		exciton_event_calc_vars = ExcitonEventCalcVars(this);
-		polaron_event_calc_vars = PolaronEventCalcVars(this);
-		// Initialize exciton creation event
-		R_exciton_generation_donor = ((params.Exciton_generation_rate_donor*N_donor_sites*1e-7*lattice.getUnitSize())*1e-7*lattice.getUnitSize())*1e-7*lattice.getUnitSize();
-		R_exciton_generation_acceptor = ((params.Exciton_generation_rate_acceptor*N_acceptor_sites*1e-7*lattice.getUnitSize())*1e-7*lattice.getUnitSize())*1e-7*lattice.getUnitSize();
-		if (params.Enable_exciton_diffusion_test || params.Enable_IQE_test) {
+		params.N_tests += N_tests_added;
+		// Restart exciton generation if it was stopped after all of the previous tests were created
+		if (params.Enable_IQE_test && !isLightOn) {
 			isLightOn = true;
-			Exciton::Creation exciton_creation_event(this);
-			exciton_creation_event.calculateRateConstant(R_exciton_generation_donor + R_exciton_generation_acceptor);
-			exciton_creation_event.calculateExecutionTime(R_exciton_generation_donor + R_exciton_generation_acceptor);
-			exciton_creation_events.assign(1, exciton_creation_event);
+			exciton_creation_events.front().calculateRateConstant(R_exciton_generation_donor + R_exciton_generation_acceptor);
+			exciton_creation_events.front().calculateExecutionTime(R_exciton_generation_donor + R_exciton_generation_acceptor);
 			exciton_creation_it = addEvent(&exciton_creation_events.front());
+			updateExcitonCreationEvent();
 		}
-		else if (params.Enable_dynamics_test) {
-			isLightOn = false;
-			// Initialize parameters
-			N_initial_excitons = (int)ceil(params.Dynamics_initial_exciton_conc*lattice.getVolume());
-			// Initialize data structures
-			Transient_step_size = 1.0 / (double)Transient_pnts_per_decade;
-			int num_steps = (int)floor((log10(Transient_end) - log10(Transient_start)) / Transient_step_size) + 1;
-			transient_times.assign(num_steps, 0);
-			for (int i = 0; i < (int)transient_times.size(); i++) {
-				transient_times[i] = pow(10, log10(Transient_start) + i * Transient_step_size);
-			}
-			transient_singlet_counts.assign(num_steps, 0);
-			transient_triplet_counts.assign(num_steps, 0);
-			transient_electron_counts.assign(num_steps, 0);
-			transient_hole_counts.assign(num_steps, 0);
-			transient_exciton_msdv.assign(num_steps, 0);
-			transient_electron_msdv.assign(num_steps, 0);
-			transient_hole_msdv.assign(num_steps, 0);
-			transient_exciton_energies.assign(num_steps, 0);
-			transient_electron_energies.assign(num_steps, 0);
-			transient_hole_energies.assign(num_steps, 0);
-			// Create initial test excitons
-			generateDynamicsExcitons();
-		}
-		else if (params.Enable_ToF_test) {
-			isLightOn = false;
-			// Initialize data structures
-			Transient_step_size = 1.0 / (double)Transient_pnts_per_decade;
-			int num_steps = (int)floor((log10(Transient_end) - log10(Transient_start)) / Transient_step_size) + 1;
-			transient_times.assign(num_steps, 0);
-			for (int i = 0; i < (int)transient_times.size(); i++) {
-				transient_times[i] = pow(10, log10(Transient_start) + i * Transient_step_size);
-			}
-			transient_velocities.assign(num_steps, 0);
-			if (!params.ToF_polaron_type) {
-				transient_electron_energies.assign(num_steps, 0);
-				transient_electron_counts.assign(num_steps, 0);
-			}
-			else {
-				transient_hole_energies.assign(num_steps, 0);
-				transient_hole_counts.assign(num_steps, 0);
-			}
-			electron_extraction_data.assign(lattice.getLength()*lattice.getWidth(), 0);
-			hole_extraction_data.assign(lattice.getLength()*lattice.getWidth(), 0);
-			// Create initial test polarons
-			generateToFPolarons();
-		}
-		else if (params.Enable_steady_transport_test) {
-			isLightOn = false;
-			// Create test polarons
-			generateSteadyPolarons();
-		}
-		if (params.Enable_IQE_test) {
-			electron_extraction_data.assign(lattice.getLength()*lattice.getWidth(), 0);
-			hole_extraction_data.assign(lattice.getLength()*lattice.getWidth(), 0);
-		}
-		if (Error_found) {
-			return false;
-		}
-		else {
-			return true;
-		}
+		return true;
 	}
 
 	void OSC_Sim::calculateAllEvents() {
@@ -154,7 +78,56 @@ namespace Excimontec {
 		calculateObjectListEvents(object_its);
 	}
 
+	int OSC_Sim::addEventSlot() {
+		int slot = params.Enable_FRM ? event_heap.addSlot() : rate_tree.addSlot();
+		if (slot >= (int)slot_events.size()) {
+			slot_events.resize(slot + 1, nullptr);
+		}
+		return slot;
+	}
+
+	void OSC_Sim::addFreeSite(const long int site_index) {
+		if (free_site_positions[site_index] >= 0) {
+			return;
+		}
+		auto& free_sites = (sites[site_index].getType() == (short)1) ? free_sites_donor : free_sites_acceptor;
+		free_site_positions[site_index] = (long int)free_sites.size();
+		free_sites.push_back(site_index);
+	}
+
+	void OSC_Sim::applyRateThinning(vector<Object*>& recalc_objects, const Object* object_ptr, const Coords& coords_start, const Coords& coords_dest) {
+		// Polarons that are outside of the hopping range of both sites keep the same possible events, and only their hop rates are changed
+		// by the Coulomb potential of a moving charge, so they are not recalculated while their hop rates remain below the upper bound rates
+		const int range_sq = polaron_event_calc_vars.range*polaron_event_calc_vars.range;
+		const bool is_charged = (object_ptr->getObjectType().compare(Polaron::object_type) == 0);
+		auto it_end = remove_if(recalc_objects.begin(), recalc_objects.end(), [&](Object* item) {
+			if (item == object_ptr || item->getObjectType().compare(Polaron::object_type) != 0) {
+				return false;
+			}
+			auto polaron_ptr = static_cast<Polaron*>(item);
+			if (polaron_ptr->isBasinActive()) {
+				return false;
+			}
+			int distance_sq_start = lattice.calculateLatticeDistanceSquared(item->getCoords(), coords_start);
+			int distance_sq_dest = lattice.calculateLatticeDistanceSquared(item->getCoords(), coords_dest);
+			if (!(distance_sq_start > range_sq) || !(distance_sq_dest > range_sq)) {
+				return false;
+			}
+			double drift = polaron_ptr->getCoulombDrift();
+			if (is_charged) {
+				drift += calculateCoulombDriftBound(distance_sq_start) + calculateCoulombDriftBound(distance_sq_dest);
+			}
+			if (drift > params.Thinning_energy_margin) {
+				return false;
+			}
+			polaron_ptr->setCoulombDrift(drift);
+			return true;
+		});
+		recalc_objects.erase(it_end, recalc_objects.end());
+	}
+
 	double OSC_Sim::calculateCoulomb(const std::list<Polaron>::const_iterator polaron_it, const KMC_Lattice::Coords& coords) const {
+		EXCIMONTEC_PROFILE_SCOPE(profiler, Profiler::Calculate_coulomb);
 		double Energy = 0;
 		double distance;
 		int distance_sq_lat;
@@ -167,10 +140,10 @@ namespace Excimontec {
 			distance_sq_lat = lattice.calculateLatticeDistanceSquared(coords, item.getCoords());
 			if (!(distance_sq_lat > Coulomb_range)) {
 				if (!charge) {
-					Energy += Coulomb_table[distance_sq_lat];
+					Energy += (*Coulomb_table)[distance_sq_lat];
 				}
 				else {
-					Energy -= Coulomb_table[distance_sq_lat];
+					Energy -= (*Coulomb_table)[distance_sq_lat];
 				}
 			}
 		}
@@ -182,10 +155,10 @@ namespace Excimontec {
 			distance_sq_lat = lattice.calculateLatticeDistanceSquared(coords, item.getCoords());
 			if (!(distance_sq_lat > Coulomb_range)) {
 				if (charge) {
-					Energy += Coulomb_table[distance_sq_lat];
+					Energy += (*Coulomb_table)[distance_sq_lat];
 				}
 				else {
-					Energy -= Coulomb_table[distance_sq_lat];
+					Energy -= (*Coulomb_table)[distance_sq_lat];
 				}
 			}
 		}
@@ -204,6 +177,7 @@ namespace Excimontec {
 	}
 
 	double OSC_Sim::calculateCoulomb(const bool charge, const KMC_Lattice::Coords& coords) const {
+		EXCIMONTEC_PROFILE_SCOPE(profiler, Profiler::Calculate_coulomb);
 		double Energy = 0;
 		double distance;
 		int distance_sq_lat;
@@ -212,10 +186,10 @@ namespace Excimontec {
 			distance_sq_lat = lattice.calculateLatticeDistanceSquared(coords, item.getCoords());
 			if (!(distance_sq_lat > Coulomb_range)) {
 				if (!charge) {
-					Energy += Coulomb_table[distance_sq_lat];
+					Energy += (*Coulomb_table)[distance_sq_lat];
 				}
 				else {
-					Energy -= Coulomb_table[distance_sq_lat];
+					Energy -= (*Coulomb_table)[distance_sq_lat];
 				}
 			}
 		}
@@ -224,10 +198,10 @@ namespace Excimontec {
 			distance_sq_lat = lattice.calculateLatticeDistanceSquared(coords, item.getCoords());
 			if (!(distance_sq_lat > Coulomb_range)) {
 				if (charge) {
-					Energy += Coulomb_table[distance_sq_lat];
+					Energy += (*Coulomb_table)[distance_sq_lat];
 				}
 				else {
-					Energy -= Coulomb_table[distance_sq_lat];
+					Energy -= (*Coulomb_table)[distance_sq_lat];
 				}
 			}
 		}
@@ -245,6 +219,81 @@ namespace Excimontec {
 		return Energy;
 	}
 
+	double OSC_Sim::calculateCoulombDriftBound(const int distance_sq_lat) const {
+		// The Coulomb energy change of a hop to any site within the hopping range changes by at most the difference between the Coulomb interactions
+		// at the closest and farthest distances from the charge that the starting site and the destination site can have
+		double distance = sqrt((double)distance_sq_lat);
+		int index_min = max(1, (int)ceil(intpow(distance - polaron_event_calc_vars.range, 2) - 1e-9));
+		if (index_min > Coulomb_range) {
+			return 0.0;
+		}
+		int index_max = (int)floor(intpow(distance + polaron_event_calc_vars.range, 2) + 1e-9);
+		return (*Coulomb_table)[index_min] - ((index_max > Coulomb_range) ? 0.0 : (*Coulomb_table)[index_max]);
+	}
+
+	void OSC_Sim::calculateCoulombField(const bool charge, vector<double>& energies) const {
+		energies.assign(lattice.getNumSites(), 0.0);
+		// Determine the displacement range in each direction, where periodic directions are limited so that each polaron is only counted at its minimum image distance
+		int range = (int)floor(sqrt((double)Coulomb_range));
+		auto getDisplacementLimits = [range](const int dim, const bool is_periodic) {
+			if (is_periodic) {
+				return make_pair(max(-range, -(dim - 1) / 2), min(range, dim / 2));
+			}
+			return make_pair(-range, range);
+		};
+		auto limits_x = getDisplacementLimits(lattice.getLength(), lattice.isXPeriodic());
+		auto limits_y = getDisplacementLimits(lattice.getWidth(), lattice.isYPeriodic());
+		auto limits_z = getDisplacementLimits(lattice.getHeight(), lattice.isZPeriodic());
+		// Build the list of displacements within the Coulomb cutoff radius
+		vector<pair<Coords, int>> displacements;
+		for (int i = limits_x.first; i <= limits_x.second; i++) {
+			for (int j = limits_y.first; j <= limits_y.second; j++) {
+				for (int k = limits_z.first; k <= limits_z.second; k++) {
+					int distance_sq_lat = i * i + j * j + k * k;
+					if (distance_sq_lat > 0 && !(distance_sq_lat > Coulomb_range)) {
+						displacements.push_back(make_pair(Coords(i, j, k), distance_sq_lat));
+					}
+				}
+			}
+		}
+		// Add the potential of each polaron to all sites within the cutoff radius
+		auto addPolaronPotential = [&](const Coords& coords, const bool polaron_charge) {
+			Coords dest_coords;
+			for (auto const &item : displacements) {
+				if (!lattice.checkMoveValidity(coords, item.first.x, item.first.y, item.first.z)) {
+					continue;
+				}
+				lattice.calculateDestinationCoords(coords, item.first.x, item.first.y, item.first.z, dest_coords);
+				if (polaron_charge == charge) {
+					energies[lattice.getSiteIndex(dest_coords)] += (*Coulomb_table)[item.second];
+				}
+				else {
+					energies[lattice.getSiteIndex(dest_coords)] -= (*Coulomb_table)[item.second];
+				}
+			}
+		};
+		for (auto const &item : electrons) {
+			addPolaronPotential(item.getCoords(), false);
+		}
+		for (auto const &item : holes) {
+			addPolaronPotential(item.getCoords(), true);
+		}
+		// Add electrode image charge interactions
+		if (!lattice.isZPeriodic()) {
+			for (long int n = 0; n < lattice.getNumSites(); n++) {
+				Coords coords = lattice.getSiteCoords(n);
+				double distance = lattice.getUnitSize()*((double)(lattice.getHeight() - coords.z) - 0.5);
+				if (!((distance - 0.0001) > params.Coulomb_cutoff)) {
+					energies[n] -= Image_interaction_prefactor / distance;
+				}
+				distance = lattice.getUnitSize()*((double)(coords.z + 1) - 0.5);
+				if (!((distance - 0.0001) > params.Coulomb_cutoff)) {
+					energies[n] -= Image_interaction_prefactor / distance;
+				}
+			}
+		}
+	}
+
 	void OSC_Sim::calculateDOSCorrelation() {
 		DOS_correlation_data.clear();
 		double cutoff_radius = 1.0;
@@ -303,11 +352,30 @@ namespace Excimontec {
 		}
 	}
 
+	uint32_t OSC_Sim::calculateEnergiesChecksum(const vector<float>& energies) {
+		// 32-bit FNV-1a hash of the little-endian byte representation of the site energies
+		uint32_t checksum = 2166136261u;
+		for (const auto& energy : energies) {
+			uint32_t bits;
+			memcpy(&bits, &energy, sizeof(bits));
+			for (int i = 0; i < 4; i++) {
+				checksum ^= (bits >> (8 * i)) & 0xFFu;
+				checksum *= 16777619u;
+			}
+		}
+		return checksum;
+	}
+
+	double OSC_Sim::calculateMobility(const double transit_time) const {
+		double mobility = (1e-7*lattice.getUnitSize()*lattice.getHeight()) / (fabs(params.Internal_potential)*transit_time);
+		mobility *= 1e-7*lattice.getUnitSize()*lattice.getHeight();
+		return mobility;
+	}
+
 	vector<double> OSC_Sim::calculateMobilityData(const vector<double>& transit_times) const {
 		vector<double> mobilities = transit_times;
 		for (int i = 0; i < (int)mobilities.size(); i++) {
-			mobilities[i] = (1e-7*lattice.getUnitSize()*lattice.getHeight()) / (fabs(params.Internal_potential)*transit_times[i]);
-			mobilities[i] *= 1e-7*lattice.getUnitSize()*lattice.getHeight();
+			mobilities[i] = calculateMobility(transit_times[i]);
 		}
 		return mobilities;
 	}
@@ -329,6 +397,15 @@ namespace Excimontec {
 		return dist;
 	}
 
+	vector<pair<double, double>> OSC_Sim::calculateTransitTimeHist(const Histogram& hist, const int counts) const {
+		auto dist = hist.getData();
+		for (auto& item : dist) {
+			item.first = pow(10, item.first);
+			item.second /= (double)counts;
+		}
+		return dist;
+	}
+
 	Coords OSC_Sim::calculateRandomExcitonCreationCoords() {
 		uniform_real_distribution<double> dist(0.0, R_exciton_generation_donor + R_exciton_generation_acceptor);
 		double num = dist(generator);
@@ -339,41 +416,56 @@ namespace Excimontec {
 		else {
 			type_target = 2;
 		}
-		// Faster method of choosing a random site.  This becomes slow when the lattice has high occupancy.
-		// Use faster method when lattice is less than 50% occupied.
-		int N_tries = 0;
-		while ((N_excitons + N_electrons + N_holes) < (0.5*lattice.getLength()*lattice.getWidth()*lattice.getHeight()) && N_tries < 10) {
-			auto dest_coords = lattice.generateRandomCoords();
-			if (!lattice.isOccupied(dest_coords) && getSiteType(dest_coords) == type_target) {
-				return dest_coords;
-			}
-			N_tries++;
+		// Choose one of the empty sites of the target type from the free site set
+		const auto& free_sites = (type_target == (short)1) ? free_sites_donor : free_sites_acceptor;
+		if (free_sites.empty()) {
+			cout << getId() << ": Error! An empty site for exciton creation could not be found." << endl;
+			setErrorMessage("An empty site for exciton creation could not be found.");
+			Error_found = true;
+			return Coords(-1, -1, -1);
 		}
-		// Method of choosing one of the empty sites.  This is slowish because it must loop through all sites first
-		// Get vector of possible creation sites
-		vector<long int> indices;
-		indices.reserve(lattice.getLength()*lattice.getWidth()*lattice.getHeight());
-		for (int x = 0; x < lattice.getLength(); x++) {
-			for (int y = 0; y < lattice.getWidth(); y++) {
-				for (int z = 0; z < lattice.getHeight(); z++) {
-					Coords dest_coords(x, y, z);
-					if (!lattice.isOccupied(dest_coords) && getSiteType(dest_coords) == type_target) {
-						indices.push_back(lattice.getSiteIndex(dest_coords));
+		uniform_int_distribution<long int> distn(0, (long int)free_sites.size() - 1);
+		return lattice.getSiteCoords(free_sites[distn(generator)]);
+	}
+
+	void OSC_Sim::calculateExcitonCachedHopEvent(const list<Exciton>::iterator exciton_it) {
+		const Coords object_coords = exciton_it->getCoords();
+		const long int key = 4 * lattice.getSiteIndex(object_coords) + (exciton_it->getSpin() ? 0 : 1);
+		auto entry_ptr = escape_rate_cache.find(key);
+		// The cache entry holds the hop rates to all valid sites within the hopping range, including the occupied sites
+		if (entry_ptr == nullptr) {
+			Coords dest_coords;
+			vector<int> targets;
+			vector<double> rates;
+			for (int i = -exciton_event_calc_vars.range, imax = exciton_event_calc_vars.range; i <= imax; i++) {
+				for (int j = -exciton_event_calc_vars.range, jmax = exciton_event_calc_vars.range; j <= jmax; j++) {
+					for (int k = -exciton_event_calc_vars.range, kmax = exciton_event_calc_vars.range; k <= kmax; k++) {
+						int index = (i + exciton_event_calc_vars.range)*exciton_event_calc_vars.dim*exciton_event_calc_vars.dim + (j + exciton_event_calc_vars.range)*exciton_event_calc_vars.dim + (k + exciton_event_calc_vars.range);
+						if (!exciton_event_calc_vars.isInFRETRange[index]) {
+							continue;
+						}
+						if (!lattice.checkMoveValidity(object_coords, i, j, k)) {
+							continue;
+						}
+						lattice.calculateDestinationCoords(object_coords, i, j, k, dest_coords);
+						targets.push_back(index);
+						rates.push_back(calculateExcitonHopRate(exciton_it, object_coords, dest_coords, index));
 					}
 				}
 			}
+			entry_ptr = &escape_rate_cache.insert(key, targets, rates);
 		}
-		if ((int)indices.size() == 0) {
-			cout << getId() << ": Error! An empty site for exciton creation could not be found." << endl;
-			setErrorMessage("An empty site for exciton creation could not be found.");
-			Error_found = true;
-			return Coords(-1, -1, -1);
+		if (!(entry_ptr->rate_total > 0)) {
+			return;
 		}
-		uniform_int_distribution<long int> distn(0, (long int)indices.size());
-		return lattice.getSiteCoords(indices[distn(generator)]);
+		// The hop event has the total escape rate of the site, and a hop to an occupied destination is rejected as a null event when it is chosen
+		double random_num1 = rand01();
+		double random_num2 = rand01();
+		event_candidates.push_back({ entry_ptr->rate_total, EscapeRateCache::sample(*entry_ptr, random_num1, random_num2), EventTrace::Exciton_hop });
 	}
 
 	void OSC_Sim::calculateExcitonEvents(Exciton* exciton_ptr) {
+		EXCIMONTEC_PROFILE_SCOPE(profiler, Profiler::Calculate_exciton_events);
 		const auto exciton_it = getExcitonIt(exciton_ptr);
 		const Coords object_coords = exciton_it->getCoords();
 		if (isLoggingEnabled()) {
@@ -382,186 +474,157 @@ namespace Excimontec {
 		Coords dest_coords;
 		double E_delta, Coulomb_final;
 		double rate = 0;
-		vector<Event*> possible_events;
+		event_candidates.clear();
 		// Exciton hopping, dissociation, and annihilation events
-		for (int i = -exciton_event_calc_vars.range, imax = exciton_event_calc_vars.range; i <= imax; i++) {
-			for (int j = -exciton_event_calc_vars.range, jmax = exciton_event_calc_vars.range; j <= jmax; j++) {
-				for (int k = -exciton_event_calc_vars.range, kmax = exciton_event_calc_vars.range; k <= kmax; k++) {
-					int index = (i + exciton_event_calc_vars.range)*exciton_event_calc_vars.dim*exciton_event_calc_vars.dim + (j + exciton_event_calc_vars.range)*exciton_event_calc_vars.dim + (k + exciton_event_calc_vars.range);
-					if (!exciton_event_calc_vars.isInDissRange[index] && !exciton_event_calc_vars.isInFRETRange[index]) {
-						continue;
-					}
-					if (!lattice.checkMoveValidity(object_coords, i, j, k)) {
-						continue;
-					}
-					lattice.calculateDestinationCoords(object_coords, i, j, k, dest_coords);
-					// Annihilation events
-					if (lattice.isOccupied(dest_coords)) {
-						if (exciton_event_calc_vars.isInFRETRange[index]) {
-							auto object_target_ptr = sites[lattice.getSiteIndex(dest_coords)].getObjectPtr();
-							// Exciton-Exciton annihilation
-							if (object_target_ptr->getObjectType().compare(Exciton::object_type) == 0) {
-								// Skip disallowed triplet-singlet annihilation
-								if (!exciton_it->getSpin() && getExcitonIt(object_target_ptr)->getSpin()) {
-									continue;
-								}
-								exciton_event_calc_vars.ee_annihilations_temp[index].setObjectPtr(exciton_ptr);
-								exciton_event_calc_vars.ee_annihilations_temp[index].setDestCoords(dest_coords);
-								exciton_event_calc_vars.ee_annihilations_temp[index].setObjectTargetPtr(object_target_ptr);
-								// Exciton is starting from a donor site
-								if (getSiteType(object_coords) == (short)1) {
-									// Triplet Dexter mechanism
-									if (!exciton_it->getSpin() && !params.Enable_FRET_triplet_annihilation) {
-										exciton_event_calc_vars.ee_annihilations_temp[index].calculateRateConstant(params.R_exciton_exciton_annihilation_donor, params.Triplet_localization_donor, exciton_event_calc_vars.distances[index]);
+		// With the escape rate cache, the neighboring sites only need to be searched when a dissociation or annihilation event is possible
+		if (!params.Enable_escape_rate_cache || !params.Enable_neat || N_excitons + N_electrons + N_holes > 1) {
+			for (int i = -exciton_event_calc_vars.range, imax = exciton_event_calc_vars.range; i <= imax; i++) {
+				for (int j = -exciton_event_calc_vars.range, jmax = exciton_event_calc_vars.range; j <= jmax; j++) {
+					for (int k = -exciton_event_calc_vars.range, kmax = exciton_event_calc_vars.range; k <= kmax; k++) {
+						int index = (i + exciton_event_calc_vars.range)*exciton_event_calc_vars.dim*exciton_event_calc_vars.dim + (j + exciton_event_calc_vars.range)*exciton_event_calc_vars.dim + (k + exciton_event_calc_vars.range);
+						if (!exciton_event_calc_vars.isInDissRange[index] && !exciton_event_calc_vars.isInFRETRange[index]) {
+							continue;
+						}
+						if (!lattice.checkMoveValidity(object_coords, i, j, k)) {
+							continue;
+						}
+						lattice.calculateDestinationCoords(object_coords, i, j, k, dest_coords);
+						// The occupant of the destination site is read from the site instead of looking up the object
+						const auto occupant = sites[lattice.getSiteIndex(dest_coords)].getOccupant();
+						// Annihilation events
+						if (occupant != Site_OSC::Empty) {
+							if (exciton_event_calc_vars.isInFRETRange[index]) {
+								// Exciton-Exciton annihilation
+								if (occupant == Site_OSC::Singlet || occupant == Site_OSC::Triplet) {
+									// Skip disallowed triplet-singlet annihilation
+									if (!exciton_it->getSpin() && occupant == Site_OSC::Singlet) {
+										continue;
+									}
+									// Exciton is starting from a donor site
+									if (getSiteType(object_coords) == (short)1) {
+										// Triplet Dexter mechanism
+										if (!exciton_it->getSpin() && !params.Enable_FRET_triplet_annihilation) {
+											exciton_event_calc_vars.ee_annihilation_event.calculateRateConstant(params.R_exciton_exciton_annihilation_donor, params.Triplet_localization_donor, exciton_event_calc_vars.distances[index]);
+										}
+										// FRET mechanism
+										else {
+											exciton_event_calc_vars.ee_annihilation_event.calculateRateConstant(params.R_exciton_exciton_annihilation_donor, exciton_event_calc_vars.distances[index]);
+										}
 									}
-									// FRET mechanism
+									// Exciton is starting from an acceptor site
 									else {
-										exciton_event_calc_vars.ee_annihilations_temp[index].calculateRateConstant(params.R_exciton_exciton_annihilation_donor, exciton_event_calc_vars.distances[index]);
+										// Triplet Dexter mechanism
+										if (!exciton_it->getSpin() && !params.Enable_FRET_triplet_annihilation) {
+											exciton_event_calc_vars.ee_annihilation_event.calculateRateConstant(params.R_exciton_exciton_annihilation_acceptor, params.Triplet_localization_acceptor, exciton_event_calc_vars.distances[index]);
+										}
+										// FRET mechanism
+										else {
+											exciton_event_calc_vars.ee_annihilation_event.calculateRateConstant(params.R_exciton_exciton_annihilation_acceptor, exciton_event_calc_vars.distances[index]);
+										}
 									}
+									// Save the calculated exciton-exciton annihilation event as a candidate event
+									event_candidates.push_back({ exciton_event_calc_vars.ee_annihilation_event.getRateConstant(), index, EventTrace::Exciton_exciton_annihilation });
 								}
-								// Exciton is starting from an acceptor site
+								// Exciton-Polaron annihilation
 								else {
-									// Triplet Dexter mechanism
-									if (!exciton_it->getSpin() && !params.Enable_FRET_triplet_annihilation) {
-										exciton_event_calc_vars.ee_annihilations_temp[index].calculateRateConstant(params.R_exciton_exciton_annihilation_acceptor, params.Triplet_localization_acceptor, exciton_event_calc_vars.distances[index]);
+									// Exciton is starting from a donor site
+									if (getSiteType(object_coords) == (short)1) {
+										// Triplet Dexter mechanism
+										if (!exciton_it->getSpin() && !params.Enable_FRET_triplet_annihilation) {
+											exciton_event_calc_vars.ep_annihilation_event.calculateRateConstant(params.R_exciton_polaron_annihilation_donor, params.Triplet_localization_donor, exciton_event_calc_vars.distances[index]);
+										}
+										// FRET mechanism
+										else {
+											exciton_event_calc_vars.ep_annihilation_event.calculateRateConstant(params.R_exciton_polaron_annihilation_donor, exciton_event_calc_vars.distances[index]);
+										}
 									}
-									// FRET mechanism
+									// Exciton is starting from an acceptor site
 									else {
-										exciton_event_calc_vars.ee_annihilations_temp[index].calculateRateConstant(params.R_exciton_exciton_annihilation_acceptor, exciton_event_calc_vars.distances[index]);
+										// Triplet Dexter mechanism
+										if (!exciton_it->getSpin() && !params.Enable_FRET_triplet_annihilation) {
+											exciton_event_calc_vars.ep_annihilation_event.calculateRateConstant(params.R_exciton_polaron_annihilation_acceptor, params.Triplet_localization_acceptor, exciton_event_calc_vars.distances[index]);
+										}
+										// FRET mechanism
+										else {
+											exciton_event_calc_vars.ep_annihilation_event.calculateRateConstant(params.R_exciton_polaron_annihilation_acceptor, exciton_event_calc_vars.distances[index]);
+										}
 									}
+									// Save the calculated exciton-polaron annihilation event as a candidate event
+									event_candidates.push_back({ exciton_event_calc_vars.ep_annihilation_event.getRateConstant(), index, EventTrace::Exciton_polaron_annihilation });
 								}
-								// Save the calculated exciton-exciton annihilation event as a possible event
-								possible_events.push_back(&exciton_event_calc_vars.ee_annihilations_temp[index]);
 							}
-							// Exciton-Polaron annihilation
-							else if (sites[lattice.getSiteIndex(dest_coords)].getObjectPtr()->getObjectType().compare(Polaron::object_type) == 0) {
-								exciton_event_calc_vars.ep_annihilations_temp[index].setObjectPtr(exciton_ptr);
-								exciton_event_calc_vars.ep_annihilations_temp[index].setDestCoords(dest_coords);
-								exciton_event_calc_vars.ep_annihilations_temp[index].setObjectTargetPtr(object_target_ptr);
+						}
+						// Dissociation and Hop events
+						else {
+							// Dissociation event
+							if (getSiteType(object_coords) != getSiteType(dest_coords) && exciton_event_calc_vars.isInDissRange[index]) {
 								// Exciton is starting from a donor site
 								if (getSiteType(object_coords) == (short)1) {
-									// Triplet Dexter mechanism
-									if (!exciton_it->getSpin() && !params.Enable_FRET_triplet_annihilation) {
-										exciton_event_calc_vars.ep_annihilations_temp[index].calculateRateConstant(params.R_exciton_polaron_annihilation_donor, params.Triplet_localization_donor, exciton_event_calc_vars.distances[index]);
+									Coulomb_final = calculateCoulomb(true, object_coords) + calculateCoulomb(false, dest_coords) - (*Coulomb_table)[i*i + j * j + k * k];
+									E_delta = (getSiteEnergy(dest_coords) - getSiteEnergy(object_coords)) - (params.Lumo_acceptor - params.Lumo_donor) + (Coulomb_final + params.E_exciton_binding_donor) + (E_potential[dest_coords.z] - E_potential[object_coords.z]);
+									// Singlet
+									if (exciton_ptr->getSpin()) {
+										if (params.Enable_miller_abrahams) {
+											exciton_event_calc_vars.diss_event.calculateRateConstant(params.R_exciton_dissociation_donor, params.Singlet_localization_donor, exciton_event_calc_vars.distances[index], E_delta);
+										}
+										else {
+											exciton_event_calc_vars.diss_event.calculateRateConstant(params.R_exciton_dissociation_donor, params.Singlet_localization_donor, exciton_event_calc_vars.distances[index], E_delta, params.Reorganization_donor);
+										}
 									}
-									// FRET mechanism
+									// Triplet
 									else {
-										exciton_event_calc_vars.ep_annihilations_temp[index].calculateRateConstant(params.R_exciton_polaron_annihilation_donor, exciton_event_calc_vars.distances[index]);
+										// Increase E_delta by the singlet-triplet energy splitting if the exciton is a triplet
+										E_delta += params.E_exciton_ST_donor;
+										if (params.Enable_miller_abrahams) {
+											exciton_event_calc_vars.diss_event.calculateRateConstant(params.R_exciton_dissociation_donor, params.Triplet_localization_donor, exciton_event_calc_vars.distances[index], E_delta);
+										}
+										else {
+											exciton_event_calc_vars.diss_event.calculateRateConstant(params.R_exciton_dissociation_donor, params.Triplet_localization_donor, exciton_event_calc_vars.distances[index], E_delta, params.Reorganization_donor);
+										}
 									}
 								}
 								// Exciton is starting from an acceptor site
 								else {
-									// Triplet Dexter mechanism
-									if (!exciton_it->getSpin() && !params.Enable_FRET_triplet_annihilation) {
-										exciton_event_calc_vars.ep_annihilations_temp[index].calculateRateConstant(params.R_exciton_polaron_annihilation_acceptor, params.Triplet_localization_acceptor, exciton_event_calc_vars.distances[index]);
-									}
-									// FRET mechanism
-									else {
-										exciton_event_calc_vars.ep_annihilations_temp[index].calculateRateConstant(params.R_exciton_polaron_annihilation_acceptor, exciton_event_calc_vars.distances[index]);
-									}
-								}
-								// Save the calculated exciton-polaron annihilation event as a possible event
-								possible_events.push_back(&exciton_event_calc_vars.ep_annihilations_temp[index]);
-							}
-						}
-					}
-					// Dissociation and Hop events
-					else {
-						// Dissociation event
-						if (getSiteType(object_coords) != getSiteType(dest_coords) && exciton_event_calc_vars.isInDissRange[index]) {
-							exciton_event_calc_vars.dissociations_temp[index].setObjectPtr(exciton_ptr);
-							exciton_event_calc_vars.dissociations_temp[index].setDestCoords(dest_coords);
-							// Exciton is starting from a donor site
-							if (getSiteType(object_coords) == (short)1) {
-								Coulomb_final = calculateCoulomb(true, object_coords) + calculateCoulomb(false, dest_coords) - Coulomb_table[i*i + j * j + k * k];
-								E_delta = (getSiteEnergy(dest_coords) - getSiteEnergy(object_coords)) - (params.Lumo_acceptor - params.Lumo_donor) + (Coulomb_final + params.E_exciton_binding_donor) + (E_potential[dest_coords.z] - E_potential[object_coords.z]);
-								// Singlet
-								if (exciton_ptr->getSpin()) {
-									if (params.Enable_miller_abrahams) {
-										exciton_event_calc_vars.dissociations_temp[index].calculateRateConstant(params.R_exciton_dissociation_donor, params.Singlet_localization_donor, exciton_event_calc_vars.distances[index], E_delta);
-									}
-									else {
-										exciton_event_calc_vars.dissociations_temp[index].calculateRateConstant(params.R_exciton_dissociation_donor, params.Singlet_localization_donor, exciton_event_calc_vars.distances[index], E_delta, params.Reorganization_donor);
-									}
-								}
-								// Triplet
-								else {
-									// Increase E_delta by the singlet-triplet energy splitting if the exciton is a triplet
-									E_delta += params.E_exciton_ST_donor;
-									if (params.Enable_miller_abrahams) {
-										exciton_event_calc_vars.dissociations_temp[index].calculateRateConstant(params.R_exciton_dissociation_donor, params.Triplet_localization_donor, exciton_event_calc_vars.distances[index], E_delta);
+									Coulomb_final = calculateCoulomb(false, object_coords) + calculateCoulomb(true, dest_coords) - (*Coulomb_table)[i*i + j * j + k * k];
+									E_delta = (getSiteEnergy(dest_coords) - getSiteEnergy(object_coords)) + (params.Homo_donor - params.Homo_acceptor) + (Coulomb_final + params.E_exciton_binding_donor) - (E_potential[dest_coords.z] - E_potential[object_coords.z]);
+									// Singlet
+									if (exciton_ptr->getSpin()) {
+										if (params.Enable_miller_abrahams) {
+											exciton_event_calc_vars.diss_event.calculateRateConstant(params.R_exciton_dissociation_acceptor, params.Singlet_localization_acceptor, exciton_event_calc_vars.distances[index], E_delta);
+										}
+										else {
+											exciton_event_calc_vars.diss_event.calculateRateConstant(params.R_exciton_dissociation_acceptor, params.Singlet_localization_acceptor, exciton_event_calc_vars.distances[index], E_delta, params.Reorganization_acceptor);
+										}
 									}
+									// Triplet
 									else {
-										exciton_event_calc_vars.dissociations_temp[index].calculateRateConstant(params.R_exciton_dissociation_donor, params.Triplet_localization_donor, exciton_event_calc_vars.distances[index], E_delta, params.Reorganization_donor);
+										// Increase E_delta by the singlet-triplet energy splitting if the exciton is a triplet
+										E_delta += params.E_exciton_ST_acceptor;
+										if (params.Enable_miller_abrahams) {
+											exciton_event_calc_vars.diss_event.calculateRateConstant(params.R_exciton_dissociation_acceptor, params.Triplet_localization_acceptor, exciton_event_calc_vars.distances[index], E_delta);
+										}
+										else {
+											exciton_event_calc_vars.diss_event.calculateRateConstant(params.R_exciton_dissociation_acceptor, params.Triplet_localization_acceptor, exciton_event_calc_vars.distances[index], E_delta, params.Reorganization_acceptor);
+										}
 									}
 								}
+								// Save the calculated exciton dissociation event as a candidate event
+								event_candidates.push_back({ exciton_event_calc_vars.diss_event.getRateConstant(), index, EventTrace::Exciton_dissociation });
 							}
-							// Exciton is starting from an acceptor site
-							else {
-								Coulomb_final = calculateCoulomb(false, object_coords) + calculateCoulomb(true, dest_coords) - Coulomb_table[i*i + j * j + k * k];
-								E_delta = (getSiteEnergy(dest_coords) - getSiteEnergy(object_coords)) + (params.Homo_donor - params.Homo_acceptor) + (Coulomb_final + params.E_exciton_binding_donor) - (E_potential[dest_coords.z] - E_potential[object_coords.z]);
-								// Singlet
-								if (exciton_ptr->getSpin()) {
-									if (params.Enable_miller_abrahams) {
-										exciton_event_calc_vars.dissociations_temp[index].calculateRateConstant(params.R_exciton_dissociation_acceptor, params.Singlet_localization_acceptor, exciton_event_calc_vars.distances[index], E_delta);
-									}
-									else {
-										exciton_event_calc_vars.dissociations_temp[index].calculateRateConstant(params.R_exciton_dissociation_acceptor, params.Singlet_localization_acceptor, exciton_event_calc_vars.distances[index], E_delta, params.Reorganization_acceptor);
-									}
-								}
-								// Triplet
-								else {
-									// Increase E_delta by the singlet-triplet energy splitting if the exciton is a triplet
-									E_delta += params.E_exciton_ST_acceptor;
-									if (params.Enable_miller_abrahams) {
-										exciton_event_calc_vars.dissociations_temp[index].calculateRateConstant(params.R_exciton_dissociation_acceptor, params.Triplet_localization_acceptor, exciton_event_calc_vars.distances[index], E_delta);
-									}
-									else {
-										exciton_event_calc_vars.dissociations_temp[index].calculateRateConstant(params.R_exciton_dissociation_acceptor, params.Triplet_localization_acceptor, exciton_event_calc_vars.distances[index], E_delta, params.Reorganization_acceptor);
-									}
-								}
+							// Hop event
+							// With the escape rate cache, the hops are replaced by one hop event to a destination sampled from the cached rates
+							if (exciton_event_calc_vars.isInFRETRange[index] && !params.Enable_escape_rate_cache) {
+								// Save the calculated exciton hop event as a candidate event
+								event_candidates.push_back({ calculateExcitonHopRate(exciton_it, object_coords, dest_coords, index), index, EventTrace::Exciton_hop });
 							}
-							// Save the calculated exciton dissociation event as a possible event
-							possible_events.push_back(&exciton_event_calc_vars.dissociations_temp[index]);
-						}
-						// Hop event
-						if (exciton_event_calc_vars.isInFRETRange[index]) {
-							exciton_event_calc_vars.hops_temp[index].setObjectPtr(exciton_ptr);
-							exciton_event_calc_vars.hops_temp[index].setDestCoords(dest_coords);
-							E_delta = (getSiteEnergy(dest_coords) - getSiteEnergy(object_coords));
-							// Singlet FRET hopping
-							if (exciton_it->getSpin()) {
-								if (getSiteType(object_coords) == (short)1) {
-									// donor-to-acceptor energy modification
-									if (getSiteType(dest_coords) == (short)2) {
-										E_delta += (params.Homo_acceptor - params.Lumo_acceptor - params.E_exciton_binding_acceptor) - (params.Homo_donor - params.Lumo_donor - params.E_exciton_binding_donor);
-									}
-									exciton_event_calc_vars.hops_temp[index].calculateRateConstant(params.R_singlet_hopping_donor, exciton_event_calc_vars.distances[index], E_delta);
-								}
-								else {
-									// acceptor-to-donor energy modification
-									if (getSiteType(dest_coords) == (short)1) {
-										E_delta += (params.Homo_donor - params.Lumo_donor - params.E_exciton_binding_donor) - (params.Homo_acceptor - params.Lumo_acceptor - params.E_exciton_binding_acceptor);
-									}
-									exciton_event_calc_vars.hops_temp[index].calculateRateConstant(params.R_singlet_hopping_acceptor, exciton_event_calc_vars.distances[index], E_delta);
-								}
-							}
-							// Dexter hopping is only donor-to-donor and acceptor-to-acceptor
-							else {
-								if (getSiteType(object_coords) == (short)1) {
-									exciton_event_calc_vars.hops_temp[index].calculateRateConstant(params.R_triplet_hopping_donor, params.Triplet_localization_donor, exciton_event_calc_vars.distances[index], E_delta);
-								}
-								else {
-									exciton_event_calc_vars.hops_temp[index].calculateRateConstant(params.R_triplet_hopping_donor, params.Triplet_localization_acceptor, exciton_event_calc_vars.distances[index], E_delta);
-								}
-							}
-							// Save the calculated exciton hop event as a possible event
-							possible_events.push_back(&exciton_event_calc_vars.hops_temp[index]);
 						}
 					}
 				}
 			}
 		}
+		if (params.Enable_escape_rate_cache) {
+			calculateExcitonCachedHopEvent(exciton_it);
+		}
 		// Exciton Recombination
 		auto recombination_event_it = find_if(exciton_recombination_events.begin(), exciton_recombination_events.end(), [exciton_ptr](Exciton::Recombination& a) { return a.getObjectPtr() == exciton_ptr; });
 		if (exciton_it->getSpin()) {
@@ -581,8 +644,8 @@ namespace Excimontec {
 			}
 		}
 		recombination_event_it->calculateRateConstant(rate);
-		// Save the calculated exciton recombination event as a possible event
-		possible_events.push_back(&(*recombination_event_it));
+		// Save the calculated exciton recombination event as a candidate event
+		event_candidates.push_back({ recombination_event_it->getRateConstant(), -1, EventTrace::Exciton_recombination });
 		// Exciton Intersystem Crossing
 		auto intersystem_crossing_event_it = find_if(exciton_intersystem_crossing_events.begin(), exciton_intersystem_crossing_events.end(), [exciton_ptr](Exciton::Intersystem_Crossing& a) { return a.getObjectPtr() == exciton_ptr; });
 		// ISC
@@ -603,54 +666,116 @@ namespace Excimontec {
 				intersystem_crossing_event_it->calculateRateConstant(params.R_exciton_risc_acceptor, params.E_exciton_ST_acceptor);
 			}
 		}
-		// Save the calculated exciton ISC/RISC event as a possible event
-		possible_events.push_back(&(*intersystem_crossing_event_it));
+		// Save the calculated exciton ISC/RISC event as a candidate event
+		event_candidates.push_back({ intersystem_crossing_event_it->getRateConstant(), -1, EventTrace::Exciton_intersystem_crossing });
 		// Check for no valid events
-		if (possible_events.size() == 0) {
-			setObjectEvent(exciton_ptr, nullptr);
+		EXCIMONTEC_PROFILE_ITEMS(profiler, Profiler::Calculate_exciton_events, event_candidates.size());
+		if (event_candidates.size() == 0) {
+			setObjectEvent(exciton_ptr, nullptr, 0.0);
 			cout << getId() << ": Error! No valid exciton events could be calculated." << endl;
 			setErrorMessage("No valid exciton events could be calculated.");
 			Error_found = true;
 			return;
 		}
 		// Determine which event will be selected
-		Event* event_ptr_target = determinePathway(possible_events);
-		// Check that the execution time is valid
-		if (event_ptr_target->getExecutionTime() < getTime()) {
-			setObjectEvent(exciton_ptr, nullptr);
-			cout << getId() << ": Error! The fastest exciton event execution time is less than the current simulation time." << endl;
-			setErrorMessage(" The fastest exciton event execution time is less than the current simulation time.");
-			Error_found = true;
-			return;
-		}
-		// Copy the chosen temp event to the appropriate main event list and set the target event pointer to the corresponding event from the main list
-		string event_type = event_ptr_target->getEventType();
-		if (event_type.compare(Exciton::Hop::event_type) == 0) {
+		double rate_total;
+		const EventCandidate candidate = event_candidates[chooseEventCandidate(rate_total)];
+		if (candidate.index >= 0) {
+			int dim = exciton_event_calc_vars.dim;
+			int range = exciton_event_calc_vars.range;
+			lattice.calculateDestinationCoords(object_coords, candidate.index / (dim*dim) - range, (candidate.index / dim) % dim - range, candidate.index % dim - range, dest_coords);
+		}
+		// Copy the chosen candidate to the event of the exciton in the appropriate main event list
+		Event* event_ptr_target = nullptr;
+		auto list_offset = std::distance(excitons.begin(), exciton_it);
+		switch (candidate.kind) {
+		case EventTrace::Exciton_hop: {
 			auto hop_list_it = exciton_hop_events.begin();
-			std::advance(hop_list_it, std::distance(excitons.begin(), exciton_it));
-			*hop_list_it = *static_cast<Exciton::Hop*>(event_ptr_target);
+			std::advance(hop_list_it, list_offset);
+			hop_list_it->setObjectPtr(exciton_ptr);
+			hop_list_it->setDestCoords(dest_coords);
+			hop_list_it->setRateConstant(candidate.rate);
 			event_ptr_target = &(*hop_list_it);
+			break;
 		}
-		else if (event_type.compare(Exciton::Dissociation::event_type) == 0) {
+		case EventTrace::Exciton_dissociation: {
 			auto dissociation_list_it = exciton_dissociation_events.begin();
-			std::advance(dissociation_list_it, std::distance(excitons.begin(), exciton_it));
-			*dissociation_list_it = *static_cast<Exciton::Dissociation*>(event_ptr_target);
+			std::advance(dissociation_list_it, list_offset);
+			dissociation_list_it->setObjectPtr(exciton_ptr);
+			dissociation_list_it->setDestCoords(dest_coords);
+			dissociation_list_it->setRateConstant(candidate.rate);
 			event_ptr_target = &(*dissociation_list_it);
+			break;
 		}
-		else if (event_type.compare(Exciton::Exciton_Annihilation::event_type) == 0) {
+		case EventTrace::Exciton_exciton_annihilation: {
 			auto exciton_exciton_annihilation_list_it = exciton_exciton_annihilation_events.begin();
-			std::advance(exciton_exciton_annihilation_list_it, std::distance(excitons.begin(), exciton_it));
-			*exciton_exciton_annihilation_list_it = *static_cast<Exciton::Exciton_Annihilation*>(event_ptr_target);
+			std::advance(exciton_exciton_annihilation_list_it, list_offset);
+			exciton_exciton_annihilation_list_it->setObjectPtr(exciton_ptr);
+			exciton_exciton_annihilation_list_it->setDestCoords(dest_coords);
+			exciton_exciton_annihilation_list_it->setObjectTargetPtr(sites[lattice.getSiteIndex(dest_coords)].getObjectPtr());
+			exciton_exciton_annihilation_list_it->setRateConstant(candidate.rate);
 			event_ptr_target = &(*exciton_exciton_annihilation_list_it);
+			break;
 		}
-		else if (event_type.compare(Exciton::Polaron_Annihilation::event_type) == 0) {
+		case EventTrace::Exciton_polaron_annihilation: {
 			auto exciton_polaron_annihilation_list_it = exciton_polaron_annihilation_events.begin();
-			std::advance(exciton_polaron_annihilation_list_it, std::distance(excitons.begin(), exciton_it));
-			*exciton_polaron_annihilation_list_it = *static_cast<Exciton::Polaron_Annihilation*>(event_ptr_target);
+			std::advance(exciton_polaron_annihilation_list_it, list_offset);
+			exciton_polaron_annihilation_list_it->setObjectPtr(exciton_ptr);
+			exciton_polaron_annihilation_list_it->setDestCoords(dest_coords);
+			exciton_polaron_annihilation_list_it->setObjectTargetPtr(sites[lattice.getSiteIndex(dest_coords)].getObjectPtr());
+			exciton_polaron_annihilation_list_it->setRateConstant(candidate.rate);
 			event_ptr_target = &(*exciton_polaron_annihilation_list_it);
+			break;
+		}
+		case EventTrace::Exciton_recombination:
+			event_ptr_target = &(*recombination_event_it);
+			break;
+		default:
+			event_ptr_target = &(*intersystem_crossing_event_it);
+			break;
 		}
-		// Set the chosen event
-		setObjectEvent(exciton_ptr, event_ptr_target);
+		event_ptr_target->calculateExecutionTime(rate_total);
+		// Check that the execution time is valid
+		if (event_ptr_target->getExecutionTime() < getTime()) {
+			setObjectEvent(exciton_ptr, nullptr, 0.0);
+			cout << getId() << ": Error! The fastest exciton event execution time is less than the current simulation time." << endl;
+			setErrorMessage(" The fastest exciton event execution time is less than the current simulation time.");
+			Error_found = true;
+			return;
+		}
+		// Set the chosen event along with the total rate of all candidate events
+		setObjectEvent(exciton_ptr, event_ptr_target, rate_total);
+	}
+
+	double OSC_Sim::calculateExcitonHopRate(const list<Exciton>::iterator exciton_it, const Coords& coords_start, const Coords& coords_dest, const int index) {
+		double E_delta = (getSiteEnergy(coords_dest) - getSiteEnergy(coords_start));
+		// Singlet FRET hopping
+		if (exciton_it->getSpin()) {
+			if (getSiteType(coords_start) == (short)1) {
+				// donor-to-acceptor energy modification
+				if (getSiteType(coords_dest) == (short)2) {
+					E_delta += (params.Homo_acceptor - params.Lumo_acceptor - params.E_exciton_binding_acceptor) - (params.Homo_donor - params.Lumo_donor - params.E_exciton_binding_donor);
+				}
+				exciton_event_calc_vars.hop_event.calculateRateConstant(params.R_singlet_hopping_donor, exciton_event_calc_vars.distances[index], E_delta);
+			}
+			else {
+				// acceptor-to-donor energy modification
+				if (getSiteType(coords_dest) == (short)1) {
+					E_delta += (params.Homo_donor - params.Lumo_donor - params.E_exciton_binding_donor) - (params.Homo_acceptor - params.Lumo_acceptor - params.E_exciton_binding_acceptor);
+				}
+				exciton_event_calc_vars.hop_event.calculateRateConstant(params.R_singlet_hopping_acceptor, exciton_event_calc_vars.distances[index], E_delta);
+			}
+		}
+		// Dexter hopping is only donor-to-donor and acceptor-to-acceptor
+		else {
+			if (getSiteType(coords_start) == (short)1) {
+				exciton_event_calc_vars.hop_event.calculateRateConstant(params.R_triplet_hopping_donor, params.Triplet_localization_donor, exciton_event_calc_vars.distances[index], E_delta);
+			}
+			else {
+				exciton_event_calc_vars.hop_event.calculateRateConstant(params.R_triplet_hopping_donor, params.Triplet_localization_acceptor, exciton_event_calc_vars.distances[index], E_delta);
+			}
+		}
+		return exciton_event_calc_vars.hop_event.getRateConstant();
 	}
 
 	void OSC_Sim::calculateObjectListEvents(const vector<Object*>& object_ptr_vec) {
@@ -669,7 +794,48 @@ namespace Excimontec {
 		}
 	}
 
+	void OSC_Sim::calculatePolaronCachedHopEvent(const list<Polaron>::iterator polaron_it) {
+		const Coords object_coords = polaron_it->getCoords();
+		const long int key = 4 * lattice.getSiteIndex(object_coords) + (polaron_it->getCharge() ? 3 : 2);
+		auto entry_ptr = escape_rate_cache.find(key);
+		// The cache entry holds the hop rates to all valid sites within the hopping range, including the occupied sites
+		if (entry_ptr == nullptr) {
+			Coords dest_coords;
+			vector<int> targets;
+			vector<double> rates;
+			double E_site_start = getSiteEnergy(object_coords);
+			for (int i = -polaron_event_calc_vars.range, imax = polaron_event_calc_vars.range; i <= imax; i++) {
+				for (int j = -polaron_event_calc_vars.range, jmax = polaron_event_calc_vars.range; j <= jmax; j++) {
+					for (int k = -polaron_event_calc_vars.range, kmax = polaron_event_calc_vars.range; k <= kmax; k++) {
+						int index = (i + polaron_event_calc_vars.range)*polaron_event_calc_vars.dim*polaron_event_calc_vars.dim + (j + polaron_event_calc_vars.range)*polaron_event_calc_vars.dim + (k + polaron_event_calc_vars.range);
+						if (!polaron_event_calc_vars.isInRange[index]) {
+							continue;
+						}
+						if (!lattice.checkMoveValidity(object_coords, i, j, k)) {
+							continue;
+						}
+						lattice.calculateDestinationCoords(object_coords, i, j, k, dest_coords);
+						if (params.Enable_phase_restriction && getSiteType(object_coords) != getSiteType(dest_coords)) {
+							continue;
+						}
+						targets.push_back(index);
+						rates.push_back(calculatePolaronHopRate(polaron_it, object_coords, dest_coords, index, E_site_start, 0.0, 0.0));
+					}
+				}
+			}
+			entry_ptr = &escape_rate_cache.insert(key, targets, rates);
+		}
+		if (!(entry_ptr->rate_total > 0)) {
+			return;
+		}
+		// The hop event has the total escape rate of the site, and a hop to an occupied destination is rejected as a null event when it is chosen
+		double random_num1 = rand01();
+		double random_num2 = rand01();
+		event_candidates.push_back({ entry_ptr->rate_total, EscapeRateCache::sample(*entry_ptr, random_num1, random_num2), EventTrace::Polaron_hop });
+	}
+
 	void OSC_Sim::calculatePolaronEvents(Polaron* polaron_ptr) {
+		EXCIMONTEC_PROFILE_SCOPE(profiler, Profiler::Calculate_polaron_events);
 		const auto polaron_it = getPolaronIt(polaron_ptr);
 		const Coords object_coords = polaron_it->getCoords();
 		if (isLoggingEnabled()) {
@@ -692,101 +858,66 @@ namespace Excimontec {
 			Error_found = true;
 			return;
 		}
+		// Polarons that have made many hops within a small set of sites leave the set in one accelerated superbasin exit event
+		polaron_it->setBasinActive(false);
+		if (params.Enable_superbasin_acceleration && polaron_it->getBasinHops() >= params.Superbasin_min_hops && calculatePolaronSuperbasinEvent(polaron_it)) {
+			return;
+		}
 		Coords dest_coords;
 		int index;
 		double E_site_i = getSiteEnergy(object_coords);
-		double Coulomb_i = calculateCoulomb(polaron_it, object_coords);
-		vector<Event*> possible_events;
+		// The cached hop rates of the escape rate cache do not include the Coulomb interactions
+		double Coulomb_i = params.Enable_escape_rate_cache ? 0.0 : calculateCoulomb(polaron_it, object_coords);
+		// With rate thinning, the hop events are calculated with upper bound rates that allow for later changes in the Coulomb potential
+		double E_margin = params.Enable_rate_thinning ? params.Thinning_energy_margin : 0.0;
+		polaron_it->setCoulombDrift(0.0);
+		event_candidates.clear();
 		// Calculate Polaron hopping and recombination events
-		for (int i = -polaron_event_calc_vars.range, imax = polaron_event_calc_vars.range; i <= imax; i++) {
-			for (int j = -polaron_event_calc_vars.range, jmax = polaron_event_calc_vars.range; j <= jmax; j++) {
-				for (int k = -polaron_event_calc_vars.range, kmax = polaron_event_calc_vars.range; k <= kmax; k++) {
-					index = (i + polaron_event_calc_vars.range)*polaron_event_calc_vars.dim*polaron_event_calc_vars.dim + (j + polaron_event_calc_vars.range)*polaron_event_calc_vars.dim + (k + polaron_event_calc_vars.range);
-					if (!polaron_event_calc_vars.isInRange[index]) {
-						continue;
-					}
-					if (!lattice.checkMoveValidity(object_coords, i, j, k)) {
-						continue;
-					}
-					lattice.calculateDestinationCoords(object_coords, i, j, k, dest_coords);
-					// Recombination events
-					// If destination site is occupied by a hole Polaron and the main Polaron is an electron, check for a possible recombination event
-					if (lattice.isOccupied(dest_coords) && !polaron_it->getCharge() && siteContainsHole(dest_coords)) {
-						if (getSiteType(object_coords) == (short)1) {
-							polaron_event_calc_vars.recombinations_temp[index].calculateRateConstant(params.R_polaron_recombination, params.Polaron_localization_donor, polaron_event_calc_vars.distances[index], 0);
-						}
-						else if (getSiteType(object_coords) == (short)2) {
-							polaron_event_calc_vars.recombinations_temp[index].calculateRateConstant(params.R_polaron_recombination, params.Polaron_localization_acceptor, polaron_event_calc_vars.distances[index], 0);
-						}
-						polaron_event_calc_vars.recombinations_temp[index].setObjectPtr(polaron_ptr);
-						polaron_event_calc_vars.recombinations_temp[index].setDestCoords(dest_coords);
-						polaron_event_calc_vars.recombinations_temp[index].setObjectTargetPtr((*lattice.getSiteIt(dest_coords))->getObjectPtr());
-						possible_events.push_back(&polaron_event_calc_vars.recombinations_temp[index]);
-					}
-					// Hop events
-					// If destination site is unoccupied and either phase restriction is disabled or the starting site and destination sites have the same type, check for a possible hop event
-					if (!lattice.isOccupied(dest_coords) && (!params.Enable_phase_restriction || getSiteType(object_coords) == getSiteType(dest_coords))) {
-						polaron_event_calc_vars.E_deltas[index] = (getSiteEnergy(dest_coords) - E_site_i);
-						polaron_event_calc_vars.E_deltas[index] += (calculateCoulomb(polaron_it, dest_coords) - Coulomb_i);
-						double E_potential_change = (E_potential[dest_coords.z] - E_potential[object_coords.z]);
-						if (lattice.calculateDZ(object_coords, dest_coords) < 0) {
-							E_potential_change -= params.Internal_potential;
-						}
-						if (lattice.calculateDZ(object_coords, dest_coords) > 0) {
-							E_potential_change += params.Internal_potential;
-						}
-						if (!polaron_it->getCharge()) {
-							polaron_event_calc_vars.E_deltas[index] += E_potential_change;
+		// With the escape rate cache, the neighboring sites only need to be searched when a recombination event is possible
+		if (!params.Enable_escape_rate_cache || (!polaron_it->getCharge() && N_holes > 0)) {
+			for (int i = -polaron_event_calc_vars.range, imax = polaron_event_calc_vars.range; i <= imax; i++) {
+				for (int j = -polaron_event_calc_vars.range, jmax = polaron_event_calc_vars.range; j <= jmax; j++) {
+					for (int k = -polaron_event_calc_vars.range, kmax = polaron_event_calc_vars.range; k <= kmax; k++) {
+						index = (i + polaron_event_calc_vars.range)*polaron_event_calc_vars.dim*polaron_event_calc_vars.dim + (j + polaron_event_calc_vars.range)*polaron_event_calc_vars.dim + (k + polaron_event_calc_vars.range);
+						if (!polaron_event_calc_vars.isInRange[index]) {
+							continue;
 						}
-						else {
-							polaron_event_calc_vars.E_deltas[index] -= E_potential_change;
+						if (!lattice.checkMoveValidity(object_coords, i, j, k)) {
+							continue;
 						}
-						if (getSiteType(object_coords) == (short)1) {
-							if (getSiteType(dest_coords) == (short)2) {
-								if (!polaron_it->getCharge()) {
-									polaron_event_calc_vars.E_deltas[index] -= (params.Lumo_acceptor - params.Lumo_donor);
-								}
-								else {
-									polaron_event_calc_vars.E_deltas[index] -= (params.Homo_acceptor - params.Homo_donor);
-								}
-							}
-							if (params.Enable_miller_abrahams) {
-								polaron_event_calc_vars.hops_temp[index].calculateRateConstant(params.R_polaron_hopping_donor, params.Polaron_localization_donor, polaron_event_calc_vars.distances[index], polaron_event_calc_vars.E_deltas[index]);
+						lattice.calculateDestinationCoords(object_coords, i, j, k, dest_coords);
+						// The occupant of the destination site is read from the site instead of looking up the object
+						const auto occupant = sites[lattice.getSiteIndex(dest_coords)].getOccupant();
+						// Recombination events
+						// If destination site is occupied by a hole Polaron and the main Polaron is an electron, check for a possible recombination event
+						if (occupant == Site_OSC::Hole && !polaron_it->getCharge()) {
+							if (getSiteType(object_coords) == (short)1) {
+								polaron_event_calc_vars.rec_event.calculateRateConstant(params.R_polaron_recombination, params.Polaron_localization_donor, polaron_event_calc_vars.distances[index], 0);
 							}
-							else {
-								polaron_event_calc_vars.hops_temp[index].calculateRateConstant(params.R_polaron_hopping_donor, params.Polaron_localization_donor, polaron_event_calc_vars.distances[index], polaron_event_calc_vars.E_deltas[index], params.Reorganization_donor);
+							else if (getSiteType(object_coords) == (short)2) {
+								polaron_event_calc_vars.rec_event.calculateRateConstant(params.R_polaron_recombination, params.Polaron_localization_acceptor, polaron_event_calc_vars.distances[index], 0);
 							}
+							event_candidates.push_back({ polaron_event_calc_vars.rec_event.getRateConstant(), index, EventTrace::Polaron_recombination });
 						}
-						else if (getSiteType(object_coords) == (short)2) {
-							if (getSiteType(dest_coords) == (short)1) {
-								if (!polaron_it->getCharge()) {
-									polaron_event_calc_vars.E_deltas[index] -= (params.Lumo_donor - params.Lumo_acceptor);
-								}
-								else {
-									polaron_event_calc_vars.E_deltas[index] -= (params.Homo_donor - params.Homo_acceptor);
-								}
-							}
-							if (params.Enable_miller_abrahams) {
-								polaron_event_calc_vars.hops_temp[index].calculateRateConstant(params.R_polaron_hopping_acceptor, params.Polaron_localization_acceptor, polaron_event_calc_vars.distances[index], polaron_event_calc_vars.E_deltas[index]);
-							}
-							else {
-								polaron_event_calc_vars.hops_temp[index].calculateRateConstant(params.R_polaron_hopping_acceptor, params.Polaron_localization_acceptor, polaron_event_calc_vars.distances[index], polaron_event_calc_vars.E_deltas[index], params.Reorganization_acceptor);
-							}
+						// Hop events
+						// If destination site is unoccupied and either phase restriction is disabled or the starting site and destination sites have the same type, check for a possible hop event
+						// With the escape rate cache, the hops are replaced by one hop event to a destination sampled from the cached rates
+						if (!params.Enable_escape_rate_cache && occupant == Site_OSC::Empty && (!params.Enable_phase_restriction || getSiteType(object_coords) == getSiteType(dest_coords))) {
+							event_candidates.push_back({ calculatePolaronHopRate(polaron_it, object_coords, dest_coords, index, E_site_i, Coulomb_i, E_margin), index, EventTrace::Polaron_hop });
 						}
-						polaron_event_calc_vars.hops_temp[index].setObjectPtr(polaron_ptr);
-						polaron_event_calc_vars.hops_temp[index].setDestCoords(dest_coords);
-						polaron_event_calc_vars.hops_temp[index].setObjectTargetPtr(nullptr);
-						possible_events.push_back(&polaron_event_calc_vars.hops_temp[index]);
 					}
 				}
 			}
 		}
+		if (params.Enable_escape_rate_cache) {
+			calculatePolaronCachedHopEvent(polaron_it);
+		}
 		// Calculate possible polaron extraction event
 		// Electrons are extracted at the bottom of the lattice (z=-1)
 		// Holes are extracted at the top of the lattice (z=Height)
+		list<Polaron::Extraction>::iterator extraction_event_it;
 		if ((params.Enable_dynamics_test && params.Enable_dynamics_extraction) || (!params.Enable_dynamics_test && !params.Enable_steady_transport_test)) {
 			bool Extraction_valid = false;
-			list<Polaron::Extraction>::iterator extraction_event_it;
 			double distance;
 			// If electron, charge is false
 			if (!polaron_it->getCharge()) {
@@ -813,27 +944,26 @@ namespace Excimontec {
 				else if (getSiteType(object_coords) == (short)2) {
 					extraction_event_it->calculateRateConstant(params.R_polaron_hopping_acceptor, distance, params.Polaron_localization_acceptor, 0);
 				}
-				possible_events.push_back(&(*extraction_event_it));
+				event_candidates.push_back({ extraction_event_it->getRateConstant(), -1, EventTrace::Polaron_extraction });
 			}
 		}
 		// If there are no possible events, set the polaron event ptr to nullptr
-		if (possible_events.size() == 0) {
-			setObjectEvent(polaron_ptr, nullptr);
+		EXCIMONTEC_PROFILE_ITEMS(profiler, Profiler::Calculate_polaron_events, event_candidates.size());
+		if (event_candidates.size() == 0) {
+			setObjectEvent(polaron_ptr, nullptr, 0.0);
 			return;
 		}
 		// Determine the next event
-		Event* event_ptr_target = determinePathway(possible_events);
-		// Check that the execution time is valid
-		if (event_ptr_target->getExecutionTime() < getTime()) {
-			setObjectEvent(polaron_ptr, nullptr);
-			cout << getId() << ": Error! The fastest polaron event execution time is less than the current simulation time." << endl;
-			setErrorMessage(" The fastest polaron event execution time is less than the current simulation time.");
-			Error_found = true;
-			return;
-		}
-		// Copy the chosen temp event to the appropriate main event list and set the target event pointer to the corresponding event from the main list
-		string event_type = event_ptr_target->getEventType();
-		if (event_type.compare(Polaron::Hop::event_type) == 0) {
+		double rate_total;
+		const EventCandidate candidate = event_candidates[chooseEventCandidate(rate_total)];
+		if (candidate.index >= 0) {
+			int dim = polaron_event_calc_vars.dim;
+			int range = polaron_event_calc_vars.range;
+			lattice.calculateDestinationCoords(object_coords, candidate.index / (dim*dim) - range, (candidate.index / dim) % dim - range, candidate.index % dim - range, dest_coords);
+		}
+		// Copy the chosen candidate to the event of the polaron in the appropriate main event list
+		Event* event_ptr_target = nullptr;
+		if (candidate.kind == EventTrace::Polaron_hop) {
 			list<Polaron::Hop>::iterator hop_list_it;
 			// If electron, charge is false
 			if (!polaron_it->getCharge()) {
@@ -845,10 +975,12 @@ namespace Excimontec {
 				hop_list_it = hole_hop_events.begin();
 				std::advance(hop_list_it, std::distance(holes.begin(), polaron_it));
 			}
-			*hop_list_it = *static_cast<Polaron::Hop*>(event_ptr_target);
+			hop_list_it->setObjectPtr(polaron_ptr);
+			hop_list_it->setDestCoords(dest_coords);
+			hop_list_it->setRateConstant(candidate.rate);
 			event_ptr_target = &(*hop_list_it);
 		}
-		else if (event_type.compare(Polaron::Recombination::event_type) == 0) {
+		else if (candidate.kind == EventTrace::Polaron_recombination) {
 			list<Polaron::Recombination>::iterator recombination_list_it;
 			// If electron, charge is false
 			if (!polaron_it->getCharge()) {
@@ -857,17 +989,299 @@ namespace Excimontec {
 			}
 			// If hole, charge is true
 			else {
-				setObjectEvent(polaron_ptr, nullptr);
+				setObjectEvent(polaron_ptr, nullptr, 0.0);
 				cout << getId() << ": Error! Only electrons can initiate polaron recombination." << endl;
 				setErrorMessage("Error calculating polaron events. Only electrons can initiate polaron recombination.");
 				Error_found = true;
 				return;
 			}
-			*recombination_list_it = *static_cast<Polaron::Recombination*>(event_ptr_target);
+			recombination_list_it->setObjectPtr(polaron_ptr);
+			recombination_list_it->setDestCoords(dest_coords);
+			recombination_list_it->setObjectTargetPtr(sites[lattice.getSiteIndex(dest_coords)].getObjectPtr());
+			recombination_list_it->setRateConstant(candidate.rate);
 			event_ptr_target = &(*recombination_list_it);
 		}
-		// Set the chosen event
-		setObjectEvent(polaron_ptr, event_ptr_target);
+		else {
+			event_ptr_target = &(*extraction_event_it);
+		}
+		event_ptr_target->calculateExecutionTime(rate_total);
+		// Check that the execution time is valid
+		if (event_ptr_target->getExecutionTime() < getTime()) {
+			setObjectEvent(polaron_ptr, nullptr, 0.0);
+			cout << getId() << ": Error! The fastest polaron event execution time is less than the current simulation time." << endl;
+			setErrorMessage(" The fastest polaron event execution time is less than the current simulation time.");
+			Error_found = true;
+			return;
+		}
+		// Set the chosen event along with the total rate of all candidate events
+		setObjectEvent(polaron_ptr, event_ptr_target, rate_total);
+	}
+
+	double OSC_Sim::calculatePolaronHopRate(const list<Polaron>::iterator polaron_it, const Coords& coords_start, const Coords& coords_dest, const int index, const double E_site_start, const double Coulomb_start, const double E_margin) {
+		double E_delta = (getSiteEnergy(coords_dest) - E_site_start);
+		// The static hop rates of the escape rate cache neglect the Coulomb interactions, which is valid at low carrier densities
+		if (!params.Enable_escape_rate_cache) {
+			E_delta += (calculateCoulomb(polaron_it, coords_dest) - Coulomb_start);
+		}
+		double E_potential_change = (E_potential[coords_dest.z] - E_potential[coords_start.z]);
+		if (lattice.calculateDZ(coords_start, coords_dest) < 0) {
+			E_potential_change -= params.Internal_potential;
+		}
+		if (lattice.calculateDZ(coords_start, coords_dest) > 0) {
+			E_potential_change += params.Internal_potential;
+		}
+		if (!polaron_it->getCharge()) {
+			E_delta += E_potential_change;
+		}
+		else {
+			E_delta -= E_potential_change;
+		}
+		// The rate constant is the upper bound of the rate for any drift of the energy change by up to E_margin
+		if (getSiteType(coords_start) == (short)1) {
+			if (getSiteType(coords_dest) == (short)2) {
+				if (!polaron_it->getCharge()) {
+					E_delta -= (params.Lumo_acceptor - params.Lumo_donor);
+				}
+				else {
+					E_delta -= (params.Homo_acceptor - params.Homo_donor);
+				}
+			}
+			if (params.Enable_miller_abrahams) {
+				polaron_event_calc_vars.hop_event.calculateRateConstant(params.R_polaron_hopping_donor, params.Polaron_localization_donor, polaron_event_calc_vars.distances[index], E_delta - E_margin);
+			}
+			else {
+				polaron_event_calc_vars.hop_event.calculateRateConstant(params.R_polaron_hopping_donor, params.Polaron_localization_donor, polaron_event_calc_vars.distances[index], min(max(-params.Reorganization_donor, E_delta - E_margin), E_delta + E_margin), params.Reorganization_donor);
+			}
+		}
+		else if (getSiteType(coords_start) == (short)2) {
+			if (getSiteType(coords_dest) == (short)1) {
+				if (!polaron_it->getCharge()) {
+					E_delta -= (params.Lumo_donor - params.Lumo_acceptor);
+				}
+				else {
+					E_delta -= (params.Homo_donor - params.Homo_acceptor);
+				}
+			}
+			if (params.Enable_miller_abrahams) {
+				polaron_event_calc_vars.hop_event.calculateRateConstant(params.R_polaron_hopping_acceptor, params.Polaron_localization_acceptor, polaron_event_calc_vars.distances[index], E_delta - E_margin);
+			}
+			else {
+				polaron_event_calc_vars.hop_event.calculateRateConstant(params.R_polaron_hopping_acceptor, params.Polaron_localization_acceptor, polaron_event_calc_vars.distances[index], min(max(-params.Reorganization_acceptor, E_delta - E_margin), E_delta + E_margin), params.Reorganization_acceptor);
+			}
+		}
+		return polaron_event_calc_vars.hop_event.getRateConstant();
+	}
+
+	bool OSC_Sim::calculatePolaronSuperbasinEvent(const list<Polaron>::iterator polaron_it) {
+		const auto& basin_sites = polaron_it->getBasinSites();
+		const Coords object_coords = polaron_it->getCoords();
+		const int N_sites = (int)basin_sites.size();
+		auto start_it = find(basin_sites.begin(), basin_sites.end(), lattice.getSiteIndex(object_coords));
+		if (start_it == basin_sites.end()) {
+			return false;
+		}
+		const int start_index = (int)distance(basin_sites.begin(), start_it);
+		bool Extraction_possible = ((params.Enable_dynamics_test && params.Enable_dynamics_extraction) || (!params.Enable_dynamics_test && !params.Enable_steady_transport_test));
+		// Calculate the hop rates between the superbasin sites and the hop rates that leave the superbasin
+		vector<double> rates_internal(N_sites*N_sites, 0.0);
+		vector<double> rates_total(N_sites, 0.0);
+		vector<int> exit_sources;
+		vector<Coords> exit_coords;
+		vector<double> exit_rates;
+		Coords dest_coords;
+		int index;
+		for (int n = 0; n < N_sites; n++) {
+			Coords coords_start = lattice.getSiteCoords(basin_sites[n]);
+			// The superbasin is not used when another object occupies one of its sites
+			if (n != start_index && lattice.isOccupied(coords_start)) {
+				return false;
+			}
+			// The superbasin is not used when the polaron could be extracted from one of its sites
+			if (Extraction_possible) {
+				double extraction_distance = !polaron_it->getCharge() ? lattice.getUnitSize()*((double)(coords_start.z + 1) - 0.5) : lattice.getUnitSize()*((double)(lattice.getHeight() - coords_start.z) - 0.5);
+				if (!((extraction_distance - 0.0001) > params.Polaron_hopping_cutoff)) {
+					return false;
+				}
+			}
+			double E_site_start = getSiteEnergy(coords_start);
+			double Coulomb_start = calculateCoulomb(polaron_it, coords_start);
+			for (int i = -polaron_event_calc_vars.range, imax = polaron_event_calc_vars.range; i <= imax; i++) {
+				for (int j = -polaron_event_calc_vars.range, jmax = polaron_event_calc_vars.range; j <= jmax; j++) {
+					for (int k = -polaron_event_calc_vars.range, kmax = polaron_event_calc_vars.range; k <= kmax; k++) {
+						index = (i + polaron_event_calc_vars.range)*polaron_event_calc_vars.dim*polaron_event_calc_vars.dim + (j + polaron_event_calc_vars.range)*polaron_event_calc_vars.dim + (k + polaron_event_calc_vars.range);
+						if (!polaron_event_calc_vars.isInRange[index]) {
+							continue;
+						}
+						if (!lattice.checkMoveValidity(coords_start, i, j, k)) {
+							continue;
+						}
+						lattice.calculateDestinationCoords(coords_start, i, j, k, dest_coords);
+						// The site of the polaron itself is treated as unoccupied
+						const auto occupant = sites[lattice.getSiteIndex(dest_coords)].getOccupant();
+						if (occupant != Site_OSC::Empty && dest_coords != object_coords) {
+							// The superbasin is not used when an electron could recombine with a hole from one of its sites
+							if (!polaron_it->getCharge() && occupant == Site_OSC::Hole) {
+								return false;
+							}
+							continue;
+						}
+						if (params.Enable_phase_restriction && getSiteType(coords_start) != getSiteType(dest_coords)) {
+							continue;
+						}
+						double rate = calculatePolaronHopRate(polaron_it, coords_start, dest_coords, index, E_site_start, Coulomb_start, 0.0);
+						rates_total[n] += rate;
+						auto dest_it = find(basin_sites.begin(), basin_sites.end(), lattice.getSiteIndex(dest_coords));
+						if (dest_it != basin_sites.end()) {
+							rates_internal[n*N_sites + (int)distance(basin_sites.begin(), dest_it)] += rate;
+						}
+						else {
+							exit_sources.push_back(n);
+							exit_coords.push_back(dest_coords);
+							exit_rates.push_back(rate);
+						}
+					}
+				}
+			}
+			if (!(rates_total[n] > 0)) {
+				return false;
+			}
+		}
+		if (exit_rates.empty()) {
+			return false;
+		}
+		// The expected number of visits to each site before the polaron leaves the superbasin are calculated from the absorbing Markov chain
+		// of the hops, which gives the linear system (I - P^T)*visits = e_start, where P is the hop probability matrix between the superbasin sites
+		vector<double> matrix(N_sites*N_sites, 0.0);
+		vector<double> visits(N_sites, 0.0);
+		for (int m = 0; m < N_sites; m++) {
+			for (int n = 0; n < N_sites; n++) {
+				matrix[m*N_sites + n] = ((m == n) ? 1.0 : 0.0) - rates_internal[n*N_sites + m] / rates_total[n];
+			}
+		}
+		visits[start_index] = 1.0;
+		// Solve the linear system by Gaussian elimination with partial pivoting
+		for (int m = 0; m < N_sites; m++) {
+			int pivot = m;
+			for (int n = m + 1; n < N_sites; n++) {
+				if (abs(matrix[n*N_sites + m]) > abs(matrix[pivot*N_sites + m])) {
+					pivot = n;
+				}
+			}
+			if (!(abs(matrix[pivot*N_sites + m]) > 1e-12)) {
+				return false;
+			}
+			if (pivot != m) {
+				for (int n = 0; n < N_sites; n++) {
+					swap(matrix[m*N_sites + n], matrix[pivot*N_sites + n]);
+				}
+				swap(visits[m], visits[pivot]);
+			}
+			for (int n = m + 1; n < N_sites; n++) {
+				double factor = matrix[n*N_sites + m] / matrix[m*N_sites + m];
+				for (int l = m; l < N_sites; l++) {
+					matrix[n*N_sites + l] -= factor * matrix[m*N_sites + l];
+				}
+				visits[n] -= factor * visits[m];
+			}
+		}
+		for (int m = N_sites - 1; m >= 0; m--) {
+			for (int n = m + 1; n < N_sites; n++) {
+				visits[m] -= matrix[m*N_sites + n] * visits[n];
+			}
+			visits[m] /= matrix[m*N_sites + m];
+		}
+		// The mean exit time is the sum of the mean residence times of all visits, and the probability of each exit hop is the expected
+		// number of visits to its starting site multiplied by the hop probability
+		double exit_time = 0.0;
+		for (int n = 0; n < N_sites; n++) {
+			exit_time += visits[n] / rates_total[n];
+		}
+		vector<double> exit_probabilities(exit_rates.size());
+		double probability_sum = 0.0;
+		for (int n = 0; n < (int)exit_rates.size(); n++) {
+			exit_probabilities[n] = visits[exit_sources[n]] * exit_rates[n] / rates_total[exit_sources[n]];
+			probability_sum += exit_probabilities[n];
+		}
+		if (!(exit_time > 0) || !(probability_sum > 0)) {
+			return false;
+		}
+		double random_num = rand01()*probability_sum;
+		int exit_index = (int)exit_rates.size() - 1;
+		for (int n = 0; n < (int)exit_rates.size(); n++) {
+			random_num -= exit_probabilities[n];
+			if (random_num < 0) {
+				exit_index = n;
+				break;
+			}
+		}
+		// Copy the exit event to the hop event of the polaron in the main event list
+		list<Polaron::Hop>::iterator hop_list_it;
+		if (!polaron_it->getCharge()) {
+			hop_list_it = electron_hop_events.begin();
+			std::advance(hop_list_it, std::distance(electrons.begin(), polaron_it));
+		}
+		else {
+			hop_list_it = hole_hop_events.begin();
+			std::advance(hop_list_it, std::distance(holes.begin(), polaron_it));
+		}
+		*hop_list_it = polaron_event_calc_vars.hop_event;
+		hop_list_it->setObjectPtr(&(*polaron_it));
+		hop_list_it->setDestCoords(exit_coords[exit_index]);
+		hop_list_it->setObjectTargetPtr(nullptr);
+		hop_list_it->setRateConstant(1.0 / exit_time);
+		hop_list_it->calculateExecutionTime(1.0 / exit_time);
+		if (isLoggingEnabled()) {
+			*Logfile << (polaron_it->getCharge() ? "Hole " : "Electron ") << polaron_it->getTag() << " is in a superbasin of " << N_sites << " sites with a mean exit time of " << exit_time << " s." << endl;
+		}
+		polaron_it->setBasinActive(true);
+		setObjectEvent(&(*polaron_it), &(*hop_list_it), 1.0 / exit_time);
+		return true;
+	}
+
+	int OSC_Sim::chooseEventCandidate(double& rate_total) {
+		rate_total = 0.0;
+		for (const auto& item : event_candidates) {
+			rate_total += item.rate;
+		}
+		// Choosing a candidate with a probability proportional to its rate and assigning an execution time from the total rate is statistically
+		// equivalent to choosing the candidate with the earliest execution time, so one random number replaces one per candidate
+		double rate_target = rand01()*rate_total;
+		int index_last = (int)event_candidates.size() - 1;
+		for (int n = 0; n < (int)event_candidates.size(); n++) {
+			if (!(event_candidates[n].rate > 0)) {
+				continue;
+			}
+			if (rate_target < event_candidates[n].rate) {
+				return n;
+			}
+			rate_target -= event_candidates[n].rate;
+			index_last = n;
+		}
+		// Round-off error can leave rate_target just above the sum of the remaining rates
+		return index_last;
+	}
+
+	list<Event*>::const_iterator OSC_Sim::chooseNextEvent() {
+		EXCIMONTEC_PROFILE_SCOPE(profiler, Profiler::Choose_next_event);
+		EXCIMONTEC_PROFILE_ITEMS(profiler, Profiler::Choose_next_event, getN_events());
+		int slot;
+		// With the FRM, the event with the earliest execution time is at the top of the event heap
+		if (params.Enable_FRM) {
+			slot = event_heap.getTop();
+		}
+		// With the BKL algorithm, the next event is chosen with a probability proportional to the total rate of its object
+		else {
+			slot = (rate_tree.getTotal() > 0) ? rate_tree.sample(rand01()) : -1;
+		}
+		if (slot < 0 || slot_events[slot] == nullptr) {
+			return Simulation::chooseNextEvent();
+		}
+		chosen_event.front() = slot_events[slot];
+		// The BKL waiting time is drawn from the total rate of all events
+		if (!params.Enable_FRM) {
+			chosen_event.front()->calculateExecutionTime(rate_tree.getTotal());
+		}
+		return chosen_event.cbegin();
 	}
 
 	bool OSC_Sim::checkFinished() const {
@@ -900,6 +1314,138 @@ namespace Excimontec {
 		return true;
 	}
 
+	void OSC_Sim::clearEventSlots() {
+		rate_tree.clear();
+		event_heap.clear();
+		event_slots.clear();
+		slot_events.clear();
+		exciton_creation_slot = -1;
+	}
+
+	void OSC_Sim::clearResults() {
+		// Reset the counters
+		N_excitons_created = 0;
+		N_excitons_created_donor = 0;
+		N_excitons_created_acceptor = 0;
+		N_singlet_excitons_recombined = 0;
+		N_triplet_excitons_recombined = 0;
+		N_singlet_excitons_dissociated = 0;
+		N_triplet_excitons_dissociated = 0;
+		N_singlet_singlet_annihilations = 0;
+		N_singlet_triplet_annihilations = 0;
+		N_triplet_triplet_annihilations = 0;
+		N_singlet_polaron_annihilations = 0;
+		N_triplet_polaron_annihilations = 0;
+		N_exciton_intersystem_crossings = 0;
+		N_exciton_reverse_intersystem_crossings = 0;
+		N_excitons_quenched = 0;
+		N_excitons = 0;
+		N_singlets = 0;
+		N_triplets = 0;
+		N_electrons_created = 0;
+		N_electrons_recombined = 0;
+		N_electrons_collected = 0;
+		N_electrons = 0;
+		N_events_executed = 0;
+		N_holes_created = 0;
+		N_holes_recombined = 0;
+		N_holes_collected = 0;
+		N_holes = 0;
+		N_geminate_recombinations = 0;
+		N_bimolecular_recombinations = 0;
+		N_electron_surface_recombinations = 0;
+		N_hole_surface_recombinations = 0;
+		N_transient_cycles = 0;
+		N_superbasin_exits = 0;
+		N_null_events = 0;
+		previous_event_type = "";
+		previous_event_time = 0;
+		// Reset the steady transport test data
+		Steady_DOS_sampling_counter = 0;
+		Steady_DOOS_sampling_counter = 0;
+		Steady_equilibration_time = 0.0;
+		Steady_equilibration_energy_sum = 0.0;
+		Steady_equilibration_energy_sum_Coulomb = 0.0;
+		Transport_energy_weighted_sum = 0.0;
+		Transport_energy_weighted_sum_Coulomb = 0.0;
+		Transport_energy_sum_of_weights = 0.0;
+		// Clear the results data while keeping the allocated memory
+		DOS_correlation_data.clear();
+		exciton_lifetimes.clear();
+		exciton_diffusion_distances.clear();
+		exciton_hop_distances.clear();
+		transit_times.clear();
+		exciton_lifetime_stats.clear();
+		exciton_diffusion_stats.clear();
+		exciton_hop_distance_stats.clear();
+		transit_time_stats.clear();
+		transit_mobility_stats.clear();
+		transit_time_hist.clear();
+		profiler.clear();
+	}
+
+	bool OSC_Sim::convertEnergiesFile(const string& filename_in, const string& filename_out) {
+		ifstream infile(filename_in, ifstream::in | ifstream::binary);
+		// Check if energies file exists and is accessible
+		if (!infile.good()) {
+			cout << "Error opening site energies file " << filename_in << " for conversion." << endl;
+			return false;
+		}
+		int length = -1;
+		int width = -1;
+		int height = -1;
+		vector<float> energies;
+		string error_msg;
+		bool input_binary = isEnergiesFileBinary(infile);
+		bool success = input_binary ? readEnergiesBinary(infile, length, width, height, energies, error_msg) : readEnergiesText(infile, length, width, height, energies, error_msg);
+		infile.close();
+		if (!success) {
+			cout << "Error converting site energies file " << filename_in << ". " << error_msg << endl;
+			return false;
+		}
+		ofstream outfile(filename_out, input_binary ? ofstream::out : (ofstream::out | ofstream::binary));
+		if (!outfile.good()) {
+			cout << "Error opening site energies file " << filename_out << " for writing the converted data." << endl;
+			return false;
+		}
+		// Binary input is converted to text
+		if (input_binary) {
+			outfile << length << endl;
+			outfile << width << endl;
+			outfile << height << endl;
+			// Nine significant digits are needed to represent any 32-bit float exactly
+			outfile << setprecision(9);
+			for (const auto& energy : energies) {
+				outfile << energy << "\n";
+			}
+		}
+		// Text input is converted to binary
+		else {
+			writeEnergiesBinary(outfile, length, width, height, energies, true);
+		}
+		outfile.close();
+		// An incomplete output file is removed so that it cannot be imported later
+		if (outfile.fail()) {
+			cout << "Error writing the converted site energies file " << filename_out << "." << endl;
+			remove(filename_out.c_str());
+			return false;
+		}
+		return true;
+	}
+
+	void OSC_Sim::createCoulombTable(const Parameters& params, vector<double>& table) {
+		double avg_dielectric = (params.Dielectric_donor + params.Dielectric_acceptor) / 2;
+		double Unit_size = params.Params_lattice.Unit_size;
+		int range = (int)ceil(intpow(params.Coulomb_cutoff / Unit_size, 2));
+		table.assign(range + 1, 0);
+		for (int i = 1, imax = (int)table.size(); i < imax; i++) {
+			table[i] = ((Coulomb_constant*Elementary_charge) / avg_dielectric) / (1e-9*Unit_size*sqrt((double)i));
+			if (params.Enable_gaussian_polaron_delocalization) {
+				table[i] *= erf((Unit_size*sqrt((double)i)) / (params.Polaron_delocalization_length*sqrt(2)));
+			}
+		}
+	}
+
 	void OSC_Sim::createCorrelatedDOS(const double correlation_length) {
 		double stdev, percent_diff;
 		double scale_factor = 1;
@@ -914,10 +1460,7 @@ namespace Excimontec {
 			scale_factor = pow(scale_factor, 2);
 		}
 		// Save original site energies
-		vector<float> original_energies((int)sites.size());
-		for (int n = 0; n < (int)sites.size(); n++) {
-			original_energies[n] = sites[n].getEnergy();
-		}
+		vector<float> original_energies(*site_energies);
 		vector<float> new_energies((int)sites.size());
 		int range = 2;
 		while (1) {
@@ -1004,9 +1547,7 @@ namespace Excimontec {
 				item /= (float)norm_factor;
 			}
 			// Assign new energies to the sites
-			for (int n = 0; n < (int)sites.size(); n++) {
-				sites[n].setEnergy(new_energies[n]);
-			}
+			getWritableSiteEnergies() = new_energies;
 			// Calculate the correlation function
 			calculateDOSCorrelation();
 			// Check if finished
@@ -1016,9 +1557,7 @@ namespace Excimontec {
 			// If not finished
 			else {
 				// Reassign original site energies
-				for (int n = 0; n < (int)sites.size(); n++) {
-					sites[n].setEnergy(original_energies[n]);
-				}
+				getWritableSiteEnergies() = original_energies;
 				// Increment range and repeat the calculation
 				range += 2;
 			}
@@ -1095,6 +1634,28 @@ namespace Excimontec {
 		generateHole(coords, 0);
 	}
 
+	shared_ptr<const OSC_Sim::SharedData> OSC_Sim::createSharedData(const Parameters& params) {
+		auto data = make_shared<SharedData>();
+		createCoulombTable(params, data->Coulomb_table);
+		if (params.Enable_import_energies) {
+			ifstream infile(params.Energies_import_filename, ifstream::in | ifstream::binary);
+			if (infile.good()) {
+				int length = -1;
+				int width = -1;
+				int height = -1;
+				vector<float> energies;
+				string error_msg;
+				bool success = isEnergiesFileBinary(infile) ? readEnergiesBinary(infile, length, width, height, energies, error_msg) : readEnergiesText(infile, length, width, height, energies, error_msg);
+				const auto& lattice_params = params.Params_lattice;
+				if (success && length == lattice_params.Length && width == lattice_params.Width && height == lattice_params.Height) {
+					data->site_energies = move(energies);
+				}
+			}
+			infile.close();
+		}
+		return data;
+	}
+
 	bool OSC_Sim::createImportedMorphology() {
 		string file_info;
 		string line;
@@ -1247,7 +1808,40 @@ namespace Excimontec {
 		return true;
 	}
 
+	void OSC_Sim::deleteAllObjects() {
+		while (!excitons.empty()) {
+			deleteObject(&excitons.front());
+		}
+		while (!electrons.empty()) {
+			deleteObject(&electrons.front());
+		}
+		while (!holes.empty()) {
+			deleteObject(&holes.front());
+		}
+		if (isLightOn) {
+			removeEvent(&exciton_creation_events.front());
+			isLightOn = false;
+			updateExcitonCreationEvent();
+		}
+		exciton_creation_events.clear();
+	}
+
 	void OSC_Sim::deleteObject(Object* object_ptr) {
+		// Return the site to the free site set
+		addFreeSite(lattice.getSiteIndex(object_ptr->getCoords()));
+		sites[lattice.getSiteIndex(object_ptr->getCoords())].setOccupant(Site_OSC::Empty);
+		// Release the event slot of the object
+		auto slot_it = event_slots.find(object_ptr);
+		if (slot_it != event_slots.end()) {
+			if (params.Enable_FRM) {
+				event_heap.removeSlot(slot_it->second);
+			}
+			else {
+				rate_tree.removeSlot(slot_it->second);
+			}
+			slot_events[slot_it->second] = nullptr;
+			event_slots.erase(slot_it);
+		}
 		if (object_ptr->getObjectType().compare(Exciton::object_type) == 0) {
 			auto exciton_it = getExcitonIt(object_ptr);
 			// Remove the object from Simulation
@@ -1336,6 +1930,7 @@ namespace Excimontec {
 		// Calculate next exciton creation event
 		exciton_creation_events.front().calculateRateConstant(R_exciton_generation_donor + R_exciton_generation_acceptor);
 		exciton_creation_events.front().calculateExecutionTime(R_exciton_generation_donor + R_exciton_generation_acceptor);
+		updateExcitonCreationEvent();
 		return true;
 	}
 
@@ -1387,6 +1982,7 @@ namespace Excimontec {
 			// Target triplet exciton becomes a singlet exciton
 			if (rand01() > 0.75) {
 				getExcitonIt((*event_it)->getObjectTargetPtr())->flipSpin();
+				sites[lattice.getSiteIndex(coords_dest)].setOccupant(Site_OSC::Singlet);
 				N_triplets--;
 				N_singlets++;
 			}
@@ -1459,7 +2055,11 @@ namespace Excimontec {
 			}
 			// Log information about the hop when the exciton diffusion test is enabled
 			if (params.Enable_exciton_diffusion_test) {
-				exciton_hop_distances.push_back(lattice.calculateLatticeDistanceSquared(((*event_it)->getObjectPtr())->getCoords(), (*event_it)->getDestCoords()));
+				int distance_sq_lat = lattice.calculateLatticeDistanceSquared(((*event_it)->getObjectPtr())->getCoords(), (*event_it)->getDestCoords());
+				exciton_hop_distance_stats.add(distance_sq_lat);
+				if (params.Enable_raw_data_retention) {
+					exciton_hop_distances.push_back(distance_sq_lat);
+				}
 			}
 			return executeObjectHop(event_it);
 		}
@@ -1473,6 +2073,7 @@ namespace Excimontec {
 		bool spin_i = exciton_it->getSpin();
 		// Execute spin flip
 		exciton_it->flipSpin();
+		sites[lattice.getSiteIndex(coords_initial)].setOccupant(exciton_it->getSpin() ? Site_OSC::Singlet : Site_OSC::Triplet);
 		// Update exciton counters
 		if (spin_i) {
 			N_exciton_intersystem_crossings++;
@@ -1530,6 +2131,7 @@ namespace Excimontec {
 			if (isLightOn && N_excitons_created == params.N_tests) {
 				removeEvent(&exciton_creation_events.front());
 				isLightOn = false;
+				updateExcitonCreationEvent();
 			}
 		}
 		// Perform Transients test analysis
@@ -1576,6 +2178,13 @@ namespace Excimontec {
 		}
 		// Choose the next event
 		auto event_it = chooseNextEvent();
+		// With rate thinning or the escape rate cache, rejected hops are null events that only advance the simulation time before the next event is chosen
+		while ((params.Enable_rate_thinning || params.Enable_escape_rate_cache) && !Error_found && *event_it != nullptr && !((*event_it)->getExecutionTime() < getTime()) && isNullEvent(event_it)) {
+			N_null_events++;
+			setTime((*event_it)->getExecutionTime());
+			calculateObjectListEvents({ (*event_it)->getObjectPtr() });
+			event_it = chooseNextEvent();
+		}
 		// Check for errors
 		if (*event_it == nullptr) {
 			cout << getId() << ": Error! The simulation has no events to execute." << endl;
@@ -1593,41 +2202,80 @@ namespace Excimontec {
 		if (isLoggingEnabled()) {
 			*Logfile << "Event " << N_events_executed << ": Executing " << event_type << " event" << endl;
 		}
+		// Get the event data for the event trace before the event changes the objects
+		EventTrace::Record trace_record;
+		if (Event_trace != nullptr) {
+			trace_record.time = (*event_it)->getExecutionTime();
+			trace_record.rate = (*event_it)->getRateConstant();
+			trace_record.event_number = N_events_executed;
+			trace_record.tag = -1;
+			trace_record.target_tag = -1;
+			trace_record.site_initial = -1;
+			trace_record.site_dest = -1;
+			trace_record.flag = 0;
+			auto object_ptr = (*event_it)->getObjectPtr();
+			if (object_ptr != nullptr) {
+				trace_record.tag = object_ptr->getTag();
+				trace_record.site_initial = (int32_t)lattice.getSiteIndex(object_ptr->getCoords());
+				trace_record.site_dest = (int32_t)lattice.getSiteIndex((*event_it)->getDestCoords());
+				if (object_ptr->getObjectType().compare(Exciton::object_type) == 0) {
+					trace_record.flag = getExcitonIt(object_ptr)->getSpin() ? 1 : 0;
+				}
+				else {
+					trace_record.flag = getPolaronIt(object_ptr)->getCharge() ? 1 : 0;
+				}
+			}
+			if ((*event_it)->getObjectTargetPtr() != nullptr) {
+				trace_record.target_tag = ((*event_it)->getObjectTargetPtr())->getTag();
+			}
+		}
 		previous_event_type = event_type;
 		previous_event_time = getTime();
 		N_events_executed++;
 		// Update simulation time
 		setTime((*event_it)->getExecutionTime());
 		// Execute the chosen event
+		bool success;
+		EventTrace::Kind event_kind;
 		if (event_type.compare(Exciton::Creation::event_type) == 0) {
-			return executeExcitonCreation();
+			event_kind = EventTrace::Exciton_creation;
+			success = executeExcitonCreation();
 		}
 		else if (event_type.compare(Exciton::Hop::event_type) == 0) {
-			return executeExcitonHop(event_it);
+			event_kind = EventTrace::Exciton_hop;
+			success = executeExcitonHop(event_it);
 		}
 		else if (event_type.compare(Exciton::Recombination::event_type) == 0) {
-			return executeExcitonRecombination(event_it);
+			event_kind = EventTrace::Exciton_recombination;
+			success = executeExcitonRecombination(event_it);
 		}
 		else if (event_type.compare(Exciton::Dissociation::event_type) == 0) {
-			return executeExcitonDissociation(event_it);
+			event_kind = EventTrace::Exciton_dissociation;
+			success = executeExcitonDissociation(event_it);
 		}
 		else if (event_type.compare(Exciton::Exciton_Annihilation::event_type) == 0) {
-			return executeExcitonExcitonAnnihilation(event_it);
+			event_kind = EventTrace::Exciton_exciton_annihilation;
+			success = executeExcitonExcitonAnnihilation(event_it);
 		}
 		else if (event_type.compare(Exciton::Polaron_Annihilation::event_type) == 0) {
-			return executeExcitonPolaronAnnihilation(event_it);
+			event_kind = EventTrace::Exciton_polaron_annihilation;
+			success = executeExcitonPolaronAnnihilation(event_it);
 		}
 		else if (event_type.compare(Exciton::Intersystem_Crossing::event_type) == 0) {
-			return executeExcitonIntersystemCrossing(event_it);
+			event_kind = EventTrace::Exciton_intersystem_crossing;
+			success = executeExcitonIntersystemCrossing(event_it);
 		}
 		else if (event_type.compare(Polaron::Hop::event_type) == 0) {
-			return executePolaronHop(event_it);
+			event_kind = EventTrace::Polaron_hop;
+			success = executePolaronHop(event_it);
 		}
 		else if (event_type.compare(Polaron::Recombination::event_type) == 0) {
-			return executePolaronRecombination(event_it);
+			event_kind = EventTrace::Polaron_recombination;
+			success = executePolaronRecombination(event_it);
 		}
 		else if (event_type.compare(Polaron::Extraction::event_type) == 0) {
-			return executePolaronExtraction(event_it);
+			event_kind = EventTrace::Polaron_extraction;
+			success = executePolaronExtraction(event_it);
 		}
 		else {
 			//error
@@ -1636,6 +2284,18 @@ namespace Excimontec {
 			Error_found = true;
 			return false;
 		}
+		EXCIMONTEC_PROFILE_EVENT(profiler, event_kind);
+		if (Event_trace != nullptr) {
+			trace_record.kind = event_kind;
+			// The created exciton is only known after the exciton creation event is executed
+			if (event_kind == EventTrace::Exciton_creation && success) {
+				trace_record.tag = excitons.back().getTag();
+				trace_record.site_dest = (int32_t)lattice.getSiteIndex(excitons.back().getCoords());
+				trace_record.flag = excitons.back().getSpin() ? 1 : 0;
+			}
+			Event_trace->record(trace_record);
+		}
+		return success;
 	}
 
 	bool OSC_Sim::executeObjectHop(const list<Event*>::const_iterator event_it) {
@@ -1645,8 +2305,15 @@ namespace Excimontec {
 		Coords coords_dest = (*event_it)->getDestCoords();
 		// Move the object in the Simulation
 		moveObject((*event_it)->getObjectPtr(), coords_dest);
+		addFreeSite(lattice.getSiteIndex(coords_initial));
+		removeFreeSite(lattice.getSiteIndex(coords_dest));
+		sites[lattice.getSiteIndex(coords_dest)].setOccupant(sites[lattice.getSiteIndex(coords_initial)].getOccupant());
+		sites[lattice.getSiteIndex(coords_initial)].setOccupant(Site_OSC::Empty);
 		// Update event list
 		auto recalc_objects = findRecalcObjects(coords_initial, coords_dest);
+		if (params.Enable_rate_thinning) {
+			applyRateThinning(recalc_objects, object_ptr, coords_initial, coords_dest);
+		}
 		calculateObjectListEvents(recalc_objects);
 		return true;
 	}
@@ -1659,7 +2326,13 @@ namespace Excimontec {
 		Coords coords_initial = ((*event_it)->getObjectPtr())->getCoords();
 		// Save transit time and extraction location info
 		if (params.Enable_ToF_test) {
-			transit_times.push_back(getTime() - ((*event_it)->getObjectPtr())->getCreationTime());
+			double transit_time = getTime() - ((*event_it)->getObjectPtr())->getCreationTime();
+			transit_time_stats.add(transit_time);
+			transit_mobility_stats.add(calculateMobility(transit_time));
+			transit_time_hist.add(log10(transit_time));
+			if (params.Enable_raw_data_retention) {
+				transit_times.push_back(transit_time);
+			}
 		}
 		if (params.Enable_ToF_test || params.Enable_IQE_test) {
 			if (!charge) {
@@ -1695,6 +2368,11 @@ namespace Excimontec {
 	}
 
 	bool OSC_Sim::executePolaronHop(const list<Event*>::const_iterator event_it) {
+		// The exit site of a superbasin can be occupied by an object that moved outside of the event recalculation range, so a new exit event is calculated
+		if (lattice.isOccupied((*event_it)->getDestCoords()) && getPolaronIt((*event_it)->getObjectPtr())->isBasinActive()) {
+			calculatePolaronEvents(static_cast<Polaron*>((*event_it)->getObjectPtr()));
+			return !Error_found;
+		}
 		if (lattice.isOccupied((*event_it)->getDestCoords())) {
 			cout << getId() << ": Error! Polaron hop cannot be executed. Destination site " << (*event_it)->getDestCoords().x << "," << (*event_it)->getDestCoords().y << "," << (*event_it)->getDestCoords().z << " is already occupied." << endl;
 			outputStatus();
@@ -1756,6 +2434,16 @@ namespace Excimontec {
 					Transport_energy_sum_of_weights += displacement;
 				}
 			}
+			// Record the hop in the recently visited sites for superbasin detection, which start over after the polaron leaves a superbasin
+			if (params.Enable_superbasin_acceleration) {
+				if (polaron_it->isBasinActive()) {
+					N_superbasin_exits++;
+					polaron_it->clearBasin();
+				}
+				else {
+					polaron_it->addBasinHop(lattice.getSiteIndex(object_coords), lattice.getSiteIndex(dest_coords), params.Superbasin_max_sites);
+				}
+			}
 			return executeObjectHop(event_it);
 		}
 	}
@@ -1791,6 +2479,125 @@ namespace Excimontec {
 		return true;
 	}
 
+	bool OSC_Sim::exportCheckpoint(const string& filename) {
+		// The checkpoint is written to a temporary file that replaces the checkpoint file only after it is complete
+		string filename_temp = filename + ".tmp";
+		ofstream outfile(filename_temp, ofstream::out | ofstream::binary);
+		auto write_bytes = [&outfile](const void* data, const size_t size) {
+			outfile.write(static_cast<const char*>(data), size);
+		};
+		// Write the file header
+		// The data is written in the native byte order, which is checked with a byte order marker when the checkpoint is imported
+		const uint32_t byte_order_marker = 0x01020304;
+		int id = getId();
+		int dims[3] = { lattice.getLength(), lattice.getWidth(), lattice.getHeight() };
+		outfile.write(Checkpoint_identifier.c_str(), Checkpoint_identifier.size());
+		write_bytes(&Checkpoint_version, sizeof(Checkpoint_version));
+		write_bytes(&byte_order_marker, sizeof(byte_order_marker));
+		write_bytes(&id, sizeof(id));
+		write_bytes(dims, sizeof(dims));
+		// Write the site energies and site types as two blocks
+		vector<float> energies(sites.size());
+		vector<char> types(sites.size());
+		for (int n = 0; n < (int)sites.size(); n++) {
+			energies[n] = (*site_energies)[n];
+			types[n] = (char)sites[n].getType();
+		}
+		write_bytes(energies.data(), energies.size() * sizeof(float));
+		write_bytes(types.data(), types.size());
+		// Write the simulation time, the event counter, and the random number generator state
+		double time = getTime();
+		write_bytes(&time, sizeof(time));
+		write_bytes(&N_events_executed, sizeof(N_events_executed));
+		char light_status = isLightOn ? (char)1 : (char)0;
+		write_bytes(&light_status, sizeof(light_status));
+		stringstream generator_stream;
+		generator_stream << generator;
+		string generator_state = generator_stream.str();
+		uint64_t size = generator_state.size();
+		write_bytes(&size, sizeof(size));
+		write_bytes(generator_state.data(), generator_state.size());
+		size = previous_event_type.size();
+		write_bytes(&size, sizeof(size));
+		write_bytes(previous_event_type.data(), previous_event_type.size());
+		// Write the counters and the test data
+		auto data = getCheckpointData();
+		for (auto item : data.integers) {
+			write_bytes(item, sizeof(int));
+		}
+		for (auto item : data.long_integers) {
+			write_bytes(item, sizeof(long int));
+		}
+		for (auto item : data.doubles) {
+			write_bytes(item, sizeof(double));
+		}
+		for (auto item : data.int_vectors) {
+			size = item->size();
+			write_bytes(&size, sizeof(size));
+			write_bytes(item->data(), item->size() * sizeof(int));
+		}
+		for (auto item : data.double_vectors) {
+			size = item->size();
+			write_bytes(&size, sizeof(size));
+			write_bytes(item->data(), item->size() * sizeof(double));
+		}
+		for (auto item : data.statistics) {
+			item->writeBinary(outfile);
+		}
+		for (auto item : data.histograms) {
+			item->writeBinary(outfile);
+		}
+		// Write all objects in the order that they were added to the simulation, so that events are recalculated in the same order after a restart
+		auto object_ptrs = getAllObjectPtrs();
+		size = object_ptrs.size();
+		write_bytes(&size, sizeof(size));
+		for (auto object_ptr : object_ptrs) {
+			char object_kind;
+			double transient_energy_prev;
+			int transient_z_prev = 0;
+			char spin = 0;
+			if (object_ptr->getObjectType().compare(Exciton::object_type) == 0) {
+				auto exciton_ptr = static_cast<Exciton*>(object_ptr);
+				object_kind = 0;
+				spin = exciton_ptr->getSpin() ? (char)1 : (char)0;
+				transient_energy_prev = exciton_ptr->getTransientEnergyPrev();
+			}
+			else {
+				auto polaron_ptr = static_cast<Polaron*>(object_ptr);
+				object_kind = polaron_ptr->getCharge() ? (char)2 : (char)1;
+				transient_energy_prev = polaron_ptr->getTransientEnergyPrev();
+				transient_z_prev = polaron_ptr->getTransientZPrev();
+			}
+			int tag = object_ptr->getTag();
+			double creation_time = object_ptr->getCreationTime();
+			Coords coords = object_ptr->getCoords();
+			int object_values[5] = { tag, coords.x, coords.y, coords.z, transient_z_prev };
+			int displacement[3] = { (int)lround(object_ptr->calculateDisplacement(1)), (int)lround(object_ptr->calculateDisplacement(2)), (int)lround(object_ptr->calculateDisplacement(3)) };
+			write_bytes(&object_kind, sizeof(object_kind));
+			write_bytes(&spin, sizeof(spin));
+			write_bytes(object_values, sizeof(object_values));
+			write_bytes(displacement, sizeof(displacement));
+			write_bytes(&creation_time, sizeof(creation_time));
+			write_bytes(&transient_energy_prev, sizeof(transient_energy_prev));
+		}
+		outfile.write(Checkpoint_identifier.c_str(), Checkpoint_identifier.size());
+		outfile.close();
+		bool success = !outfile.fail();
+		if (success) {
+#ifdef _WIN32
+			remove(filename.c_str());
+#endif
+			success = (rename(filename_temp.c_str(), filename.c_str()) == 0);
+		}
+		if (!success) {
+			cout << getId() << ": Error! The checkpoint file " << filename << " could not be written." << endl;
+			remove(filename_temp.c_str());
+		}
+		// Continue on the trajectory that a simulation restarted from the checkpoint will follow
+		synchronizeCheckpointState();
+		return success;
+	}
+
 	void OSC_Sim::exportEnergies(std::string filename) {
 		ofstream outfile(filename);
 		outfile << lattice.getLength() << endl;
@@ -1840,6 +2647,30 @@ namespace Excimontec {
 		outfile.close();
 	}
 
+	bool OSC_Sim::exportEnergiesBinary(std::string filename, bool enable_checksum) {
+		ofstream outfile(filename, ofstream::out | ofstream::binary);
+		if (!outfile.good()) {
+			cout << getId() << ": Error opening site energies file " << filename << " for exporting." << endl;
+			return false;
+		}
+		writeEnergiesBinary(outfile, lattice.getLength(), lattice.getWidth(), lattice.getHeight(), *site_energies, enable_checksum);
+		outfile.close();
+		// An incomplete file is removed so that it cannot be imported later
+		if (outfile.fail()) {
+			cout << getId() << ": Error writing site energies file " << filename << "." << endl;
+			remove(filename.c_str());
+			return false;
+		}
+		return true;
+	}
+
+	vector<Object*> OSC_Sim::findRecalcObjects(const Coords& coords_start, const Coords& coords_dest) {
+		EXCIMONTEC_PROFILE_SCOPE(profiler, Profiler::Find_recalc_objects);
+		auto recalc_objects = Simulation::findRecalcObjects(coords_start, coords_dest);
+		EXCIMONTEC_PROFILE_ITEMS(profiler, Profiler::Find_recalc_objects, recalc_objects.size());
+		return recalc_objects;
+	}
+
 	Coords OSC_Sim::generateExciton() {
 		// Determine coords
 		Coords coords = calculateRandomExcitonCreationCoords();
@@ -1856,6 +2687,8 @@ namespace Excimontec {
 		excitons.push_back(exciton_new);
 		Object* object_ptr = &excitons.back();
 		addObject(object_ptr);
+		removeFreeSite(lattice.getSiteIndex(coords));
+		sites[lattice.getSiteIndex(coords)].setOccupant(spin ? Site_OSC::Singlet : Site_OSC::Triplet);
 		// Add placeholder events to the corresponding lists
 		Simulation* sim_ptr = this;
 		Exciton::Hop hop_event(sim_ptr);
@@ -1902,6 +2735,8 @@ namespace Excimontec {
 		electrons.push_back(electron_new);
 		Object* object_ptr = &electrons.back();
 		addObject(object_ptr);
+		removeFreeSite(lattice.getSiteIndex(coords));
+		sites[lattice.getSiteIndex(coords)].setOccupant(Site_OSC::Electron);
 		// Add placeholder events to the corresponding lists
 		Simulation* sim_ptr = this;
 		Polaron::Hop hop_event(sim_ptr);
@@ -1918,11 +2753,6 @@ namespace Excimontec {
 		if (isLoggingEnabled()) {
 			*Logfile << "Created electron " << electron_new.getTag() << " at site " << coords.x << "," << coords.y << "," << coords.z << "." << endl;
 		}
-		// Update transient data
-		if (params.Enable_dynamics_test) {
-			transient_electron_tags.push_back(electrons.back().getTag());
-			transient_electron_energies_prev.push_back(0);
-		}
 	}
 
 	void OSC_Sim::generateHole(const Coords& coords, int tag = 0) {
@@ -1934,6 +2764,8 @@ namespace Excimontec {
 		holes.push_back(hole_new);
 		Object* object_ptr = &holes.back();
 		addObject(object_ptr);
+		removeFreeSite(lattice.getSiteIndex(coords));
+		sites[lattice.getSiteIndex(coords)].setOccupant(Site_OSC::Hole);
 		// Add placeholder events to the corresponding lists
 		Simulation* sim_ptr = this;
 		Polaron::Hop hop_event(sim_ptr);
@@ -1948,11 +2780,6 @@ namespace Excimontec {
 		if (isLoggingEnabled()) {
 			*Logfile << "Created hole " << hole_new.getTag() << " at site " << coords.x << "," << coords.y << "," << coords.z << "." << endl;
 		}
-		// Update transient data
-		if (params.Enable_dynamics_test) {
-			transient_hole_tags.push_back(holes.back().getTag());
-			transient_hole_energies_prev.push_back(0);
-		}
 	}
 
 	void OSC_Sim::generateDynamicsExcitons() {
@@ -1960,13 +2787,6 @@ namespace Excimontec {
 		if (N_excitons_created > 0) {
 			reassignSiteEnergies();
 		}
-		// Initialize transient data vectors
-		transient_exciton_tags.assign(N_initial_excitons, -1);
-		transient_exciton_energies_prev.assign(N_initial_excitons, 0);
-		transient_electron_tags.clear();
-		transient_electron_energies_prev.clear();
-		transient_hole_tags.clear();
-		transient_hole_energies_prev.clear();
 		N_transient_cycles++;
 		int num = 0;
 		if (N_transient_cycles % 10 == 0 || N_transient_cycles == 1) {
@@ -1974,8 +2794,7 @@ namespace Excimontec {
 		}
 		while (num < N_initial_excitons) {
 			generateExciton();
-			transient_exciton_tags[num] = excitons.back().getTag();
-			transient_exciton_energies_prev[num] = getSiteEnergy(excitons.back().getCoords());
+			excitons.back().setTransientEnergyPrev(getSiteEnergy(excitons.back().getCoords()));
 			num++;
 		}
 		Transient_creation_time = getTime();
@@ -2076,25 +2895,19 @@ namespace Excimontec {
 		else {
 			coords.z = 0;
 		}
-		// Initialize transient data vectors
+		// Initialize transient data
 		if (!params.ToF_polaron_type) {
-			transient_electron_tags.assign(params.ToF_initial_polarons, -1);
-			transient_electron_energies_prev.assign(params.ToF_initial_polarons, 0);
 			Transient_electron_counts_prev = params.ToF_initial_polarons;
 		}
 		else {
-			transient_hole_tags.assign(params.ToF_initial_polarons, -1);
-			transient_hole_energies_prev.assign(params.ToF_initial_polarons, 0);
 			Transient_hole_counts_prev = params.ToF_initial_polarons;
 		}
-		ToF_positions_prev.assign(params.ToF_initial_polarons, coords.z);
 		Transient_creation_time = getTime();
 		Transient_index_prev = -1;
 		N_transient_cycles++;
 		if (N_transient_cycles % 10 == 0) {
 			cout << getId() << ": ToF transient cycle " << N_transient_cycles << ": Generating " << params.ToF_initial_polarons << " initial polarons." << endl;
 		}
-		int num = 0;
 		// Determine unique coords for each new polaron
 		vector<Coords> coords_vect(0);
 		// Construct vector of coordinates for all possible sites
@@ -2136,19 +2949,15 @@ namespace Excimontec {
 			coords_vect.resize(params.ToF_initial_polarons);
 		}
 		// Generate the polarons in the selected sites
-		num = 0;
 		for (auto const &item : coords_vect) {
 			if (!params.ToF_polaron_type) {
 				generateElectron(item);
-				transient_electron_tags[num] = electrons.back().getTag();
-				transient_electron_energies_prev[num] = getSiteEnergy(item);
+				electrons.back().setTransientEnergyPrev(getSiteEnergy(item));
 			}
 			else {
 				generateHole(item);
-				transient_hole_tags[num] = holes.back().getTag();
-				transient_hole_energies_prev[num] = getSiteEnergy(item);
+				holes.back().setTransientEnergyPrev(getSiteEnergy(item));
 			}
-			num++;
 		}
 		calculateAllEvents();
 	}
@@ -2205,14 +3014,26 @@ namespace Excimontec {
 		return exciton_diffusion_distances;
 	}
 
+	Statistics OSC_Sim::getExcitonDiffusionStats() const {
+		return exciton_diffusion_stats;
+	}
+
 	vector<int> OSC_Sim::getExcitonHopLengthData() const {
 		return exciton_hop_distances;
 	}
 
+	Statistics OSC_Sim::getExcitonHopLengthStats() const {
+		return exciton_hop_distance_stats;
+	}
+
 	vector<double> OSC_Sim::getExcitonLifetimeData() const {
 		return exciton_lifetimes;
 	}
 
+	Statistics OSC_Sim::getExcitonLifetimeStats() const {
+		return exciton_lifetime_stats;
+	}
+
 	list<Exciton>::iterator OSC_Sim::getExcitonIt(const Object* object_ptr) {
 		auto it = find_if(excitons.begin(), excitons.end(), [object_ptr](Exciton& a) {return (a.getTag() == object_ptr->getTag()); });
 		if (it == excitons.end()) {
@@ -2312,6 +3133,14 @@ namespace Excimontec {
 		return N_holes_recombined;
 	}
 
+	long int OSC_Sim::getN_superbasin_exits() const {
+		return N_superbasin_exits;
+	}
+
+	long int OSC_Sim::getN_null_events() const {
+		return N_null_events;
+	}
+
 	int OSC_Sim::getN_transient_cycles() const {
 		return N_transient_cycles;
 	}
@@ -2345,6 +3174,22 @@ namespace Excimontec {
 		return it;
 	}
 
+	vector<float>& OSC_Sim::getWritableSiteEnergies() {
+		// Site energies that are shared with the other replicas are copied before they are modified
+		if (!site_energies) {
+			site_energies = make_shared<vector<float>>(sites.size(), 0.0f);
+		}
+		else if (site_energies.use_count() > 1) {
+			site_energies = make_shared<vector<float>>(*site_energies);
+		}
+		// The site energies vector is always created as a non-const object, so the const qualifier can be removed
+		return const_cast<vector<float>&>(*site_energies);
+	}
+
+	const Profiler& OSC_Sim::getProfiler() const {
+		return profiler;
+	}
+
 	std::string OSC_Sim::getPreviousEventType() const {
 		return previous_event_type;
 	}
@@ -2353,7 +3198,7 @@ namespace Excimontec {
 		vector<float> energies;
 		for (int i = 0; i < lattice.getNumSites(); i++) {
 			if (sites[i].getType() == site_type) {
-				energies.push_back(sites[i].getEnergy());
+				energies.push_back((*site_energies)[i]);
 			}
 		}
 		return energies;
@@ -2362,7 +3207,7 @@ namespace Excimontec {
 	float OSC_Sim::getSiteEnergy(const Coords& coords) {
 		// Check that coords are valid
 		try {
-			return sites[lattice.getSiteIndex(coords)].getEnergy();
+			return (*site_energies)[lattice.getSiteIndex(coords)];
 		}
 		catch (out_of_range exception) {
 			cout << "Error! Site energy cannot be retrieved because the input coordinates are invalid." << endl;
@@ -2416,6 +3261,29 @@ namespace Excimontec {
 		return output_data;
 	}
 
+	OSC_Sim::CheckpointData OSC_Sim::getCheckpointData() {
+		CheckpointData data;
+		data.integers = { &params.N_tests, &Transient_index_prev, &Transient_singlet_counts_prev, &Transient_triplet_counts_prev, &Transient_electron_counts_prev,
+			&Transient_hole_counts_prev, &N_initial_excitons, &Steady_DOS_sampling_counter, &Steady_DOOS_sampling_counter, &N_donor_sites, &N_acceptor_sites,
+			&N_excitons_created, &N_excitons_created_donor, &N_excitons_created_acceptor, &N_singlet_excitons_recombined, &N_triplet_excitons_recombined,
+			&N_singlet_excitons_dissociated, &N_triplet_excitons_dissociated, &N_singlet_singlet_annihilations, &N_singlet_triplet_annihilations,
+			&N_triplet_triplet_annihilations, &N_singlet_polaron_annihilations, &N_triplet_polaron_annihilations, &N_exciton_intersystem_crossings,
+			&N_exciton_reverse_intersystem_crossings, &N_excitons_quenched, &N_excitons, &N_singlets, &N_triplets, &N_electrons_created, &N_electrons_recombined,
+			&N_electrons_collected, &N_electrons, &N_holes_created, &N_holes_recombined, &N_holes_collected, &N_holes, &N_geminate_recombinations,
+			&N_bimolecular_recombinations, &N_electron_surface_recombinations, &N_hole_surface_recombinations, &N_transient_cycles };
+		data.long_integers = { &N_superbasin_exits, &N_null_events };
+		data.doubles = { &R_exciton_generation_donor, &R_exciton_generation_acceptor, &Transient_creation_time, &previous_event_time, &Steady_equilibration_time,
+			&Steady_equilibration_energy_sum, &Steady_equilibration_energy_sum_Coulomb, &Transport_energy_weighted_sum, &Transport_energy_weighted_sum_Coulomb,
+			&Transport_energy_sum_of_weights };
+		data.int_vectors = { &exciton_hop_distances, &electron_extraction_data, &hole_extraction_data, &transient_singlet_counts, &transient_triplet_counts,
+			&transient_electron_counts, &transient_hole_counts };
+		data.double_vectors = { &exciton_lifetimes, &exciton_diffusion_distances, &transient_exciton_msdv, &transient_electron_msdv, &transient_hole_msdv,
+			&transient_times, &transient_velocities, &transient_exciton_energies, &transient_electron_energies, &transient_hole_energies, &transit_times };
+		data.statistics = { &exciton_lifetime_stats, &exciton_diffusion_stats, &exciton_hop_distance_stats, &transit_time_stats, &transit_mobility_stats };
+		data.histograms = { &transit_time_hist, &steady_DOOS, &steady_DOOS_Coulomb, &steady_DOS, &steady_DOS_Coulomb };
+		return data;
+	}
+
 	double OSC_Sim::getSteadyCurrentDensity() const {
 		double average_displacement = 0.0;
 		for (auto const &item : holes) {
@@ -2426,7 +3294,7 @@ namespace Excimontec {
 	}
 
 	vector<std::pair<double, double>> OSC_Sim::getSteadyDOOS() const {
-		auto hist = steady_DOOS;
+		auto hist = steady_DOOS.getData();
 		// Normalize histogram counts to produce density
 		for (auto& item : hist) {
 			item.second /= Steady_DOOS_sampling_counter * lattice.getVolume()*DOS_bin_size;
@@ -2435,7 +3303,7 @@ namespace Excimontec {
 	}
 
 	vector<std::pair<double, double>> OSC_Sim::getSteadyDOOS_Coulomb() const {
-		auto hist = steady_DOOS_Coulomb;
+		auto hist = steady_DOOS_Coulomb.getData();
 		// Normalize histogram counts to produce density
 		for (auto& item : hist) {
 			item.second /= Steady_DOOS_sampling_counter * lattice.getVolume()*DOS_bin_size;
@@ -2464,9 +3332,9 @@ namespace Excimontec {
 					energy = params.Homo_acceptor + getSiteEnergy(site_coords);
 				}
 			}
-			updateSteadyDOS(steady_DOS, energy);
+			steady_DOS.add(energy);
 		}
-		auto hist = steady_DOS;
+		auto hist = steady_DOS.getData();
 		// Normalize histogram counts to produce density
 		for (auto& item : hist) {
 			item.second /= lattice.getVolume()*DOS_bin_size;
@@ -2475,7 +3343,7 @@ namespace Excimontec {
 	}
 
 	vector<std::pair<double, double>> OSC_Sim::getSteadyDOS_Coulomb() const {
-		auto hist = steady_DOS_Coulomb;
+		auto hist = steady_DOS_Coulomb.getData();
 		// Normalize histogram counts to produce density
 		for (auto& item : hist) {
 			item.second /= Steady_DOS_sampling_counter * lattice.getVolume()*DOS_bin_size;
@@ -2483,6 +3351,10 @@ namespace Excimontec {
 		return hist;
 	}
 
+	double OSC_Sim::getSteadyDOSOutOfRangeCount() const {
+		return steady_DOOS.getOutOfRangeCount() + steady_DOOS_Coulomb.getOutOfRangeCount() + steady_DOS.getOutOfRangeCount() + steady_DOS_Coulomb.getOutOfRangeCount();
+	}
+
 	double OSC_Sim::getSteadyEquilibrationEnergy() const {
 		if ((int)holes.size() > 0) {
 			return Steady_equilibration_energy_sum / (double)(holes.size()*((params.N_tests / Steady_hops_per_DOOS_sample) + 1));
@@ -2523,95 +3395,606 @@ namespace Excimontec {
 		if (abs(Transport_energy_sum_of_weights) > 0) {
 			return (Transport_energy_weighted_sum_Coulomb / Transport_energy_sum_of_weights);
 		}
-		else {
-			return NAN;
+		else {
+			return NAN;
+		}
+	}
+
+	vector<int> OSC_Sim::getToFTransientCounts() const {
+		if (!params.ToF_polaron_type) {
+			return transient_electron_counts;
+		}
+		else {
+			return transient_hole_counts;
+		}
+	}
+
+	vector<double> OSC_Sim::getToFTransientEnergies() const {
+		if (!params.ToF_polaron_type) {
+			return transient_electron_energies;
+		}
+		else {
+			return transient_hole_energies;
+		}
+	}
+
+	vector<double> OSC_Sim::getToFTransientTimes() const {
+		return transient_times;
+	}
+
+	vector<double> OSC_Sim::getToFTransientVelocities() const {
+		return transient_velocities;
+	}
+
+	vector<double> OSC_Sim::getTransitTimeData() const {
+		return transit_times;
+	}
+
+	Histogram OSC_Sim::getTransitTimeHistogram() const {
+		return transit_time_hist;
+	}
+
+	Statistics OSC_Sim::getTransitMobilityStats() const {
+		return transit_mobility_stats;
+	}
+
+	Statistics OSC_Sim::getTransitTimeStats() const {
+		return transit_time_stats;
+	}
+
+	bool OSC_Sim::importCheckpoint(const Parameters& params_in, const int id, const string& filename) {
+		ifstream infile(filename, ifstream::in | ifstream::binary);
+		if (!infile.good()) {
+			cout << id << ": Error! The checkpoint file " << filename << " could not be opened." << endl;
+			setErrorMessage("The checkpoint file " + filename + " could not be opened.");
+			Error_found = true;
+			return false;
+		}
+		// The simulation is first initialized with the input parameters, and then all objects are replaced by the checkpointed objects
+		if (!init(params_in, id)) {
+			return false;
+		}
+		deleteAllObjects();
+		auto read_bytes = [&infile](void* data, const size_t size) {
+			return (bool)infile.read(static_cast<char*>(data), size);
+		};
+		auto read_string = [&infile, &read_bytes](string& value) {
+			uint64_t size;
+			if (!read_bytes(&size, sizeof(size)) || size > 1000000) {
+				return false;
+			}
+			value.assign((size_t)size, ' ');
+			return (size == 0 || read_bytes(&value[0], (size_t)size));
+		};
+		auto checkpointError = [this, &filename](const string& msg) {
+			cout << getId() << ": Error! The checkpoint file " << filename << " " << msg << endl;
+			setErrorMessage("The checkpoint file " + filename + " " + msg);
+			Error_found = true;
+			return false;
+		};
+		// Read and check the file header
+		string identifier(Checkpoint_identifier.size(), ' ');
+		uint32_t version = 0;
+		uint32_t byte_order_marker = 0;
+		int checkpoint_id = -1;
+		int dims[3] = { 0, 0, 0 };
+		if (!read_bytes(&identifier[0], identifier.size()) || identifier.compare(Checkpoint_identifier) != 0 || !read_bytes(&version, sizeof(version))
+			|| !read_bytes(&byte_order_marker, sizeof(byte_order_marker)) || !read_bytes(&checkpoint_id, sizeof(checkpoint_id)) || !read_bytes(dims, sizeof(dims))) {
+			return checkpointError("does not have a valid header.");
+		}
+		if (version != Checkpoint_version || byte_order_marker != 0x01020304) {
+			return checkpointError("was created with an unsupported format version or byte order.");
+		}
+		if (checkpoint_id != id) {
+			return checkpointError("was created by a simulation with a different ID.");
+		}
+		if (dims[0] != lattice.getLength() || dims[1] != lattice.getWidth() || dims[2] != lattice.getHeight()) {
+			return checkpointError("was created with different lattice dimensions.");
+		}
+		// Read the site energies and site types
+		vector<float> energies(sites.size());
+		vector<char> types(sites.size());
+		if (!read_bytes(energies.data(), energies.size() * sizeof(float)) || !read_bytes(types.data(), types.size())) {
+			return checkpointError("does not contain the site data.");
+		}
+		for (int n = 0; n < (int)sites.size(); n++) {
+			sites[n].setType((short)types[n]);
+		}
+		// Site energies that match the shared imported site energies remain shared with the other replicas
+		if (shared_data && shared_data->site_energies == energies) {
+			site_energies = shared_ptr<const vector<float>>(shared_data, &shared_data->site_energies);
+		}
+		else {
+			site_energies = make_shared<vector<float>>(move(energies));
+		}
+		// The escape rates cached during initialization were calculated from the initial site energies
+		escape_rate_cache.clear();
+		// Read the simulation time, the event counter, and the random number generator state
+		double time;
+		char light_status;
+		string generator_state;
+		if (!read_bytes(&time, sizeof(time)) || !read_bytes(&N_events_executed, sizeof(N_events_executed)) || !read_bytes(&light_status, sizeof(light_status))
+			|| !read_string(generator_state) || !read_string(previous_event_type)) {
+			return checkpointError("does not contain the simulation status.");
+		}
+		stringstream generator_stream(generator_state);
+		generator_stream >> generator;
+		if (generator_stream.fail()) {
+			return checkpointError("does not contain a valid random number generator state.");
+		}
+		// Read the counters and the test data
+		auto data = getCheckpointData();
+		for (auto item : data.integers) {
+			if (!read_bytes(item, sizeof(int))) {
+				return checkpointError("does not contain all of the counters.");
+			}
+		}
+		for (auto item : data.long_integers) {
+			if (!read_bytes(item, sizeof(long int))) {
+				return checkpointError("does not contain all of the counters.");
+			}
+		}
+		for (auto item : data.doubles) {
+			if (!read_bytes(item, sizeof(double))) {
+				return checkpointError("does not contain all of the counters.");
+			}
+		}
+		for (auto item : data.int_vectors) {
+			uint64_t size;
+			if (!read_bytes(&size, sizeof(size)) || size > (uint64_t)INT_MAX) {
+				return checkpointError("does not contain all of the test data.");
+			}
+			item->assign((size_t)size, 0);
+			if (!read_bytes(item->data(), item->size() * sizeof(int))) {
+				return checkpointError("does not contain all of the test data.");
+			}
+		}
+		for (auto item : data.double_vectors) {
+			uint64_t size;
+			if (!read_bytes(&size, sizeof(size)) || size > (uint64_t)INT_MAX) {
+				return checkpointError("does not contain all of the test data.");
+			}
+			item->assign((size_t)size, 0.0);
+			if (!read_bytes(item->data(), item->size() * sizeof(double))) {
+				return checkpointError("does not contain all of the test data.");
+			}
+		}
+		for (auto item : data.statistics) {
+			if (!item->readBinary(infile)) {
+				return checkpointError("does not contain all of the test data.");
+			}
+		}
+		for (auto item : data.histograms) {
+			if (!item->readBinary(infile)) {
+				return checkpointError("does not contain all of the test data.");
+			}
+		}
+		// Recreate all objects in their original order
+		// The object counters are restored after the objects are created, because creating an object increments the counters
+		auto counters = data.integers;
+		vector<int> counter_values(counters.size());
+		for (int i = 0; i < (int)counters.size(); i++) {
+			counter_values[i] = *counters[i];
+		}
+		uint64_t N_objects;
+		if (!read_bytes(&N_objects, sizeof(N_objects)) || N_objects > sites.size()) {
+			return checkpointError("does not contain a valid number of objects.");
+		}
+		for (uint64_t i = 0; i < N_objects; i++) {
+			char object_kind;
+			char spin;
+			int object_values[5];
+			int displacement[3];
+			double creation_time;
+			double transient_energy_prev;
+			if (!read_bytes(&object_kind, sizeof(object_kind)) || !read_bytes(&spin, sizeof(spin)) || !read_bytes(object_values, sizeof(object_values))
+				|| !read_bytes(displacement, sizeof(displacement)) || !read_bytes(&creation_time, sizeof(creation_time)) || !read_bytes(&transient_energy_prev, sizeof(transient_energy_prev))) {
+				return checkpointError("does not contain all of the objects.");
+			}
+			Coords coords(object_values[1], object_values[2], object_values[3]);
+			try {
+				lattice.getSiteIndex(coords);
+			}
+			catch (out_of_range&) {
+				return checkpointError("contains an object with invalid coordinates.");
+			}
+			if (lattice.isOccupied(coords)) {
+				return checkpointError("contains an object with invalid coordinates.");
+			}
+			// Objects are created at their original creation time
+			setTime(creation_time);
+			Object* object_ptr;
+			if (object_kind == 0) {
+				generateExciton(coords, spin == (char)1, object_values[0]);
+				excitons.back().setTransientEnergyPrev(transient_energy_prev);
+				object_ptr = &excitons.back();
+			}
+			else if (object_kind == 1) {
+				generateElectron(coords, object_values[0]);
+				electrons.back().setTransientEnergyPrev(transient_energy_prev);
+				electrons.back().setTransientZPrev(object_values[4]);
+				object_ptr = &electrons.back();
+			}
+			else {
+				generateHole(coords, object_values[0]);
+				holes.back().setTransientEnergyPrev(transient_energy_prev);
+				holes.back().setTransientZPrev(object_values[4]);
+				object_ptr = &holes.back();
+			}
+			object_ptr->incrementDX(displacement[0]);
+			object_ptr->incrementDY(displacement[1]);
+			object_ptr->incrementDZ(displacement[2]);
+		}
+		identifier.assign(Checkpoint_identifier.size(), ' ');
+		if (!read_bytes(&identifier[0], identifier.size()) || identifier.compare(Checkpoint_identifier) != 0) {
+			return checkpointError("is incomplete.");
+		}
+		for (int i = 0; i < (int)counters.size(); i++) {
+			*counters[i] = counter_values[i];
+		}
+		setTime(time);
+		// Restart exciton creation
+		if (light_status == (char)1) {
+			isLightOn = true;
+			Exciton::Creation exciton_creation_event(this);
+			exciton_creation_event.calculateRateConstant(R_exciton_generation_donor + R_exciton_generation_acceptor);
+			exciton_creation_events.assign(1, exciton_creation_event);
+			exciton_creation_it = addEvent(&exciton_creation_events.front());
+			updateExcitonCreationEvent();
+		}
+		// Recalculate all events in the same way as the checkpointed simulation did after the checkpoint was written
+		synchronizeCheckpointState();
+		return !Error_found;
+	}
+
+	bool OSC_Sim::initializeArchitecture() {
+		bool success;
+		N_donor_sites = 0;
+		N_acceptor_sites = 0;
+		if (params.Enable_neat) {
+			N_donor_sites = lattice.getNumSites();
+			N_acceptor_sites = 0;
+			for (auto &item : sites) {
+				item.setType(1);
+			}
+		}
+		else if (params.Enable_bilayer) {
+			Coords coords;
+			for (int x = 0; x < lattice.getLength(); x++) {
+				for (int y = 0; y < lattice.getWidth(); y++) {
+					for (int z = 0; z < lattice.getHeight(); z++) {
+						coords.setXYZ(x, y, z);
+						if (z < params.Thickness_acceptor) {
+							sites[lattice.getSiteIndex(coords)].setType(2);
+							N_acceptor_sites++;
+						}
+						else {
+							sites[lattice.getSiteIndex(coords)].setType(1);
+							N_donor_sites++;
+						}
+					}
+				}
+			}
+		}
+		else if (params.Enable_random_blend) {
+			vector<short> site_types;
+			site_types.assign(lattice.getNumSites(), 1);
+			for (int i = 0; i < (int)lattice.getNumSites()*params.Acceptor_conc; i++) {
+				site_types[i] = 2;
+				N_acceptor_sites++;
+			}
+			N_donor_sites = lattice.getNumSites() - N_acceptor_sites;
+			shuffle(site_types.begin(), site_types.end(), generator);
+			for (int i = 0; i < (int)sites.size(); i++) {
+				sites[i].setType(site_types[i]);
+			}
+		}
+		else if (params.Enable_import_morphology) {
+			success = createImportedMorphology();
+			if (!success) {
+				return false;
+			}
+		}
+		// Send the site pointers to the Lattice object
+		vector<Site*> site_ptrs((int)sites.size());
+		for (int i = 0; i < (int)sites.size(); i++) {
+			site_ptrs[i] = &sites[i];
+		}
+		lattice.setSitePointers(site_ptrs);
+		return true;
+	}
+
+	bool OSC_Sim::isEnergiesFileBinary(ifstream& infile) {
+		string identifier(Energies_binary_identifier.size(), ' ');
+		infile.read(&identifier[0], identifier.size());
+		bool is_binary = (infile.gcount() == (streamsize)identifier.size() && identifier.compare(Energies_binary_identifier) == 0);
+		// Return to the beginning of the file
+		infile.clear();
+		infile.seekg(0);
+		return is_binary;
+	}
+
+	bool OSC_Sim::isNullEvent(const list<Event*>::const_iterator event_it) {
+		// With the escape rate cache, exciton and polaron hops are rejected when the sampled destination is occupied
+		if (params.Enable_escape_rate_cache) {
+			bool is_exciton_hop = ((*event_it)->getEventType().compare(Exciton::Hop::event_type) == 0);
+			if (!is_exciton_hop && (*event_it)->getEventType().compare(Polaron::Hop::event_type) != 0) {
+				return false;
+			}
+			string object_name = "Exciton ";
+			if (!is_exciton_hop) {
+				auto polaron_it = getPolaronIt((*event_it)->getObjectPtr());
+				if (polaron_it->isBasinActive()) {
+					return false;
+				}
+				object_name = polaron_it->getCharge() ? "Hole " : "Electron ";
+			}
+			const Coords dest_coords = (*event_it)->getDestCoords();
+			if (!lattice.isOccupied(dest_coords)) {
+				return false;
+			}
+			if (isLoggingEnabled()) {
+				*Logfile << object_name << (*event_it)->getObjectPtr()->getTag() << " hop to occupied site " << dest_coords.x << "," << dest_coords.y << "," << dest_coords.z << " was rejected as a null event." << endl;
+			}
+			return true;
+		}
+		// Only the polaron hop events have upper bound rates, except for the superbasin exit events
+		if ((*event_it)->getEventType().compare(Polaron::Hop::event_type) != 0) {
+			return false;
+		}
+		auto polaron_it = getPolaronIt((*event_it)->getObjectPtr());
+		if (polaron_it->isBasinActive()) {
+			return false;
+		}
+		// Calculate the current rate of the hop
+		const Coords object_coords = polaron_it->getCoords();
+		const Coords dest_coords = (*event_it)->getDestCoords();
+		int i = dest_coords.x - object_coords.x + lattice.calculateDX(object_coords, dest_coords);
+		int j = dest_coords.y - object_coords.y + lattice.calculateDY(object_coords, dest_coords);
+		int k = dest_coords.z - object_coords.z + lattice.calculateDZ(object_coords, dest_coords);
+		int index = (i + polaron_event_calc_vars.range)*polaron_event_calc_vars.dim*polaron_event_calc_vars.dim + (j + polaron_event_calc_vars.range)*polaron_event_calc_vars.dim + (k + polaron_event_calc_vars.range);
+		double rate = calculatePolaronHopRate(polaron_it, object_coords, dest_coords, index, getSiteEnergy(object_coords), calculateCoulomb(polaron_it, object_coords), 0.0);
+		// The hop is accepted with the ratio of the current rate to the upper bound rate
+		if (rand01()*(*event_it)->getRateConstant() < rate) {
+			return false;
+		}
+		if (isLoggingEnabled()) {
+			*Logfile << (polaron_it->getCharge() ? "Hole " : "Electron ") << polaron_it->getTag() << " hop to site " << dest_coords.x << "," << dest_coords.y << "," << dest_coords.z << " was rejected as a null event." << endl;
+		}
+		return true;
+	}
+
+	void OSC_Sim::initializeFreeSites() {
+		free_sites_donor.clear();
+		free_sites_acceptor.clear();
+		free_site_positions.assign(sites.size(), -1);
+		for (long int n = 0; n < (long int)sites.size(); n++) {
+			if (!sites[n].isOccupied() && (sites[n].getType() == (short)1 || sites[n].getType() == (short)2)) {
+				addFreeSite(n);
+			}
+		}
+	}
+
+	void OSC_Sim::initializeSteadyDOS() {
+		// Determine the width of the site energy distribution from the disorder model
+		double disorder_width = 0.0;
+		if (params.Enable_gaussian_dos) {
+			disorder_width = 10.0*max(params.Energy_stdev_donor, params.Energy_stdev_acceptor);
+		}
+		else if (params.Enable_exponential_dos) {
+			disorder_width = 30.0*max(params.Energy_urbach_donor, params.Energy_urbach_acceptor);
+		}
+		// The interfacial energy shift is largest when all first, second, and third nearest neighbor sites have the other site type
+		if (params.Enable_interfacial_energy_shift) {
+			disorder_width += (6.0 + 12.0 / sqrt(2.0) + 8.0 / sqrt(3.0))*max(abs(params.Energy_shift_donor), abs(params.Energy_shift_acceptor));
+		}
+		// The range is derived from the parameters so that all processors create the same histogram bins, except for imported site energies,
+		// which replace all other site energies and are read from the same file by all processors
+		if (params.Enable_import_energies) {
+			disorder_width = 0.0;
+			for (auto const &energy : *site_energies) {
+				disorder_width = max(disorder_width, (double)abs(energy));
+			}
+		}
+		// The histogram range spans the HOMO levels, the disorder width, and padding for the Coulomb potential with bin centers at integer multiples of the bin size
+		double min_val = floor((min(params.Homo_donor, params.Homo_acceptor) - disorder_width - DOS_range_padding) / DOS_bin_size)*DOS_bin_size;
+		double max_val = ceil((max(params.Homo_donor, params.Homo_acceptor) + disorder_width + DOS_range_padding) / DOS_bin_size)*DOS_bin_size;
+		steady_DOOS = Histogram(min_val, max_val, DOS_bin_size);
+		steady_DOOS_Coulomb = steady_DOOS;
+		steady_DOS = steady_DOOS;
+		steady_DOS_Coulomb = steady_DOOS;
+	}
+
+	bool OSC_Sim::initializeTest() {
+		// Initialize derived parameters
+		if (params.Enable_ToF_test) {
+			Transient_start = params.ToF_transient_start;
+			Transient_end = params.ToF_transient_end;
+			Transient_pnts_per_decade = params.ToF_pnts_per_decade;
+		}
+		if (params.Enable_dynamics_test) {
+			Transient_start = params.Dynamics_transient_start;
+			Transient_end = params.Dynamics_transient_end;
+			Transient_pnts_per_decade = params.Dynamics_pnts_per_decade;
+		}
+		// Initialize the free site sets used for exciton creation
+		initializeFreeSites();
+		// Assign energies to each site in the sites vector
+		reassignSiteEnergies();
+		// Initialize Coulomb interactions lookup table
+		AvgDielectric = (params.Dielectric_donor + params.Dielectric_acceptor) / 2;
+		Image_interaction_prefactor = (Elementary_charge / (16 * Pi*AvgDielectric*Vacuum_permittivity))*1e9;
+		if (shared_data) {
+			Coulomb_table = shared_ptr<const vector<double>>(shared_data, &shared_data->Coulomb_table);
+		}
+		else {
+			auto table = make_shared<vector<double>>();
+			createCoulombTable(params, *table);
+			Coulomb_table = table;
+		}
+		Coulomb_range = (int)ceil((params.Coulomb_cutoff / lattice.getUnitSize())*(params.Coulomb_cutoff / lattice.getUnitSize()));
+		// Initialize electrical potential vector
+		E_potential.assign(lattice.getHeight(), 0);
+		for (int i = 0; i < lattice.getHeight(); i++) {
+			E_potential[i] = (params.Internal_potential*lattice.getHeight() / (lattice.getHeight() + 1)) - (params.Internal_potential / (lattice.getHeight() + 1))*i;
+		}
+		// Initialize event calculation data
+		exciton_event_calc_vars = ExcitonEventCalcVars(this);
+		polaron_event_calc_vars = PolaronEventCalcVars(this);
+		// Initialize exciton creation event
+		R_exciton_generation_donor = ((params.Exciton_generation_rate_donor*N_donor_sites*1e-7*lattice.getUnitSize())*1e-7*lattice.getUnitSize())*1e-7*lattice.getUnitSize();
+		R_exciton_generation_acceptor = ((params.Exciton_generation_rate_acceptor*N_acceptor_sites*1e-7*lattice.getUnitSize())*1e-7*lattice.getUnitSize())*1e-7*lattice.getUnitSize();
+		if (params.Enable_exciton_diffusion_test || params.Enable_IQE_test) {
+			isLightOn = true;
+			Exciton::Creation exciton_creation_event(this);
+			exciton_creation_event.calculateRateConstant(R_exciton_generation_donor + R_exciton_generation_acceptor);
+			exciton_creation_event.calculateExecutionTime(R_exciton_generation_donor + R_exciton_generation_acceptor);
+			exciton_creation_events.assign(1, exciton_creation_event);
+			exciton_creation_it = addEvent(&exciton_creation_events.front());
+			updateExcitonCreationEvent();
+		}
+		else if (params.Enable_dynamics_test) {
+			isLightOn = false;
+			// Initialize parameters
+			N_initial_excitons = (int)ceil(params.Dynamics_initial_exciton_conc*lattice.getVolume());
+			// Initialize data structures
+			Transient_step_size = 1.0 / (double)Transient_pnts_per_decade;
+			int num_steps = (int)floor((log10(Transient_end) - log10(Transient_start)) / Transient_step_size) + 1;
+			transient_times.assign(num_steps, 0);
+			for (int i = 0; i < (int)transient_times.size(); i++) {
+				transient_times[i] = pow(10, log10(Transient_start) + i * Transient_step_size);
+			}
+			transient_singlet_counts.assign(num_steps, 0);
+			transient_triplet_counts.assign(num_steps, 0);
+			transient_electron_counts.assign(num_steps, 0);
+			transient_hole_counts.assign(num_steps, 0);
+			transient_exciton_msdv.assign(num_steps, 0);
+			transient_electron_msdv.assign(num_steps, 0);
+			transient_hole_msdv.assign(num_steps, 0);
+			transient_exciton_energies.assign(num_steps, 0);
+			transient_electron_energies.assign(num_steps, 0);
+			transient_hole_energies.assign(num_steps, 0);
+			// Create initial test excitons
+			generateDynamicsExcitons();
+		}
+		else if (params.Enable_ToF_test) {
+			isLightOn = false;
+			// Initialize data structures
+			Transient_step_size = 1.0 / (double)Transient_pnts_per_decade;
+			int num_steps = (int)floor((log10(Transient_end) - log10(Transient_start)) / Transient_step_size) + 1;
+			transient_times.assign(num_steps, 0);
+			for (int i = 0; i < (int)transient_times.size(); i++) {
+				transient_times[i] = pow(10, log10(Transient_start) + i * Transient_step_size);
+			}
+			transient_velocities.assign(num_steps, 0);
+			if (!params.ToF_polaron_type) {
+				transient_electron_energies.assign(num_steps, 0);
+				transient_electron_counts.assign(num_steps, 0);
+			}
+			else {
+				transient_hole_energies.assign(num_steps, 0);
+				transient_hole_counts.assign(num_steps, 0);
+			}
+			electron_extraction_data.assign(lattice.getLength()*lattice.getWidth(), 0);
+			hole_extraction_data.assign(lattice.getLength()*lattice.getWidth(), 0);
+			transit_time_hist = Histogram(log10(transient_times.front()), log10(transient_times.back()), Transient_step_size);
+			// Create initial test polarons
+			generateToFPolarons();
 		}
-	}
-
-	vector<int> OSC_Sim::getToFTransientCounts() const {
-		if (!params.ToF_polaron_type) {
-			return transient_electron_counts;
+		else if (params.Enable_steady_transport_test) {
+			isLightOn = false;
+			// Initialize data structures
+			initializeSteadyDOS();
+			// Create test polarons
+			generateSteadyPolarons();
 		}
-		else {
-			return transient_hole_counts;
+		if (params.Enable_IQE_test) {
+			electron_extraction_data.assign(lattice.getLength()*lattice.getWidth(), 0);
+			hole_extraction_data.assign(lattice.getLength()*lattice.getWidth(), 0);
 		}
-	}
-
-	vector<double> OSC_Sim::getToFTransientEnergies() const {
-		if (!params.ToF_polaron_type) {
-			return transient_electron_energies;
+		if (Error_found) {
+			return false;
 		}
 		else {
-			return transient_hole_energies;
+			return true;
 		}
 	}
 
-	vector<double> OSC_Sim::getToFTransientTimes() const {
-		return transient_times;
-	}
-
-	vector<double> OSC_Sim::getToFTransientVelocities() const {
-		return transient_velocities;
-	}
-
-	vector<double> OSC_Sim::getTransitTimeData() const {
-		return transit_times;
-	}
-
-	bool OSC_Sim::initializeArchitecture() {
-		bool success;
-		N_donor_sites = 0;
-		N_acceptor_sites = 0;
-		if (params.Enable_neat) {
-			N_donor_sites = lattice.getNumSites();
-			N_acceptor_sites = 0;
-			for (auto &item : sites) {
-				item.setType(1);
-			}
+	bool OSC_Sim::mergeResults(const OSC_Sim& replica) {
+		if (params.Enable_steady_transport_test || replica.params.Enable_steady_transport_test) {
+			return false;
 		}
-		else if (params.Enable_bilayer) {
-			Coords coords;
-			for (int x = 0; x < lattice.getLength(); x++) {
-				for (int y = 0; y < lattice.getWidth(); y++) {
-					for (int z = 0; z < lattice.getHeight(); z++) {
-						coords.setXYZ(x, y, z);
-						if (z < params.Thickness_acceptor) {
-							sites[lattice.getSiteIndex(coords)].setType(2);
-							N_acceptor_sites++;
-						}
-						else {
-							sites[lattice.getSiteIndex(coords)].setType(1);
-							N_donor_sites++;
-						}
-					}
-				}
-			}
+		if (params.Enable_exciton_diffusion_test != replica.params.Enable_exciton_diffusion_test || params.Enable_ToF_test != replica.params.Enable_ToF_test
+			|| params.Enable_IQE_test != replica.params.Enable_IQE_test || params.Enable_dynamics_test != replica.params.Enable_dynamics_test
+			|| transient_times.size() != replica.transient_times.size()) {
+			return false;
 		}
-		else if (params.Enable_random_blend) {
-			vector<short> site_types;
-			site_types.assign(lattice.getNumSites(), 1);
-			for (int i = 0; i < (int)lattice.getNumSites()*params.Acceptor_conc; i++) {
-				site_types[i] = 2;
-				N_acceptor_sites++;
-			}
-			N_donor_sites = lattice.getNumSites() - N_acceptor_sites;
-			shuffle(site_types.begin(), site_types.end(), generator);
-			for (int i = 0; i < (int)sites.size(); i++) {
-				sites[i].setType(site_types[i]);
+		// Sum the counters
+		N_events_executed += replica.N_events_executed;
+		N_transient_cycles += replica.N_transient_cycles;
+		N_superbasin_exits += replica.N_superbasin_exits;
+		N_null_events += replica.N_null_events;
+		N_excitons_created += replica.N_excitons_created;
+		N_excitons_created_donor += replica.N_excitons_created_donor;
+		N_excitons_created_acceptor += replica.N_excitons_created_acceptor;
+		N_singlet_excitons_recombined += replica.N_singlet_excitons_recombined;
+		N_triplet_excitons_recombined += replica.N_triplet_excitons_recombined;
+		N_singlet_excitons_dissociated += replica.N_singlet_excitons_dissociated;
+		N_triplet_excitons_dissociated += replica.N_triplet_excitons_dissociated;
+		N_singlet_singlet_annihilations += replica.N_singlet_singlet_annihilations;
+		N_singlet_triplet_annihilations += replica.N_singlet_triplet_annihilations;
+		N_triplet_triplet_annihilations += replica.N_triplet_triplet_annihilations;
+		N_singlet_polaron_annihilations += replica.N_singlet_polaron_annihilations;
+		N_triplet_polaron_annihilations += replica.N_triplet_polaron_annihilations;
+		N_exciton_intersystem_crossings += replica.N_exciton_intersystem_crossings;
+		N_exciton_reverse_intersystem_crossings += replica.N_exciton_reverse_intersystem_crossings;
+		N_excitons_quenched += replica.N_excitons_quenched;
+		N_electrons_created += replica.N_electrons_created;
+		N_electrons_recombined += replica.N_electrons_recombined;
+		N_electrons_collected += replica.N_electrons_collected;
+		N_holes_created += replica.N_holes_created;
+		N_holes_recombined += replica.N_holes_recombined;
+		N_holes_collected += replica.N_holes_collected;
+		N_geminate_recombinations += replica.N_geminate_recombinations;
+		N_bimolecular_recombinations += replica.N_bimolecular_recombinations;
+		N_electron_surface_recombinations += replica.N_electron_surface_recombinations;
+		N_hole_surface_recombinations += replica.N_hole_surface_recombinations;
+		// Merge the statistics and histograms
+		exciton_lifetime_stats.merge(replica.exciton_lifetime_stats);
+		exciton_diffusion_stats.merge(replica.exciton_diffusion_stats);
+		exciton_hop_distance_stats.merge(replica.exciton_hop_distance_stats);
+		transit_time_stats.merge(replica.transit_time_stats);
+		transit_mobility_stats.merge(replica.transit_mobility_stats);
+		transit_time_hist.merge(replica.transit_time_hist);
+		// Append the raw data
+		exciton_lifetimes.insert(exciton_lifetimes.end(), replica.exciton_lifetimes.begin(), replica.exciton_lifetimes.end());
+		exciton_diffusion_distances.insert(exciton_diffusion_distances.end(), replica.exciton_diffusion_distances.begin(), replica.exciton_diffusion_distances.end());
+		exciton_hop_distances.insert(exciton_hop_distances.end(), replica.exciton_hop_distances.begin(), replica.exciton_hop_distances.end());
+		transit_times.insert(transit_times.end(), replica.transit_times.begin(), replica.transit_times.end());
+		// Sum the transient and charge extraction data
+		auto addVector = [](vector<double>& target, const vector<double>& input) {
+			for (int i = 0, imax = (int)min(target.size(), input.size()); i < imax; i++) {
+				target[i] += input[i];
 			}
-		}
-		else if (params.Enable_import_morphology) {
-			success = createImportedMorphology();
-			if (!success) {
-				return false;
+		};
+		auto addCounts = [](vector<int>& target, const vector<int>& input) {
+			for (int i = 0, imax = (int)min(target.size(), input.size()); i < imax; i++) {
+				target[i] += input[i];
 			}
-		}
-		// Send the site pointers to the Lattice object
-		vector<Site*> site_ptrs((int)sites.size());
-		for (int i = 0; i < (int)sites.size(); i++) {
-			site_ptrs[i] = &sites[i];
-		}
-		lattice.setSitePointers(site_ptrs);
+		};
+		addCounts(transient_singlet_counts, replica.transient_singlet_counts);
+		addCounts(transient_triplet_counts, replica.transient_triplet_counts);
+		addCounts(transient_electron_counts, replica.transient_electron_counts);
+		addCounts(transient_hole_counts, replica.transient_hole_counts);
+		addVector(transient_exciton_energies, replica.transient_exciton_energies);
+		addVector(transient_electron_energies, replica.transient_electron_energies);
+		addVector(transient_hole_energies, replica.transient_hole_energies);
+		addVector(transient_exciton_msdv, replica.transient_exciton_msdv);
+		addVector(transient_electron_msdv, replica.transient_electron_msdv);
+		addVector(transient_hole_msdv, replica.transient_hole_msdv);
+		addVector(transient_velocities, replica.transient_velocities);
+		addCounts(electron_extraction_data, replica.electron_extraction_data);
+		addCounts(hole_extraction_data, replica.hole_extraction_data);
 		return true;
 	}
 
@@ -2671,6 +4054,8 @@ namespace Excimontec {
 	}
 
 	void OSC_Sim::reassignSiteEnergies() {
+		// The cached escape rates were calculated from the previous site energies
+		escape_rate_cache.clear();
 		vector<float> site_energies_donor;
 		vector<float> site_energies_acceptor;
 		if (params.Enable_gaussian_dos) {
@@ -2685,16 +4070,18 @@ namespace Excimontec {
 			createExponentialDOSVector(site_energies_donor, 0, params.Energy_urbach_donor, generator);
 			createExponentialDOSVector(site_energies_acceptor, 0, params.Energy_urbach_acceptor, generator);
 		}
+		vector<float>& energies_out = getWritableSiteEnergies();
 		int donor_count = 0;
 		int acceptor_count = 0;
-		for (auto& site : sites) {
+		for (int n = 0; n < (int)sites.size(); n++) {
+			const auto& site = sites[n];
 			if (params.Enable_gaussian_dos || params.Enable_exponential_dos) {
 				if (site.getType() == (short)1) {
-					site.setEnergy(*(site_energies_donor.begin() + donor_count));
+					energies_out[n] = *(site_energies_donor.begin() + donor_count);
 					donor_count++;
 				}
 				else if (site.getType() == (short)2) {
-					site.setEnergy(*(site_energies_acceptor.begin() + acceptor_count));
+					energies_out[n] = *(site_energies_acceptor.begin() + acceptor_count);
 					acceptor_count++;
 				}
 				else {
@@ -2706,10 +4093,10 @@ namespace Excimontec {
 			}
 			else {
 				if (site.getType() == (short)1) {
-					site.setEnergy(0.0);
+					energies_out[n] = 0.0;
 				}
 				else if (site.getType() == (short)2) {
-					site.setEnergy(0.0);
+					energies_out[n] = 0.0;
 				}
 				else {
 					cout << getId() << ": Error! Undefined site type detected while assigning site energies." << endl;
@@ -2758,22 +4145,22 @@ namespace Excimontec {
 					if (sites[n].getType() == (short)1) {
 						if (!params.Enable_gaussian_dos && !params.Enable_exponential_dos) {
 							energy_new = (counts_first * (float)params.Energy_shift_donor) + (counts_second * (float)params.Energy_shift_donor / sqrt(2.0f)) + (counts_third * (float)params.Energy_shift_donor / sqrt(3.0f));
-							sites[n].setEnergy(energy_new);
+							energies_out[n] = energy_new;
 						}
 						else {
-							energy_new = sites[n].getEnergy() + (counts_first * (float)params.Energy_shift_donor) + (counts_second * (float)params.Energy_shift_donor / sqrt(2.0f)) + (counts_third * (float)params.Energy_shift_donor / sqrt(3.0f));
-							sites[n].setEnergy(energy_new);
+							energy_new = energies_out[n] + (counts_first * (float)params.Energy_shift_donor) + (counts_second * (float)params.Energy_shift_donor / sqrt(2.0f)) + (counts_third * (float)params.Energy_shift_donor / sqrt(3.0f));
+							energies_out[n] = energy_new;
 						}
 
 					}
 					else if (sites[n].getType() == (short)2) {
 						if (!params.Enable_gaussian_dos && !params.Enable_exponential_dos) {
 							energy_new = (counts_first * (float)params.Energy_shift_acceptor) + (counts_second * (float)params.Energy_shift_acceptor / sqrt(2.0f)) + (counts_third * (float)params.Energy_shift_acceptor / sqrt(3.0f));
-							sites[n].setEnergy(energy_new);
+							energies_out[n] = energy_new;
 						}
 						else {
-							energy_new = sites[n].getEnergy() + (counts_first * (float)params.Energy_shift_acceptor) + (counts_second * (float)params.Energy_shift_acceptor / sqrt(2.0f)) + (counts_third * (float)params.Energy_shift_acceptor / sqrt(3.0f));
-							sites[n].setEnergy(energy_new);
+							energy_new = energies_out[n] + (counts_first * (float)params.Energy_shift_acceptor) + (counts_second * (float)params.Energy_shift_acceptor / sqrt(2.0f)) + (counts_third * (float)params.Energy_shift_acceptor / sqrt(3.0f));
+							energies_out[n] = energy_new;
 						}
 					}
 					else {
@@ -2786,7 +4173,21 @@ namespace Excimontec {
 			}
 		}
 		if (params.Enable_import_energies) {
-			ifstream infile(params.Energies_import_filename);
+			// Site energies that were already imported for the other replicas are shared instead of being imported again
+			const auto& lattice_params = params.Params_lattice;
+			if (shared_data && !shared_data->site_energies.empty() && lattice.getLength() == lattice_params.Length && lattice.getWidth() == lattice_params.Width && lattice.getHeight() == lattice_params.Height) {
+				for (const auto& site : sites) {
+					if (site.getType() != (short)1 && site.getType() != (short)2) {
+						cout << getId() << ": Error! Undefined site type detected while assigning site energies." << endl;
+						setErrorMessage("Undefined site type detected while assigning site energies.");
+						Error_found = true;
+						return;
+					}
+				}
+				site_energies = shared_ptr<const vector<float>>(shared_data, &shared_data->site_energies);
+				return;
+			}
+			ifstream infile(params.Energies_import_filename, ifstream::in | ifstream::binary);
 			// Check if energies file exists and is accessible
 			if (!infile.good()) {
 				cout << getId() << ": Error opening site energies file for importing." << endl;
@@ -2795,26 +4196,23 @@ namespace Excimontec {
 				infile.close();
 				return;
 			}
-			// Copy all fine lines into a string vector
-			string line;
-			vector<string> lines;
-			while (getline(infile, line)) {
-				lines.push_back(line);
-			}
-			// Check that the file contains at least 3 lines for the lattice dimensions
+			// Read the site energies from either a binary or text format file
 			int length = -1;
 			int width = -1;
 			int height = -1;
-			if (lines.size() > 3) {
-				// Read in the lattice dimensions
-				length = stoi(lines[0]);
-				width = stoi(lines[1]);
-				height = stoi(lines[2]);
-			}
-			// Check that valid lattice dimensions were read from the file
-			if (length <= 0 || width <= 0 || height <= 0) {
-				cout << getId() << ": Error importing the site energies, lattice dimensions imported from file are not valid." << endl;
-				setErrorMessage("Error importing the site energies, lattice dimensions imported from file are not valid.");
+			vector<float> energies;
+			string error_msg;
+			bool success;
+			if (isEnergiesFileBinary(infile)) {
+				success = readEnergiesBinary(infile, length, width, height, energies, error_msg);
+			}
+			else {
+				success = readEnergiesText(infile, length, width, height, energies, error_msg);
+			}
+			infile.close();
+			if (!success) {
+				cout << getId() << ": " << error_msg << endl;
+				setErrorMessage(error_msg);
 				Error_found = true;
 				return;
 			}
@@ -2825,44 +4223,128 @@ namespace Excimontec {
 				Error_found = true;
 				return;
 			}
-			// Check that the number of read lines corresponds to the correct number of lattice sites
-			if ((int)lines.size() != (length*width*height + 3)) {
-				cout << getId() << ": Error importing the site energies, the number of energies does not equal the number of sites." << endl;
-				setErrorMessage("Error importing the site energies file,  the number of energies does not equal the number of sites.");
-				Error_found = true;
-				return;
-			}
-			int i = 3;
-			for (int x = 0; x < length; x++) {
-				for (int y = 0; y < width; y++) {
-					for (int z = 0; z < height; z++) {
-						float energy = stof(lines[i]);
-						long int index = lattice.getSiteIndex(Coords(x, y, z));
-						if (sites[index].getType() == (short)1) {
-							sites[index].setEnergy(energy);
-						}
-						else if (sites[index].getType() == (short)2) {
-							sites[index].setEnergy(energy);
-						}
-						else {
-							cout << getId() << ": Error! Undefined site type detected while assigning site energies." << endl;
-							setErrorMessage("Undefined site type detected while assigning site energies.");
-							Error_found = true;
-							return;
-						}
-						i++;
-					}
+			// Energies in both file formats are stored in site index order
+			for (int n = 0; n < (int)sites.size(); n++) {
+				if (sites[n].getType() == (short)1 || sites[n].getType() == (short)2) {
+					energies_out[n] = energies[n];
+				}
+				else {
+					cout << getId() << ": Error! Undefined site type detected while assigning site energies." << endl;
+					setErrorMessage("Undefined site type detected while assigning site energies.");
+					Error_found = true;
+					return;
 				}
 			}
+		}
+	}
+
+	bool OSC_Sim::readEnergiesBinary(ifstream& infile, int& length, int& width, int& height, vector<float>& energies, string& error_msg) {
+		auto read_uint32 = [&infile](uint32_t& value) {
+			unsigned char bytes[4];
+			if (!infile.read(reinterpret_cast<char*>(bytes), 4)) {
+				return false;
+			}
+			value = (uint32_t)bytes[0] | ((uint32_t)bytes[1] << 8) | ((uint32_t)bytes[2] << 16) | ((uint32_t)bytes[3] << 24);
+			return true;
+		};
+		// Read the file header
+		string identifier(Energies_binary_identifier.size(), ' ');
+		infile.read(&identifier[0], identifier.size());
+		uint32_t version = 0;
+		uint32_t flags = 0;
+		uint32_t dims[3] = { 0, 0, 0 };
+		if (!infile || identifier.compare(Energies_binary_identifier) != 0 || !read_uint32(version) || !read_uint32(flags) || !read_uint32(dims[0]) || !read_uint32(dims[1]) || !read_uint32(dims[2])) {
+			error_msg = "Error importing the site energies, the binary file header could not be read.";
+			return false;
+		}
+		if (version != Energies_binary_version) {
+			error_msg = "Error importing the site energies, the binary file format version is not supported.";
+			return false;
+		}
+		length = (int)dims[0];
+		width = (int)dims[1];
+		height = (int)dims[2];
+		// Check that valid lattice dimensions were read from the file
+		if (length <= 0 || width <= 0 || height <= 0) {
+			error_msg = "Error importing the site energies, lattice dimensions imported from file are not valid.";
+			return false;
+		}
+		// Read all site energies as a single block directly into the energies vector
+		static_assert(sizeof(float) == 4, "The binary site energies format requires 32-bit floats.");
+		energies.assign((long int)length*width*height, 0);
+		infile.read(reinterpret_cast<char*>(energies.data()), energies.size() * sizeof(float));
+		if (infile.gcount() != (streamsize)(energies.size() * sizeof(float))) {
+			error_msg = "Error importing the site energies, the number of energies does not equal the number of sites.";
+			return false;
+		}
+		// The file data is little-endian, so the bytes must be swapped on big-endian hosts
+		const uint32_t endian_test = 1;
+		if (*reinterpret_cast<const unsigned char*>(&endian_test) != 1) {
+			for (auto& energy : energies) {
+				unsigned char* bytes = reinterpret_cast<unsigned char*>(&energy);
+				swap(bytes[0], bytes[3]);
+				swap(bytes[1], bytes[2]);
+			}
+		}
+		if (flags & Energies_binary_flag_checksum) {
+			uint32_t checksum = 0;
+			if (!read_uint32(checksum) || checksum != calculateEnergiesChecksum(energies)) {
+				error_msg = "Error importing the site energies, the checksum of the binary file data does not match.";
+				return false;
+			}
+		}
+		// Check that there is no extra data at the end of the file
+		if (infile.peek() != ifstream::traits_type::eof()) {
+			error_msg = "Error importing the site energies, the number of energies does not equal the number of sites.";
+			return false;
+		}
+		return true;
+	}
 
+	bool OSC_Sim::readEnergiesText(ifstream& infile, int& length, int& width, int& height, vector<float>& energies, string& error_msg) {
+		string line;
+		// Read in the lattice dimensions from the first three lines
+		length = -1;
+		width = -1;
+		height = -1;
+		vector<int> dims;
+		while ((int)dims.size() < 3 && getline(infile, line)) {
+			dims.push_back(stoi(line));
+		}
+		if ((int)dims.size() == 3) {
+			length = dims[0];
+			width = dims[1];
+			height = dims[2];
+		}
+		// Check that valid lattice dimensions were read from the file
+		if (length <= 0 || width <= 0 || height <= 0) {
+			error_msg = "Error importing the site energies, lattice dimensions imported from file are not valid.";
+			return false;
+		}
+		energies.clear();
+		energies.reserve((long int)length*width*height);
+		while (getline(infile, line)) {
+			energies.push_back(stof(line));
+		}
+		// Check that the number of read lines corresponds to the correct number of lattice sites
+		if ((long int)energies.size() != (long int)length*width*height) {
+			error_msg = "Error importing the site energies, the number of energies does not equal the number of sites.";
+			return false;
 		}
+		return true;
 	}
 
 	void OSC_Sim::removeExciton(list<Exciton>::iterator exciton_it) {
 		// Output diffusion distance
 		if (params.Enable_exciton_diffusion_test) {
-			exciton_diffusion_distances.push_back(lattice.getUnitSize()*exciton_it->calculateDisplacement());
-			exciton_lifetimes.push_back(getTime() - exciton_it->getCreationTime());
+			double diffusion_distance = lattice.getUnitSize()*exciton_it->calculateDisplacement();
+			double lifetime = getTime() - exciton_it->getCreationTime();
+			exciton_diffusion_stats.add(diffusion_distance);
+			exciton_lifetime_stats.add(lifetime);
+			if (params.Enable_raw_data_retention) {
+				exciton_diffusion_distances.push_back(diffusion_distance);
+				exciton_lifetimes.push_back(lifetime);
+			}
 		}
 		// Update exciton counters
 		N_excitons--;
@@ -2876,17 +4358,121 @@ namespace Excimontec {
 		deleteObject(&(*exciton_it));
 	}
 
-	bool OSC_Sim::siteContainsHole(const Coords& coords) {
-		if (lattice.isOccupied(coords)) {
-			auto object_ptr = (*lattice.getSiteIt(coords))->getObjectPtr();
-			if (object_ptr->getObjectType().compare(Polaron::object_type) == 0) {
-				return static_cast<Polaron*>(object_ptr)->getCharge();
-			}
+	void OSC_Sim::removeFreeSite(const long int site_index) {
+		long int position = free_site_positions[site_index];
+		if (position < 0) {
+			return;
+		}
+		auto& free_sites = (sites[site_index].getType() == (short)1) ? free_sites_donor : free_sites_acceptor;
+		// Move the last free site into the position of the removed site
+		free_sites[position] = free_sites.back();
+		free_site_positions[free_sites[position]] = position;
+		free_sites.pop_back();
+		free_site_positions[site_index] = -1;
+	}
+
+	bool OSC_Sim::reset(const Parameters& params_in) {
+		// Remove all objects and events that are left over from the previous simulation
+		deleteAllObjects();
+		clearResults();
+		// Perform a full initialization when the lattice or the film architecture changes
+		const auto& lattice_params = params.Params_lattice;
+		const auto& lattice_params_in = params_in.Params_lattice;
+		bool isArchitectureMatch = !sites.empty()
+			&& lattice_params.Length == lattice_params_in.Length && lattice_params.Width == lattice_params_in.Width && lattice_params.Height == lattice_params_in.Height
+			&& lattice_params.Unit_size == lattice_params_in.Unit_size && lattice_params.Enable_periodic_x == lattice_params_in.Enable_periodic_x
+			&& lattice_params.Enable_periodic_y == lattice_params_in.Enable_periodic_y && lattice_params.Enable_periodic_z == lattice_params_in.Enable_periodic_z
+			&& params.Enable_neat == params_in.Enable_neat && params.Enable_bilayer == params_in.Enable_bilayer
+			&& params.Thickness_donor == params_in.Thickness_donor && params.Thickness_acceptor == params_in.Thickness_acceptor
+			&& params.Enable_random_blend == params_in.Enable_random_blend && params.Acceptor_conc == params_in.Acceptor_conc
+			&& params.Enable_import_morphology == params_in.Enable_import_morphology && params.Morphology_filename == params_in.Morphology_filename;
+		if (!isArchitectureMatch) {
+			return init(params_in, getId());
+		}
+		// Reset error status
+		Error_found = false;
+		// Check parameters for errors
+		if (!params_in.checkParameters()) {
+			Error_found = true;
+			cout << getId() << ": Error with input parameters." << endl;
+			setErrorMessage("Error with the input parameters.");
+			return false;
+		}
+		// Set parameters of Simulation base class while continuing the random number stream of the previous simulation
+		auto generator_state = generator;
+		Simulation::init(params_in, getId());
+		generator = generator_state;
+		setTime(0);
+		params = params_in;
+		clearEventSlots();
+		escape_rate_cache.setCapacity(params.Escape_rate_cache_size);
+		escape_rate_cache.clear();
+		// Send the site pointers to the Lattice object
+		vector<Site*> site_ptrs(sites.size());
+		for (int i = 0; i < (int)sites.size(); i++) {
+			site_ptrs[i] = &sites[i];
+		}
+		lattice.setSitePointers(site_ptrs);
+		return initializeTest();
+	}
+
+	void OSC_Sim::setEventTrace(EventTrace* trace_ptr) {
+		Event_trace = trace_ptr;
+	}
+
+	void OSC_Sim::setObjectEvent(Object* object_ptr, Event* event_ptr, const double rate_total) {
+		Simulation::setObjectEvent(object_ptr, event_ptr);
+		// Objects are given an event slot the first time that their event is set
+		auto slot_it = event_slots.find(object_ptr);
+		if (slot_it == event_slots.end()) {
+			slot_it = event_slots.insert(make_pair(object_ptr, addEventSlot())).first;
+		}
+		setSlotEvent(slot_it->second, event_ptr, rate_total);
+	}
+
+	void OSC_Sim::setSharedData(const shared_ptr<const SharedData>& shared_data_input) {
+		shared_data = shared_data_input;
+	}
+
+	void OSC_Sim::setSlotEvent(const int slot, Event* event_ptr, const double rate_total) {
+		slot_events[slot] = event_ptr;
+		if (params.Enable_FRM) {
+			event_heap.setTime(slot, (event_ptr != nullptr) ? event_ptr->getExecutionTime() : numeric_limits<double>::infinity());
+		}
+		else {
+			rate_tree.setRate(slot, (event_ptr != nullptr) ? rate_total : 0.0);
+		}
+	}
+
+	void OSC_Sim::synchronizeCheckpointState() {
+		// Pending event execution times are not stored in checkpoints, so all events are recalculated from the random number generator state
+		// The free site sets are rebuilt so that their order only depends on the site occupancy
+		initializeFreeSites();
+		// The superbasin histories of the polarons are not stored in checkpoints, so superbasin detection restarts from the current polaron positions
+		for (auto& item : electrons) {
+			item.clearBasin();
+		}
+		for (auto& item : holes) {
+			item.clearBasin();
+		}
+		// The event slots are reassigned so that their order only depends on the object order
+		clearEventSlots();
+		calculateAllEvents();
+		if (isLightOn) {
+			exciton_creation_events.front().calculateExecutionTime(R_exciton_generation_donor + R_exciton_generation_acceptor);
+		}
+		updateExcitonCreationEvent();
+	}
+
+	void OSC_Sim::updateExcitonCreationEvent() {
+		if (exciton_creation_slot < 0) {
+			exciton_creation_slot = addEventSlot();
 		}
-		return false;
+		setSlotEvent(exciton_creation_slot, isLightOn ? &exciton_creation_events.front() : nullptr, R_exciton_generation_donor + R_exciton_generation_acceptor);
 	}
 
 	void OSC_Sim::updateSteadyData() {
+		EXCIMONTEC_PROFILE_SCOPE(profiler, Profiler::Update_steady_data);
 		// Check if equilibration step is complete
 		if (N_events_executed == params.N_equilibration_events) {
 			// Mark time
@@ -2918,8 +4504,8 @@ namespace Excimontec {
 						energy = params.Homo_acceptor + getSiteEnergy(site_coords);
 						energy_C = params.Homo_acceptor + getSiteEnergy(site_coords) + calculateCoulomb(it, site_coords);
 					}
-					updateSteadyDOS(steady_DOOS, energy);
-					updateSteadyDOS(steady_DOOS_Coulomb, energy_C);
+					steady_DOOS.add(energy);
+					steady_DOOS_Coulomb.add(energy_C);
 					Steady_equilibration_energy_sum += energy;
 					Steady_equilibration_energy_sum_Coulomb += energy_C;
 				}
@@ -2927,80 +4513,25 @@ namespace Excimontec {
 			}
 			// Sample the density of states
 			if ((N_events_executed - params.N_equilibration_events) % Steady_hops_per_DOS_sample == 0) {
+				// The Coulomb potential at every site is built from the polaron positions in a single pass
+				calculateCoulombField(true, Coulomb_field);
 				for (long int i = 0; i < lattice.getNumSites(); i++) {
-					double energy_C;
-					auto site_coords = lattice.getSiteCoords(i);
-					if (lattice.isOccupied(site_coords)) {
-						auto it = getPolaronIt((*lattice.getSiteIt(site_coords))->getObjectPtr());
-						if (getSiteType(site_coords) == 1) {
-							energy_C = params.Homo_donor + getSiteEnergy(site_coords) + calculateCoulomb(it, site_coords);
-						}
-						else {
-							energy_C = params.Homo_acceptor + getSiteEnergy(site_coords) + calculateCoulomb(it, site_coords);
-						}
+					// The occupying hole does not contribute to the potential at its own site, so occupied and unoccupied sites are treated the same
+					if (sites[i].getType() == (short)1) {
+						steady_DOS_Coulomb.add(params.Homo_donor + (*site_energies)[i] + Coulomb_field[i]);
 					}
 					else {
-						if (getSiteType(site_coords) == 1) {
-							energy_C = params.Homo_donor + getSiteEnergy(site_coords) + calculateCoulomb(true, site_coords);
-						}
-						else {
-							energy_C = params.Homo_acceptor + getSiteEnergy(site_coords) + calculateCoulomb(true, site_coords);
-						}
+						steady_DOS_Coulomb.add(params.Homo_acceptor + (*site_energies)[i] + Coulomb_field[i]);
 					}
-					updateSteadyDOS(steady_DOS_Coulomb, energy_C);
 				}
 				Steady_DOS_sampling_counter++;
 			}
 		}
 	}
 
-	void OSC_Sim::updateSteadyDOS(vector<pair<double, double>>& density_of_states, double state_energy) {
-		// Check if the density of states is empty
-		if ((int)density_of_states.size() == 0) {
-			// Round input state_energy to nearest bin value
-			double new_bin = round_int(state_energy / DOS_bin_size)*DOS_bin_size;
-			density_of_states.push_back(make_pair(new_bin, 1.0));
-			return;
-		}
-		int new_bin_int = round_int(state_energy / DOS_bin_size);
-		// Determine current range of bins
-		int smallest_bin_int = round_int(density_of_states[0].first / DOS_bin_size);
-		int largest_bin_int = round_int(density_of_states.back().first / DOS_bin_size);
-		if (new_bin_int < smallest_bin_int) {
-			// Insert as many bins as needed before the current bin to extend the range of the histogram to include the new state_energy
-			vector<pair<double, double>> temp;
-			for (int i = new_bin_int; i < smallest_bin_int; i++) {
-				temp.push_back(make_pair(i*DOS_bin_size, 0.0));
-			}
-			// Add histogram count for the new state energy
-			temp[0].second += 1.0;
-			// Insert temp vector into the main density of states vector
-			density_of_states.insert(density_of_states.begin(), temp.begin(), temp.end());
-			return;
-		}
-		if (new_bin_int > largest_bin_int) {
-			// Insert as many bins as needed after the current bin to extend the range of the histogram to include the new state_energy
-			vector<pair<double, double>> temp;
-			for (int i = largest_bin_int + 1; i <= new_bin_int; i++) {
-				temp.push_back(make_pair(i*DOS_bin_size, 0.0));
-			}
-			// Add histogram count for the new state energy
-			temp.back().second += 1.0;
-			// Insert temp vector into the main density of states vector
-			density_of_states.insert(density_of_states.end(), temp.begin(), temp.end());
-			return;
-		}
-		// Calculate start of data range
-		double min_val = smallest_bin_int * DOS_bin_size - 0.5*DOS_bin_size;
-		// Add the state_energy to histogram
-		int index = (int)floor((state_energy - min_val) / DOS_bin_size);
-		density_of_states[index].second += 1.0;
-		return;
-	}
-
 	void OSC_Sim::updateTransientData() {
-		// ToF_positions_prev is a vector that stores the z-position of each charge carrier at the previous time interval
-		// Transient_xxxx_energies_prev is a vector that stores the energies of each object at the previous time interval
+		EXCIMONTEC_PROFILE_SCOPE(profiler, Profiler::Update_transient_data);
+		// Each exciton and polaron stores its own site energy and z-position from the previous time interval
 		if (params.Enable_ToF_test) {
 			// Check if enough time has passed since the previous time interval
 			if ((getTime() - Transient_creation_time) > transient_times[Transient_index_prev + 1]) {
@@ -3014,18 +4545,16 @@ namespace Excimontec {
 					if (!params.ToF_polaron_type) {
 						transient_electron_counts[Transient_index_prev + 1] += Transient_electron_counts_prev;
 						for (auto const &item : electrons) {
-							int electron_index = (int)distance(transient_electron_tags.begin(), find(transient_electron_tags.begin(), transient_electron_tags.end(), item.getTag()));
 							// transient_velocities[index_prev+1] += 0;
-							transient_electron_energies[Transient_index_prev + 1] += transient_electron_energies_prev[electron_index];
+							transient_electron_energies[Transient_index_prev + 1] += item.getTransientEnergyPrev();
 						}
 					}
 					// holes
 					else {
 						transient_hole_counts[Transient_index_prev + 1] += Transient_hole_counts_prev;
 						for (auto const &item : holes) {
-							int hole_index = (int)distance(transient_hole_tags.begin(), find(transient_hole_tags.begin(), transient_hole_tags.end(), item.getTag()));
 							// transient_velocities[index_prev+1] += 0;
-							transient_hole_energies[Transient_index_prev + 1] += transient_hole_energies_prev[hole_index];
+							transient_hole_energies[Transient_index_prev + 1] += item.getTransientEnergyPrev();
 						}
 					}
 					Transient_index_prev++;
@@ -3035,26 +4564,24 @@ namespace Excimontec {
 				if (!params.ToF_polaron_type) {
 					transient_electron_counts[index] += N_electrons;
 					Transient_electron_counts_prev = N_electrons;
-					for (auto const &item : electrons) {
-						// Get electron site energy and position for previous timestep
-						int electron_index = (int)distance(transient_electron_tags.begin(), find(transient_electron_tags.begin(), transient_electron_tags.end(), item.getTag()));
-						transient_velocities[index] += abs(1e-7*lattice.getUnitSize()*(item.getCoords().z - ToF_positions_prev[electron_index])) / ((getTime() - Transient_creation_time) - transient_times[Transient_index_prev]);
+					for (auto &item : electrons) {
+						// Use electron position from the previous timestep and record site energy and position for the next timestep
+						transient_velocities[index] += abs(1e-7*lattice.getUnitSize()*(item.getCoords().z - item.getTransientZPrev())) / ((getTime() - Transient_creation_time) - transient_times[Transient_index_prev]);
 						transient_electron_energies[index] += getSiteEnergy(item.getCoords());
-						transient_electron_energies_prev[electron_index] = getSiteEnergy(item.getCoords());
-						ToF_positions_prev[electron_index] = item.getCoords().z;
+						item.setTransientEnergyPrev(getSiteEnergy(item.getCoords()));
+						item.setTransientZPrev(item.getCoords().z);
 					}
 				}
 				// holes
 				else {
 					transient_hole_counts[index] += N_holes;
 					Transient_hole_counts_prev = N_holes;
-					for (auto const &item : holes) {
-						// Get hole site energy and position for previous timestep
-						int hole_index = (int)distance(transient_hole_tags.begin(), find(transient_hole_tags.begin(), transient_hole_tags.end(), item.getTag()));
-						transient_velocities[index] += abs(1e-7*lattice.getUnitSize()*(item.getCoords().z - ToF_positions_prev[hole_index])) / ((getTime() - Transient_creation_time) - transient_times[Transient_index_prev]);
+					for (auto &item : holes) {
+						// Use hole position from the previous timestep and record site energy and position for the next timestep
+						transient_velocities[index] += abs(1e-7*lattice.getUnitSize()*(item.getCoords().z - item.getTransientZPrev())) / ((getTime() - Transient_creation_time) - transient_times[Transient_index_prev]);
 						transient_hole_energies[index] += getSiteEnergy(item.getCoords());
-						transient_hole_energies_prev[hole_index] = getSiteEnergy(item.getCoords());
-						ToF_positions_prev[hole_index] = item.getCoords().z;
+						item.setTransientEnergyPrev(getSiteEnergy(item.getCoords()));
+						item.setTransientZPrev(item.getCoords().z);
 					}
 				}
 				Transient_index_prev = index;
@@ -3074,16 +4601,13 @@ namespace Excimontec {
 					transient_electron_counts[Transient_index_prev + 1] += Transient_electron_counts_prev;
 					transient_hole_counts[Transient_index_prev + 1] += Transient_hole_counts_prev;
 					for (auto const &item : excitons) {
-						int exciton_index = (int)distance(transient_exciton_tags.begin(), find(transient_exciton_tags.begin(), transient_exciton_tags.end(), item.getTag()));
-						transient_exciton_energies[Transient_index_prev + 1] += transient_exciton_energies_prev[exciton_index];
+						transient_exciton_energies[Transient_index_prev + 1] += item.getTransientEnergyPrev();
 					}
 					for (auto const &item : electrons) {
-						int electron_index = (int)distance(transient_electron_tags.begin(), find(transient_electron_tags.begin(), transient_electron_tags.end(), item.getTag()));
-						transient_electron_energies[Transient_index_prev + 1] += transient_electron_energies_prev[electron_index];
+						transient_electron_energies[Transient_index_prev + 1] += item.getTransientEnergyPrev();
 					}
 					for (auto const &item : holes) {
-						int hole_index = (int)distance(transient_hole_tags.begin(), find(transient_hole_tags.begin(), transient_hole_tags.end(), item.getTag()));
-						transient_hole_energies[Transient_index_prev + 1] += transient_hole_energies_prev[hole_index];
+						transient_hole_energies[Transient_index_prev + 1] += item.getTransientEnergyPrev();
 					}
 					Transient_index_prev++;
 				}
@@ -3097,32 +4621,61 @@ namespace Excimontec {
 				Transient_electron_counts_prev = N_electrons;
 				Transient_hole_counts_prev = N_holes;
 				for (auto &item : excitons) {
-					// Get polaron site energy and position for previous timestep
-					int exciton_index = (int)distance(transient_exciton_tags.begin(), find(transient_exciton_tags.begin(), transient_exciton_tags.end(), item.getTag()));
 					transient_exciton_msdv[index] += intpow(1e-7*lattice.getUnitSize()*item.calculateDisplacement(), 2) / ((getTime() - Transient_creation_time) - transient_times[Transient_index_prev]);
 					item.resetInitialCoords(item.getCoords());
 					transient_exciton_energies[index] += getSiteEnergy(item.getCoords());
-					transient_exciton_energies_prev[exciton_index] = getSiteEnergy(item.getCoords());
+					item.setTransientEnergyPrev(getSiteEnergy(item.getCoords()));
 				}
 				for (auto &item : electrons) {
-					// Get polaron site energy and position for previous timestep
-					int electron_index = (int)distance(transient_electron_tags.begin(), find(transient_electron_tags.begin(), transient_electron_tags.end(), item.getTag()));
 					transient_electron_msdv[index] += intpow(1e-7*lattice.getUnitSize()*item.calculateDisplacement(), 2) / ((getTime() - Transient_creation_time) - transient_times[Transient_index_prev]);
 					item.resetInitialCoords(item.getCoords());
 					transient_electron_energies[index] += getSiteEnergy(item.getCoords());
-					transient_electron_energies_prev[electron_index] = getSiteEnergy(item.getCoords());
+					item.setTransientEnergyPrev(getSiteEnergy(item.getCoords()));
 				}
 				for (auto &item : holes) {
-					// Get polaron site energy and position for previous timestep
-					int hole_index = (int)distance(transient_hole_tags.begin(), find(transient_hole_tags.begin(), transient_hole_tags.end(), item.getTag()));
 					transient_hole_msdv[index] += intpow(1e-7*lattice.getUnitSize()*item.calculateDisplacement(), 2) / ((getTime() - Transient_creation_time) - transient_times[Transient_index_prev]);
 					item.resetInitialCoords(item.getCoords());
 					transient_hole_energies[index] += getSiteEnergy(item.getCoords());
-					transient_hole_energies_prev[hole_index] = getSiteEnergy(item.getCoords());
+					item.setTransientEnergyPrev(getSiteEnergy(item.getCoords()));
 				}
 				Transient_index_prev = index;
 			}
 		}
 
 	}
+
+	void OSC_Sim::writeEnergiesBinary(ofstream& outfile, const int length, const int width, const int height, const vector<float>& energies, const bool enable_checksum) {
+		auto write_uint32 = [&outfile](const uint32_t value) {
+			char bytes[4];
+			for (int i = 0; i < 4; i++) {
+				bytes[i] = (char)((value >> (8 * i)) & 0xFFu);
+			}
+			outfile.write(bytes, 4);
+		};
+		// Write the file header
+		outfile.write(Energies_binary_identifier.c_str(), Energies_binary_identifier.size());
+		write_uint32(Energies_binary_version);
+		write_uint32(enable_checksum ? Energies_binary_flag_checksum : 0);
+		write_uint32((uint32_t)length);
+		write_uint32((uint32_t)width);
+		write_uint32((uint32_t)height);
+		// Write all site energies as a single little-endian block
+		const uint32_t endian_test = 1;
+		if (*reinterpret_cast<const unsigned char*>(&endian_test) == 1) {
+			outfile.write(reinterpret_cast<const char*>(energies.data()), energies.size() * sizeof(float));
+		}
+		else {
+			vector<float> energies_swapped = energies;
+			for (auto& energy : energies_swapped) {
+				unsigned char* bytes = reinterpret_cast<unsigned char*>(&energy);
+				swap(bytes[0], bytes[3]);
+				swap(bytes[1], bytes[2]);
+			}
+			outfile.write(reinterpret_cast<const char*>(energies_swapped.data()), energies_swapped.size() * sizeof(float));
+		}
+		if (enable_checksum) {
+			write_uint32(calculateEnergiesChecksum(energies));
+		}
+	}
+
 }
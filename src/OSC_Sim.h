@@ -8,17 +8,33 @@
 
 #include "Simulation.h"
 #include "Site.h"
+#include "EscapeRateCache.h"
+#include "EventHeap.h"
+#include "EventTrace.h"
 #include "Exciton.h"
+#include "Histogram.h"
 #include "Parameters.h"
 #include "Polaron.h"
+#include "Profiler.h"
+#include "RateTree.h"
+#include "Statistics.h"
 #include "Version.h"
 #include <algorithm>
+#include <climits>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
 #include <fstream>
+#include <iomanip>
 #include <iostream>
+#include <limits>
 #include <list>
+#include <memory>
 #include <numeric>
 #include <random>
+#include <sstream>
 #include <string>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -31,6 +47,16 @@ namespace Excimontec {
 	class OSC_Sim : public KMC_Lattice::Simulation {
 	public:
 
+		//! \brief This struct contains the read-only data that is identical for all simulation replicas run with the same parameters.
+		//! \details The data is created once by createSharedData and is shared by all replicas of the process through setSharedData,
+		//! so that each replica does not hold its own copy.
+		struct SharedData {
+			//! The Coulomb interaction energies indexed by the squared distance in lattice units.
+			std::vector<double> Coulomb_table;
+			//! The imported site energies in site index order, which is empty when the site energies are not imported.
+			std::vector<float> site_energies;
+		};
+
 		//! \brief Constructs an empty simulation object that is uninitialized.
 		OSC_Sim();
 
@@ -44,6 +70,15 @@ namespace Excimontec {
 		//! \return false if there are any errors during initialization.
 		bool init(const Parameters& params, const int id);
 
+		//! \brief Increases the number of tests to be performed by the simulation.
+		//! \details This allows more tests to be assigned to a simulation that has finished or is about to finish its current tests,
+		//! and exciton generation is restarted in the internal quantum efficiency test if it has already been stopped.
+		//! The steady state charge transport test is not divided into separate tests and cannot be extended.
+		//! \param N_tests_added is the number of additional tests.
+		//! \return true if the tests were added successfully.
+		//! \return false if the number of additional tests is not positive or the steady state charge transport test is enabled.
+		bool addTests(const int N_tests_added);
+
 		//! \brief Calculates the events for all objects in the simulation.
 		void calculateAllEvents();
 
@@ -53,6 +88,12 @@ namespace Excimontec {
 		//! \returns A pair vector where the first value is the bin position and the second value is the probability.
 		std::vector<std::pair<double, double>> calculateTransitTimeHist(const std::vector<double>& data, const int counts) const;
 
+		//! \brief Calculates the transit time probability histogram using the log-binned transit time histogram generated by the time-of-flight charge transport test.
+		//! \param hist is the histogram of the base 10 logarithm of the transit times for all extracted polarons.
+		//! \param counts is the total number of polarons tested.
+		//! \returns A pair vector where the first value is the bin position and the second value is the probability.
+		std::vector<std::pair<double, double>> calculateTransitTimeHist(const Histogram& hist, const int counts) const;
+
 		//! \brief Calculate the mobility data using the transit time data generated by the time-of-flight charge transport test.
 		//! \param transit_times is a vector of transit times for all extracted polarons.
 		//! \return A vector of calculated mobility values for each extracted polaron.
@@ -63,6 +104,22 @@ namespace Excimontec {
 		//! \return false if the simulation test is not yet finished.
 		bool checkFinished() const;
 
+		//! \brief Converts a site energies file between the text and binary formats.
+		//! The format of the input file is detected from the file header and the output file is written in the other format.
+		//! Binary output files are always written with a checksum, and text output files are written with enough precision to be converted back without loss.
+		//! \param filename_in is the name of the existing text or binary site energies file.
+		//! \param filename_out is the name of the file that will be created.
+		//! \return true if the file is converted successfully.
+		//! \return false if the input file cannot be opened or does not contain valid site energies data, or if the output file cannot be created or written.
+		static bool convertEnergiesFile(const std::string& filename_in, const std::string& filename_out);
+
+		//! \brief Creates the read-only data that can be shared by all simulation replicas run with the specified parameters.
+		//! \details The site energies are only included when energy importing is enabled and the site energies file can be read and matches the lattice dimensions.
+		//! Otherwise, each replica imports the site energies itself and reports any errors during its initialization.
+		//! \param params specifies the input parameters that will be used by all of the replicas.
+		//! \return A pointer to the shared data.
+		static std::shared_ptr<const SharedData> createSharedData(const Parameters& params);
+
 		//! \brief Creates an Exciton on a randomly selected unoccupied site.
 		//! \param spin specifies the spin state of the created exciton. (true for singlet and false for triplet)
 		void createExciton(const bool spin);
@@ -89,6 +146,18 @@ namespace Excimontec {
 		//! \return false if the next event cannot be executed.
 		bool executeNextEvent();
 
+		//! \brief Exports the full state of the simulation to a binary checkpoint file that can be used to restart the simulation.
+		//! \details The checkpoint contains the site energies and types, all objects, the simulation time, the counters, the test data, and the
+		//! random number generator state, which are written in the native byte order.  The file is first written to a temporary file that
+		//! replaces the checkpoint file once it is complete, so an interrupted export never leaves behind a partial checkpoint file.
+		//! Pending event execution times are not stored.  Instead, all events are recalculated after the checkpoint is written,
+		//! which is exact for a Markov process, so the simulation continues on the same trajectory as a simulation restarted
+		//! from the checkpoint with importCheckpoint.
+		//! \param filename is the name of the checkpoint file.
+		//! \return true if the checkpoint file was written successfully.
+		//! \return false if the checkpoint file could not be written, in which case the simulation can still be continued.
+		bool exportCheckpoint(const std::string& filename);
+
 		//! \brief Exports the relative lattice site energies to a text file.
 		//! \param filename is the name of the file that will be created in the working directory.
 		void exportEnergies(std::string filename);
@@ -98,6 +167,16 @@ namespace Excimontec {
 		//! \param charge designates whether electron or hole energies are output
 		void exportEnergies(std::string filename, bool charge);
 
+		//! \brief Exports the relative lattice site energies to a binary file.
+		//! The binary file starts with a header containing a format identifier, the format version, option flags, and the lattice dimensions.
+		//! The header is followed by the site energies stored as little-endian 32-bit floats in site index order and an optional checksum.
+		//! Binary energies files are detected automatically when importing site energies.
+		//! \param filename is the name of the file that will be created in the working directory.
+		//! \param enable_checksum determines whether a checksum of the site energy data is appended to the file.
+		//! \return true if the file is written successfully.
+		//! \return false if the file cannot be created or written, in which case an incomplete file is removed.
+		bool exportEnergiesBinary(std::string filename, bool enable_checksum);
+
 		//! \brief Gets the charge extraction map data generated by the time-of-flight charge transport or internal quantum efficiency tests. 
 		//! \param charge specifies whether to get electron or hole polaron extraction data.
 		//! \return A string vector that can be separately output to a file.
@@ -160,14 +239,26 @@ namespace Excimontec {
 		//! \return A vector of data representing the displacement distance of each exciton tested.
 		std::vector<double> getExcitonDiffusionData() const;
 
+		//! \brief Gets the exciton diffusion distance statistics accumulated during the exciton diffusion test.
+		//! \return A statistics object for the displacement distance of all excitons tested in units of nm.
+		Statistics getExcitonDiffusionStats() const;
+
 		//! \brief Gets the Exciton hop distance data generated during the exciton diffusion test.
 		//! /return A vector of data representing the hop distance of all exciton hop events in lattice units.
 		std::vector<int> getExcitonHopLengthData() const;
 
+		//! \brief Gets the exciton hop distance statistics accumulated during the exciton diffusion test.
+		//! \return A statistics object for the squared hop distance of all exciton hop events in lattice units.
+		Statistics getExcitonHopLengthStats() const;
+
 		//! \brief Gets the exciton lifetime data generated during the exciton diffusion test.
 		//! \return A vector of data representing the lifetime of each exciton tested.
 		std::vector<double> getExcitonLifetimeData() const;
 
+		//! \brief Gets the exciton lifetime statistics accumulated during the exciton diffusion test.
+		//! \return A statistics object for the lifetime of all excitons tested in units of s.
+		Statistics getExcitonLifetimeStats() const;
+
 		//! \brief Gets the internal electric field due to applied internal potential.
 		//! \return the internal electric field in units of V/cm.
 		double getInternalField() const;
@@ -255,6 +346,16 @@ namespace Excimontec {
 		//! \return The number of bimolecular electron-hole recombination events that have occurred since the simulation object was initialized.
 		int getN_bimolecular_recombinations() const;
 
+		//! \brief Gets the number of accelerated superbasin exit events that have been executed.
+		//! \return The number of polarons that have left a superbasin in one accelerated event since the simulation object was initialized.
+		long int getN_superbasin_exits() const;
+
+		//! \brief Gets the number of null events that have occurred when rate thinning or the escape rate cache is enabled.
+		//! Null events are polaron hops with an upper bound rate that were rejected or cached exciton and polaron hops to an occupied site that were rejected,
+		//! so they only advanced the simulation time.
+		//! \return The number of null events that have occurred since the simulation object was initialized.
+		long int getN_null_events() const;
+
 		//! \brief Gets the number of transient test cycles that have been performed.
 		//! During the time-of-flight charge transport test and the dynamics test, 
 		//! multiple transient cycles may be used to reach the target number of tested objects.
@@ -265,6 +366,11 @@ namespace Excimontec {
 		//! \return The event_type name of the previously executed event.
 		std::string getPreviousEventType() const;
 
+		//! \brief Gets the profiler that holds the call counts and wall times of the hot-path functions and the number of executed events of each type.
+		//! \details The profiler only collects data when Excimontec is compiled with EXCIMONTEC_PROFILING defined.
+		//! \return A reference to the profiler of the simulation.
+		const Profiler& getProfiler() const;
+
 		//! \brief Gets the energies of the lattice sites with the specified type.
 		//! \param site_type specifies the site type, where 1 is for donor sites and 2 is for acceptor sites.
 		//! \return A vector of data representing the lattice site energies of sites with the specified type in units of eV.
@@ -306,6 +412,11 @@ namespace Excimontec {
 		//! \return A pair vector where the first value is the state energy and the second in the density of states.
 		std::vector<std::pair<double, double>> getSteadyDOS_Coulomb() const;
 
+		//! \brief Gets the number of state energies sampled during the steady state charge transport test that were outside of the energy range of the DOS and DOOS histograms.
+		//! \details These samples are not included in the DOS and DOOS data.  The DOS without the Coulomb potential is only sampled when getSteadyDOS is called.
+		//! \return The total number of out of range samples in the DOS and DOOS histograms with and without the Coulomb potential.
+		double getSteadyDOSOutOfRangeCount() const;
+
 		//! \brief Gets the average equilibration energy of the polarons calculated during the steady state charge transport test.
 		//! The average equilibration energy corresponds to the average of the density of occupied states at steady state, quasi-equilibrium conditions.
 		//! \return The calculated average equilibration energy of the polarons in units of eV.
@@ -351,42 +462,101 @@ namespace Excimontec {
 		//! \return A vector of data representing the transit time of all extracted polarons.
 		std::vector<double> getTransitTimeData() const;
 
+		//! \brief Gets the log-binned transit time histogram generated during the time-of-flight charge transport test.
+		//! \return A histogram of the base 10 logarithm of the transit times of all extracted polarons with bins centered on the transient time points.
+		Histogram getTransitTimeHistogram() const;
+
+		//! \brief Gets the mobility statistics accumulated during the time-of-flight charge transport test.
+		//! \return A statistics object for the mobility calculated from the transit time of each extracted polaron.
+		Statistics getTransitMobilityStats() const;
+
+		//! \brief Gets the transit time statistics accumulated during the time-of-flight charge transport test.
+		//! \return A statistics object for the transit time of all extracted polarons.
+		Statistics getTransitTimeStats() const;
+
+		//! \brief Initializes the simulation object and restores the simulation state from a checkpoint file created by exportCheckpoint.
+		//! \details The simulation is restarted on the same trajectory that the checkpointed simulation followed after the checkpoint was written.
+		//! \param params specifies all of the input parameters, which must be the same as those of the checkpointed simulation.
+		//! \param id is the simulation ID number, which must be the same as that of the checkpointed simulation.
+		//! \param filename is the name of the checkpoint file.
+		//! \return true if the simulation state is restored successfully.
+		//! \return false if the checkpoint file cannot be read or does not match the input parameters.
+		bool importCheckpoint(const Parameters& params, const int id, const std::string& filename);
+
+		//! \brief Adds the results of another simulation replica to the results of this simulation.
+		//! \details This is used to combine the results of simulation replicas that were run with the same parameters in separate threads
+		//! before the results are combined across processors.  The event and test counters, statistics, histograms, transient data, and
+		//! charge extraction data are summed, while the simulation time and the objects and events of this simulation are not changed.
+		//! The steady state charge transport test results are averaged over the whole simulation and cannot be combined.
+		//! \param replica is the finished simulation replica to be merged.
+		//! \return true if the results were merged successfully.
+		//! \return false if the steady state charge transport test is enabled or the replica was not run with the same type of test.
+		bool mergeResults(const OSC_Sim& replica);
+
 		//! \brief Prints a message to the command line about the current status of the simulation test.
 		void outputStatus();
 
 		//! \brief Regenerates the site energies for all sites in the lattice.
 		void reassignSiteEnergies();
 
+		//! \brief Resets the simulation object so that it is ready to execute a new simulation test with new parameters.
+		//! \details All objects, events, and results from the previous simulation test are removed.  When the lattice dimensions and the film
+		//! architecture parameters are unchanged, the sites and the film architecture are kept and only the site energies, the Coulomb interactions,
+		//! and the test data structures are regenerated, and the random number stream of the previous test is continued.
+		//! Otherwise, the simulation object is fully initialized with the new parameters.
+		//! \param params specifies all of the input parameters needed to run the new simulation test.
+		//! \return true if the reset is successful.
+		//! \return false if there are any errors during the reset.
+		bool reset(const Parameters& params);
+
+		//! \brief Sets the event trace that records every event executed by the simulation.
+		//! \details The event trace is not owned by the simulation and must be open for as long as events are executed.
+		//! The event trace is kept when the simulation is reset or restored from a checkpoint.
+		//! \param trace_ptr is a pointer to the event trace, or nullptr to stop recording events.
+		void setEventTrace(EventTrace* trace_ptr);
+
+		//! \brief Sets the read-only data that is shared with the other simulation replicas.
+		//! \details The shared data must be created with the same parameters and must be set before the simulation is initialized, reset,
+		//! or restored from a checkpoint.  The site energies are copied before they are modified, so the other replicas are not affected.
+		//! \param shared_data_input is a pointer to the shared data, or nullptr to stop sharing data.
+		void setSharedData(const std::shared_ptr<const SharedData>& shared_data_input);
+
 	protected:
 
 	private:
+		// The benchmark suite in bench/bench.cpp calls the private simulation kernels through this class
+		friend class OSC_SimBenchmark;
+		// The unit tests in test/test.cpp compare private functions through this class
+		friend class OSC_SimTestAccess;
 
 		class Site_OSC : public KMC_Lattice::Site {
 		public:
-			float getEnergy() const { return energy; }
+			// Kind of object on the site, which is updated whenever an object is created, moved, deleted, or changes spin,
+			// so that the event calculations can classify the neighboring sites without looking up the objects
+			enum Occupant : char {
+				Empty = 0,
+				Singlet,
+				Triplet,
+				Electron,
+				Hole
+			};
+			Occupant getOccupant() const { return occupant; }
 			short getType() const { return type; }
-			void setEnergy(const float energy_input) { energy = energy_input; }
+			void setOccupant(const Occupant occupant_input) { occupant = occupant_input; }
 			void setType(const short site_type) { type = (char)site_type; }
 		private:
-			float energy;
 			char type = 0; //  type 1 represent donor, type 2 represents acceptor
+			Occupant occupant = Empty;
 		};
 
 		struct ExcitonEventCalcVars {
 			int range;
 			int dim;
+			// scratch events that are only used to calculate the rate constants of the candidate events
 			Exciton::Hop hop_event;
-			std::vector<Exciton::Hop> hops_temp;
 			Exciton::Dissociation diss_event;
-			std::vector<Exciton::Dissociation> dissociations_temp;
 			Exciton::Exciton_Annihilation ee_annihilation_event;
-			std::vector<Exciton::Exciton_Annihilation> ee_annihilations_temp;
 			Exciton::Polaron_Annihilation ep_annihilation_event;
-			std::vector<Exciton::Polaron_Annihilation> ep_annihilations_temp;
-			std::vector<bool> hops_valid;
-			std::vector<bool> dissociations_valid;
-			std::vector<bool> ee_annihilations_valid;
-			std::vector<bool> ep_annihilations_valid;
 			// precalculated distances vector that contains the distances to nearby sites used for event execution time calculations
 			std::vector<double> distances;
 			// precalculated isInDissRange and isInFRETRange vectors that contains booleans to indicate whether the nearby sites are within range for the different exciton events to be possible.
@@ -399,17 +569,9 @@ namespace Excimontec {
 				range = (int)ceil(((sim_ptr->params.FRET_cutoff > sim_ptr->params.Exciton_dissociation_cutoff) ? (sim_ptr->params.FRET_cutoff) : (sim_ptr->params.Exciton_dissociation_cutoff)) / sim_ptr->lattice.getUnitSize());
 				dim = (2 * range + 1);
 				hop_event = Exciton::Hop(sim_ptr);
-				hops_temp.assign(dim*dim*dim, hop_event);
 				diss_event = Exciton::Dissociation(sim_ptr);
-				dissociations_temp.assign(dim*dim*dim, diss_event);
 				ee_annihilation_event = Exciton::Exciton_Annihilation(sim_ptr);
-				ee_annihilations_temp.assign(dim*dim*dim, ee_annihilation_event);
 				ep_annihilation_event = Exciton::Polaron_Annihilation(sim_ptr);
-				ep_annihilations_temp.assign(dim*dim*dim, ep_annihilation_event);
-				hops_valid.assign(dim*dim*dim, false);
-				dissociations_valid.assign(dim*dim*dim, false);
-				ee_annihilations_valid.assign(dim*dim*dim, false);
-				ep_annihilations_valid.assign(dim*dim*dim, false);
 				// precalculated distances vector that contains the distances to nearby sites used for event execution time calculations
 				distances.assign(dim*dim*dim, 0.0);
 				// precalculated isInDissRange and isInFRETRange vectors that contains booleans to indicate whether the nearby sites are within range for the different exciton events to be possible.
@@ -434,18 +596,24 @@ namespace Excimontec {
 		};
 		ExcitonEventCalcVars exciton_event_calc_vars;
 
+		// Candidate event of the object whose events are being calculated, where index is the offset index of the destination site
+		// in the event calculation vectors, or -1 for events that stay on the site of the object
+		struct EventCandidate {
+			double rate;
+			int index;
+			EventTrace::Kind kind;
+		};
+		// Holds the candidate events of one object, and only the chosen candidate is copied to the event of the object in the main event lists
+		std::vector<EventCandidate> event_candidates;
+
 		struct PolaronEventCalcVars {
 			int range;
 			int dim;
+			// scratch events that are only used to calculate the rate constants of the candidate events
 			Polaron::Hop hop_event;
-			std::vector<Polaron::Hop> hops_temp;
 			Polaron::Recombination rec_event;
-			std::vector<Polaron::Recombination> recombinations_temp;
-			std::vector<bool> hops_valid;
-			std::vector<bool> recombinations_valid;
 			// precalculated distances vector that contains the distances to nearby sites used for event execution time calculations
 			std::vector<double> distances;
-			std::vector<double> E_deltas;
 			// precalculated isInRange vector that contains booleans to indicate if the nearby sites are within range for polaron events to be possible.
 			std::vector<bool> isInRange;
 
@@ -455,14 +623,9 @@ namespace Excimontec {
 				range = (int)ceil(sim_ptr->params.Polaron_hopping_cutoff / sim_ptr->lattice.getUnitSize());
 				dim = (2 * range + 1);
 				hop_event = Polaron::Hop(sim_ptr);
-				hops_temp.assign(dim*dim*dim, hop_event);
 				rec_event = Polaron::Recombination(sim_ptr);
-				recombinations_temp.assign(dim*dim*dim, rec_event);
-				hops_valid.assign(dim*dim*dim, false);
-				recombinations_valid.assign(dim*dim*dim, false);
 				// precalculated distances vector that contains the distances to nearby sites used for event execution time calculations
 				distances.assign(dim*dim*dim, 0.0);
-				E_deltas.assign(dim*dim*dim, 0.0);
 				// precalculated isInRange vector that contains booleans to indicate if the nearby sites are within range for polaron events to be possible.
 				isInRange.assign(dim*dim*dim, false);
 				// Initialize distances and isInRange vectors
@@ -486,7 +649,7 @@ namespace Excimontec {
 		double Transient_start;
 		double Transient_end;
 		int Transient_pnts_per_decade;
-		bool isLightOn;
+		bool isLightOn = false;
 		double R_exciton_generation_donor;
 		double R_exciton_generation_acceptor;
 		double Transient_step_size;
@@ -508,9 +671,23 @@ namespace Excimontec {
 		std::list<Polaron> holes;
 		// Event Data Structures
 		std::string previous_event_type = "";
+		EventTrace* Event_trace = nullptr;
+		// The profiler is mutable so that the const Coulomb interaction functions can be timed
+		mutable Profiler profiler;
 		double previous_event_time = 0;
 		std::list<Exciton::Creation> exciton_creation_events;
 		std::list<KMC_Lattice::Event*>::const_iterator exciton_creation_it;
+		// Each object and the exciton creation event have an event slot in the rate tree, which holds the total event rates used by the BKL algorithm,
+		// or in the event heap, which orders the event execution times when the FRM is enabled
+		RateTree rate_tree;
+		EventHeap event_heap;
+		std::unordered_map<const KMC_Lattice::Object*, int> event_slots;
+		std::vector<KMC_Lattice::Event*> slot_events;
+		int exciton_creation_slot = -1;
+		// Holds the event chosen from the rate tree or event heap so that it can be returned as an event list iterator
+		std::list<KMC_Lattice::Event*> chosen_event = std::list<KMC_Lattice::Event*>(1, nullptr);
+		// Holds the static escape rates and hop alias tables of the recently visited sites when the escape rate cache is enabled
+		EscapeRateCache escape_rate_cache;
 		std::list<Exciton::Hop> exciton_hop_events;
 		std::list<Exciton::Recombination> exciton_recombination_events;
 		std::list<Exciton::Dissociation> exciton_dissociation_events;
@@ -523,43 +700,56 @@ namespace Excimontec {
 		std::list<Polaron::Extraction> electron_extraction_events;
 		std::list<Polaron::Extraction> hole_extraction_events;
 		// Additional Data Structures
-		std::vector<double> Coulomb_table;
+		// Read-only data that is shared with the other replicas of the process
+		std::shared_ptr<const SharedData> shared_data;
+		std::shared_ptr<const std::vector<double>> Coulomb_table;
+		// Site energies in site index order, which are shared with the other replicas when they are imported and are copied before they are modified
+		std::shared_ptr<const std::vector<float>> site_energies;
 		std::vector<double> E_potential;
 		std::vector<std::pair<double, double>> DOS_correlation_data;
 		std::vector<double> exciton_lifetimes;
 		std::vector<double> exciton_diffusion_distances;
 		std::vector<int> exciton_hop_distances; // saved in lattice units squared
-		std::vector<int> transient_exciton_tags;
-		std::vector<int> transient_electron_tags;
-		std::vector<int> transient_hole_tags;
-		std::vector<int> ToF_positions_prev;
-		std::vector<double> transient_exciton_energies_prev;
-		std::vector<double> transient_electron_energies_prev;
-		std::vector<double> transient_hole_energies_prev;
 		std::vector<double> transient_exciton_msdv;
 		std::vector<double> transient_electron_msdv;
 		std::vector<double> transient_hole_msdv;
 		std::vector<int> electron_extraction_data;
 		std::vector<int> hole_extraction_data;
-		std::vector<std::pair<double, double>> steady_DOOS;
-		std::vector<std::pair<double, double>> steady_DOOS_Coulomb;
-		std::vector<std::pair<double, double>> steady_DOS;
-		std::vector<std::pair<double, double>> steady_DOS_Coulomb;
+		Histogram steady_DOOS;
+		Histogram steady_DOOS_Coulomb;
+		Histogram steady_DOS;
+		Histogram steady_DOS_Coulomb;
+		// Coulomb potential energy at each lattice site that is reused between DOS samples
+		std::vector<double> Coulomb_field;
 		std::vector<double> transient_times;
 		std::vector<double> transient_velocities;
 		std::vector<double> transient_exciton_energies;
 		std::vector<double> transient_electron_energies;
 		std::vector<double> transient_hole_energies;
 		std::vector<double> transit_times;
+		// Streaming statistics that are always accumulated, while the raw data vectors above are only filled when raw data retention is enabled
+		Statistics exciton_lifetime_stats;
+		Statistics exciton_diffusion_stats;
+		Statistics exciton_hop_distance_stats;
+		Statistics transit_time_stats;
+		Statistics transit_mobility_stats;
+		Histogram transit_time_hist;
 		std::vector<int> transient_singlet_counts;
 		std::vector<int> transient_triplet_counts;
 		std::vector<int> transient_electron_counts;
 		std::vector<int> transient_hole_counts;
+		// Indices of the unoccupied donor and acceptor sites used for random exciton creation
+		std::vector<long int> free_sites_donor;
+		std::vector<long int> free_sites_acceptor;
+		// Position of each lattice site in its free site vector, or -1 if the site is occupied
+		std::vector<long int> free_site_positions;
 		int Steady_hops_per_DOS_sample = 1000000;
 		int Steady_hops_per_DOOS_sample = 1000;
 		int Steady_DOS_sampling_counter = 0;
 		int Steady_DOOS_sampling_counter = 0;
 		double DOS_bin_size = 1e-2;
+		// Energy padding added to both sides of the DOS histogram range to accommodate the Coulomb potential
+		double DOS_range_padding = 1.0;
 		double Steady_equilibration_time = 0.0;
 		double Steady_equilibration_energy_sum = 0.0;
 		double Steady_equilibration_energy_sum_Coulomb = 0.0;
@@ -601,18 +791,56 @@ namespace Excimontec {
 		int N_electron_surface_recombinations = 0;
 		int N_hole_surface_recombinations = 0;
 		int N_transient_cycles = 0;
+		long int N_superbasin_exits = 0;
+		long int N_null_events = 0;
+		// Binary site energies file format
+		static const std::string Energies_binary_identifier;
+		static const uint32_t Energies_binary_version;
+		static const uint32_t Energies_binary_flag_checksum;
+		// Binary checkpoint file format
+		static const std::string Checkpoint_identifier;
+		static const uint32_t Checkpoint_version;
+		// Pointers to the counters and test data that are stored in checkpoint files in a fixed order
+		struct CheckpointData {
+			std::vector<int*> integers;
+			std::vector<long int*> long_integers;
+			std::vector<double*> doubles;
+			std::vector<std::vector<int>*> int_vectors;
+			std::vector<std::vector<double>*> double_vectors;
+			std::vector<Statistics*> statistics;
+			std::vector<Histogram*> histograms;
+		};
 		// Additional Functions
+		int addEventSlot();
+		void addFreeSite(const long int site_index);
+		void applyRateThinning(std::vector<KMC_Lattice::Object*>& recalc_objects, const KMC_Lattice::Object* object_ptr, const KMC_Lattice::Coords& coords_start, const KMC_Lattice::Coords& coords_dest);
 		double calculateCoulomb(const std::list<Polaron>::const_iterator polaron_it, const KMC_Lattice::Coords& coords) const;
 		double calculateCoulomb(const bool charge, const KMC_Lattice::Coords& coords) const;
+		double calculateCoulombDriftBound(const int distance_sq_lat) const;
+		void calculateCoulombField(const bool charge, std::vector<double>& energies) const;
 		void calculateDOSCorrelation();
 		void calculateDOSCorrelation(const double cutoff_radius);
+		static uint32_t calculateEnergiesChecksum(const std::vector<float>& energies);
 		KMC_Lattice::Coords calculateRandomExcitonCreationCoords();
+		void calculateExcitonCachedHopEvent(const std::list<Exciton>::iterator exciton_it);
 		void calculateExcitonEvents(Exciton* exciton_ptr);
+		double calculateExcitonHopRate(const std::list<Exciton>::iterator exciton_it, const KMC_Lattice::Coords& coords_start, const KMC_Lattice::Coords& coords_dest, const int index);
+		double calculateMobility(const double transit_time) const;
 		void calculateObjectListEvents(const std::vector<KMC_Lattice::Object*>& object_ptr_vec);
+		void calculatePolaronCachedHopEvent(const std::list<Polaron>::iterator polaron_it);
 		void calculatePolaronEvents(Polaron* polaron_ptr);
+		double calculatePolaronHopRate(const std::list<Polaron>::iterator polaron_it, const KMC_Lattice::Coords& coords_start, const KMC_Lattice::Coords& coords_dest, const int index, const double E_site_start, const double Coulomb_start, const double E_margin);
+		bool calculatePolaronSuperbasinEvent(const std::list<Polaron>::iterator polaron_it);
+		int chooseEventCandidate(double& rate_total);
+		std::list<KMC_Lattice::Event*>::const_iterator chooseNextEvent();
+		void clearEventSlots();
+		void clearResults();
+		static void createCoulombTable(const Parameters& params, std::vector<double>& table);
 		void createCorrelatedDOS(const double correlation_length);
 		bool createImportedMorphology();
+		void deleteAllObjects();
 		void deleteObject(KMC_Lattice::Object* object_ptr);
+		std::vector<KMC_Lattice::Object*> findRecalcObjects(const KMC_Lattice::Coords& coords_start, const KMC_Lattice::Coords& coords_dest);
 		// Exciton Event Execution Functions
 		bool executeExcitonCreation();
 		bool executeExcitonHop(const std::list<KMC_Lattice::Event*>::const_iterator event_it);
@@ -634,14 +862,27 @@ namespace Excimontec {
 		void generateDynamicsExcitons();
 		void generateSteadyPolarons();
 		void generateToFPolarons();
+		CheckpointData getCheckpointData();
 		std::list<Exciton>::iterator getExcitonIt(const KMC_Lattice::Object* object_ptr);
 		std::list<Polaron>::iterator getPolaronIt(const KMC_Lattice::Object* object_ptr);
+		std::vector<float>& getWritableSiteEnergies();
 		bool initializeArchitecture();
+		void initializeFreeSites();
+		void initializeSteadyDOS();
+		bool initializeTest();
+		static bool isEnergiesFileBinary(std::ifstream& infile);
+		bool isNullEvent(const std::list<KMC_Lattice::Event*>::const_iterator event_it);
+		static bool readEnergiesBinary(std::ifstream& infile, int& length, int& width, int& height, std::vector<float>& energies, std::string& error_msg);
+		static bool readEnergiesText(std::ifstream& infile, int& length, int& width, int& height, std::vector<float>& energies, std::string& error_msg);
 		void removeExciton(std::list<Exciton>::iterator exciton_it);
-		bool siteContainsHole(const KMC_Lattice::Coords& coords);
+		void removeFreeSite(const long int site_index);
+		void setObjectEvent(KMC_Lattice::Object* object_ptr, KMC_Lattice::Event* event_ptr, const double rate_total);
+		void setSlotEvent(const int slot, KMC_Lattice::Event* event_ptr, const double rate_total);
+		void synchronizeCheckpointState();
+		void updateExcitonCreationEvent();
 		void updateSteadyData();
-		void updateSteadyDOS(std::vector<std::pair<double, double>>& density_of_states, double state_energy);
 		void updateTransientData();
+		static void writeEnergiesBinary(std::ofstream& outfile, const int length, const int width, const int height, const std::vector<float>& energies, const bool enable_checksum);
 	};
 
 }
@@ -312,6 +312,37 @@ namespace Excimontec {
 			cout << "Error! The dielectric constant of the donor and the acceptor must be greater than zero." << endl;
 			return false;
 		}
+		// Check superbasin acceleration parameters
+		if (Enable_superbasin_acceleration && Superbasin_max_sites < 2) {
+			cout << "Error! The maximum number of sites in a superbasin must be at least two." << endl;
+			return false;
+		}
+		if (Enable_superbasin_acceleration && !(Superbasin_min_hops > 0)) {
+			cout << "Error! The minimum number of hops within a superbasin must be greater than zero." << endl;
+			return false;
+		}
+		if (Enable_superbasin_acceleration && Enable_steady_transport_test) {
+			cout << "Error! Superbasin acceleration cannot be used with the steady transport test." << endl;
+			return false;
+		}
+		// Check rate thinning parameters
+		if (Enable_rate_thinning && !(Thinning_energy_margin > 0)) {
+			cout << "Error! The energy margin for rate thinning must be greater than zero." << endl;
+			return false;
+		}
+		// Check escape rate cache parameters
+		if (Enable_escape_rate_cache && !(Escape_rate_cache_size > 0)) {
+			cout << "Error! The size of the escape rate cache must be greater than zero." << endl;
+			return false;
+		}
+		if (Enable_escape_rate_cache && Enable_rate_thinning) {
+			cout << "Error! The escape rate cache cannot be used together with rate thinning." << endl;
+			return false;
+		}
+		if (Enable_escape_rate_cache && (Enable_IQE_test || Enable_dynamics_test || Enable_steady_transport_test)) {
+			cout << "Error! The escape rate cache neglects the Coulomb interactions between polarons and can only be used with the exciton diffusion and time-of-flight tests." << endl;
+			return false;
+		}
 		return true;
 	}
 
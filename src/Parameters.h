@@ -42,11 +42,75 @@ namespace Excimontec {
 		//! Specifies whether or not extraction map data should be output to text file at the end of the simulation.
 		bool Enable_extraction_map_output = false;
 
+		//! Defines the minimum wall time in seconds between the exchanges of the completion and error status between processors.
+		double Status_check_interval = 1.0;
+
+		//! \brief Defines the number of tests that are assigned to a processor at a time when dynamic test distribution is enabled.
+		//! When enabled, N_tests defines the average number of tests per processor, and processors that finish their tests early are assigned more tests.
+		//! A value of zero disables dynamic test distribution so that each processor performs N_tests tests.
+		int Test_chunk_size = 0;
+
+		//! \brief Defines the number of threads on each processor that each run a separate simulation replica.
+		//! The replica results on each processor are combined before the results from all processors are combined.
+		int N_threads = 1;
+
+		//! \brief Defines the minimum wall time in seconds between the checkpoints of each simulation, where a value of zero disables checkpoints.
+		//! When checkpoints are enabled, a checkpoint is also written when the process receives SIGUSR1, and the simulation is stopped after
+		//! writing a checkpoint when the process receives SIGTERM.
+		double Checkpoint_interval = 0.0;
+
+		//! Specifies whether each simulation is restarted from its checkpoint file when the checkpoint file exists in the output directory.
+		bool Enable_restart = false;
+
+		//! \brief Specifies whether or not every executed event is recorded in a binary event trace file.
+		//! The event trace files can be converted into the text log format with the -decode_trace command.
+		bool Enable_event_trace = false;
+
+		//! \brief Defines the seed of the random number generator, where a negative value keeps the default seed of the KMC_Lattice library.
+		//! Each simulation adds its simulation ID to the seed, so that simulations with different IDs use different random number streams.
+		int Generator_seed = -1;
+
+		//! \brief Specifies whether or not polarons that hop back and forth within a small set of sites are accelerated with the superbasin method.
+		//! When a polaron has made Superbasin_min_hops hops within a set of at most Superbasin_max_sites sites, the exit site and the mean exit time
+		//! of the set are calculated from the absorbing Markov chain of the hops within the set, and the polaron leaves the set in one event.
+		//! The polaron stays on the site where it entered the set until it leaves, so the energies and Coulomb interactions sampled during that time
+		//! are those of the entry site.  This approximation cannot be used with the steady transport test, which samples the occupied state energies.
+		bool Enable_superbasin_acceleration = false;
+
+		//! Defines the maximum number of sites in a superbasin.
+		int Superbasin_max_sites = 8;
+
+		//! Defines the minimum number of hops within a set of sites before the set is treated as a superbasin.
+		int Superbasin_min_hops = 100;
+
+		//! \brief Specifies whether or not the polaron hop rates are calculated as upper bounds so that polarons outside of the hopping range of a moving charge are not recalculated.
+		//! The upper bound rates allow the Coulomb energy change of each hop to drift by up to Thinning_energy_margin before the events of the polaron are recalculated.
+		//! When a hop with an upper bound rate is chosen, it is executed with a probability equal to the ratio of its current rate to its upper bound rate,
+		//! and otherwise it is a null event that only advances the simulation time.
+		bool Enable_rate_thinning = false;
+
+		//! Defines the maximum drift of the Coulomb energy change of the polaron hops in units of eV before the events of a polaron are recalculated when rate thinning is enabled.
+		double Thinning_energy_margin = 0.01;
+
+		//! \brief Specifies whether or not the exciton and polaron hops are sampled from cached static hop rates.
+		//! The total escape rate and a Walker alias table of the hop destinations are calculated once for each visited site, neglecting the Coulomb
+		//! interactions between polarons, so this option is only valid when these interactions are negligible, such as in low density time-of-flight simulations.
+		//! The escape rate cache cannot be used with the IQE, dynamics, or steady transport tests, where Coulomb interactions between polarons determine the results.
+		//! A hop to a destination that is occupied when the hop is chosen is rejected as a null event that only advances the simulation time.
+		bool Enable_escape_rate_cache = false;
+
+		//! Defines the maximum number of sites that are stored by the escape rate cache before the least recently used sites are removed.
+		int Escape_rate_cache_size = 50000;
+
 		// Additional General Parameters -------------------------------------------------------------------------
 
 		//! Defines the internal electrical potential across the semiconductor layer
 		double Internal_potential;
 
+		//! \brief Specifies whether or not the individual exciton diffusion and transit time samples are stored.
+		//! Streaming statistics of these samples are always accumulated, so the raw data is only needed for custom analysis.
+		bool Enable_raw_data_retention = true;
+
 		// Morphology Parameters ---------------------------------------------------------------------------------
 
 		//! \brief Specifies whether or not to use a neat single phase material device architecture.
@@ -9,7 +9,9 @@
 #include "Utils.h"
 #include "Object.h"
 #include "Event.h"
+#include <algorithm>
 #include <string>
+#include <vector>
 
 namespace Excimontec {
 
@@ -63,6 +65,13 @@ namespace Excimontec {
 			//! \returns The string "Polaron_Hop".
 			std::string getEventType() const { return event_type; }
 
+			//! \brief Sets the rate constant of the hop event directly.
+			//! \details This function is used for superbasin exit events, whose rate constant is the inverse of the mean exit time from the superbasin,
+			//! for the hop events of the escape rate cache, whose rate constant is the total escape rate of the starting site, and to copy the rate
+			//! constant of the chosen candidate event to the event in the main event list.
+			//! \param rate is the rate constant of the event.
+			void setRateConstant(const double rate) { rate_constant = rate; }
+
 		private:
 
 		};
@@ -110,6 +119,11 @@ namespace Excimontec {
 			//! \returns The string "Polaron_Recombination".
 			std::string getEventType() const { return event_type; }
 
+			//! \brief Sets the rate constant of the recombination event directly.
+			//! \details This function is used to copy the rate constant of the chosen candidate event to the event in the main event list.
+			//! \param rate is the rate constant of the event.
+			void setRateConstant(const double rate) { rate_constant = rate; }
+
 		private:
 
 		};
@@ -160,8 +174,48 @@ namespace Excimontec {
 		//! \param polaron_charge is the charge state of the polaron. (true for positive and false for negative) 
 		Polaron(const double time, const int tag_num, const KMC_Lattice::Coords& coords_start, const bool polaron_charge) : KMC_Lattice::Object(time, tag_num, coords_start) {
 			charge = polaron_charge;
+			transient_energy_prev = 0;
+			transient_z_prev = coords_start.z;
+		}
+
+		//! \brief Records a hop of the polaron in the set of recently visited sites that is used for superbasin detection.
+		//! \details Hops to sites that are already in the set increase the number of recurrent hops.  When a hop leads to a new site and
+		//! the set is already full, the set is restarted with the starting and destination sites of the hop.
+		//! \param site_index_start is the lattice site index of the starting site of the hop.
+		//! \param site_index_dest is the lattice site index of the destination site of the hop.
+		//! \param max_sites is the maximum number of sites in the set.
+		void addBasinHop(const long int site_index_start, const long int site_index_dest, const int max_sites) {
+			if (basin_sites.empty()) {
+				basin_sites.push_back(site_index_start);
+			}
+			if (std::find(basin_sites.begin(), basin_sites.end(), site_index_dest) == basin_sites.end()) {
+				if ((int)basin_sites.size() >= max_sites) {
+					basin_sites.assign({ site_index_start, site_index_dest });
+					basin_hops = 1;
+					return;
+				}
+				basin_sites.push_back(site_index_dest);
+			}
+			basin_hops++;
 		}
 
+		//! \brief Clears the set of recently visited sites that is used for superbasin detection.
+		void clearBasin() {
+			basin_sites.clear();
+			basin_hops = 0;
+			basin_active = false;
+		}
+
+		//! \brief Gets the number of hops that the polaron has made within the set of recently visited sites.
+		int getBasinHops() const { return basin_hops; }
+
+		//! \brief Gets the lattice site indices of the set of recently visited sites.
+		const std::vector<long int>& getBasinSites() const { return basin_sites; }
+
+		//! \brief Gets the upper bound of the change in the Coulomb energy change of the hops of the polaron since its events were calculated.
+		//! \returns The Coulomb energy drift in units of eV.
+		double getCoulombDrift() const { return coulomb_drift; }
+
 		//! \brief Gets the charge state of the polaron.
 		//! \returns true if the polaron is a positively charged hole.
 		//! \returns false if the polaron is a negatively charged electron.
@@ -171,9 +225,41 @@ namespace Excimontec {
 		//! \returns The string "Polaron".
 		std::string getObjectType() const { return object_type; }
 
+		//! \brief Checks whether the current event of the polaron is an accelerated superbasin exit event.
+		bool isBasinActive() const { return basin_active; }
+
+		//! \brief Gets the site energy of the polaron that was recorded at the previous transient time interval.
+		//! \returns The recorded site energy in units of eV, which is 0 if no energy has been recorded.
+		double getTransientEnergyPrev() const { return transient_energy_prev; }
+
+		//! \brief Gets the z-position of the polaron that was recorded at the previous transient time interval.
+		//! \returns The recorded z-position, which is the starting z-position if no position has been recorded.
+		int getTransientZPrev() const { return transient_z_prev; }
+
+		//! \brief Sets whether the current event of the polaron is an accelerated superbasin exit event.
+		void setBasinActive(const bool is_active) { basin_active = is_active; }
+
+		//! \brief Sets the upper bound of the change in the Coulomb energy change of the hops of the polaron since its events were calculated.
+		//! \param drift is the Coulomb energy drift in units of eV.
+		void setCoulombDrift(const double drift) { coulomb_drift = drift; }
+
+		//! \brief Records the site energy of the polaron for use at the next transient time interval.
+		//! \param energy is the site energy in units of eV.
+		void setTransientEnergyPrev(const double energy) { transient_energy_prev = energy; }
+
+		//! \brief Records the z-position of the polaron for use at the next transient time interval.
+		//! \param z is the z-position of the lattice site occupied by the polaron.
+		void setTransientZPrev(const int z) { transient_z_prev = z; }
+
 	private:
 
 		bool charge; // false represents negative charge, true represents positive charge
+		double transient_energy_prev; // site energy at the previous transient time interval
+		int transient_z_prev; // z-position at the previous transient time interval
+		std::vector<long int> basin_sites; // recently visited sites used for superbasin detection
+		int basin_hops = 0; // number of hops within the recently visited sites
+		bool basin_active = false; // whether the current event is a superbasin exit event
+		double coulomb_drift = 0.0; // upper bound of the Coulomb energy change drift of the hops since the events were calculated
 
 	};
 
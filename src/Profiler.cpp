@@ -0,0 +1,126 @@
+// Copyright (c) 2017-2019 Michael C. Heiber
+// This source file is part of the Excimontec project, which is subject to the MIT License.
+// For more information, see the LICENSE file that accompanies this software.
+// The Excimontec project can be found on Github at https://github.com/MikeHeiber/Excimontec
+
+#include "Profiler.h"
+
+using namespace std;
+
+namespace Excimontec {
+
+	Profiler::Profiler() {
+		clear();
+	}
+
+	void Profiler::clear() {
+		call_counts.assign(N_sections, 0.0);
+		call_times.assign(N_sections, 0.0);
+		item_counts.assign(N_sections, 0.0);
+		event_counts.assign(EventTrace::N_kinds, 0.0);
+		event_candidates.assign(EventTrace::N_kinds, 0.0);
+		items_last = 0.0;
+	}
+
+	void Profiler::exportJSON(ostream& output, const string& indent) const {
+		output << "{\n";
+		output << indent << "  \"profiling_enabled\": " << (isEnabled() ? "true" : "false") << ",\n";
+		output << indent << "  \"sections\": {\n";
+		for (int i = 0; i < N_sections; i++) {
+			output << indent << "    \"" << getSectionName(i) << "\": { ";
+			output << "\"calls\": " << (int64_t)call_counts[i] << ", ";
+			output << "\"total_time_s\": " << call_times[i] << ", ";
+			output << "\"mean_time_ns\": " << ((call_counts[i] > 0) ? 1e9 * call_times[i] / call_counts[i] : 0.0) << ", ";
+			output << "\"mean_items\": " << ((call_counts[i] > 0) ? item_counts[i] / call_counts[i] : 0.0) << " }";
+			output << ((i < N_sections - 1) ? ",\n" : "\n");
+		}
+		output << indent << "  },\n";
+		output << indent << "  \"events\": {\n";
+		for (int i = 0; i < EventTrace::N_kinds; i++) {
+			output << indent << "    \"" << EventTrace::getEventType((uint8_t)i) << "\": { ";
+			output << "\"count\": " << (int64_t)event_counts[i] << ", ";
+			output << "\"mean_candidates\": " << ((event_counts[i] > 0) ? event_candidates[i] / event_counts[i] : 0.0) << " }";
+			output << ((i < EventTrace::N_kinds - 1) ? ",\n" : "\n");
+		}
+		output << indent << "  }\n";
+		output << indent << "}";
+	}
+
+	void Profiler::exportSummaryJSON(ostream& output, const vector<Profiler>& profiles) {
+		Profiler total;
+		for (const auto& item : profiles) {
+			total.merge(item);
+		}
+		output << "{\n";
+		output << "  \"N_procs\": " << profiles.size() << ",\n";
+		output << "  \"total\": ";
+		total.exportJSON(output, "  ");
+		output << ",\n";
+		output << "  \"procs\": [\n";
+		for (int i = 0; i < (int)profiles.size(); i++) {
+			output << "    ";
+			profiles[i].exportJSON(output, "    ");
+			output << ((i < (int)profiles.size() - 1) ? ",\n" : "\n");
+		}
+		output << "  ]\n";
+		output << "}\n";
+	}
+
+	string Profiler::getSectionName(const int section) {
+		static const string section_names[N_sections] = { "calculateCoulomb", "calculateExcitonEvents", "calculatePolaronEvents", "chooseNextEvent",
+			"findRecalcObjects", "updateSteadyData", "updateTransientData" };
+		if (section < 0 || section >= N_sections) {
+			return "";
+		}
+		return section_names[section];
+	}
+
+	bool Profiler::isEnabled() {
+#ifdef EXCIMONTEC_PROFILING
+		return true;
+#else
+		return false;
+#endif
+	}
+
+	void Profiler::merge(const Profiler& input) {
+		for (int i = 0; i < N_sections; i++) {
+			call_counts[i] += input.call_counts[i];
+			call_times[i] += input.call_times[i];
+			item_counts[i] += input.item_counts[i];
+		}
+		for (int i = 0; i < EventTrace::N_kinds; i++) {
+			event_counts[i] += input.event_counts[i];
+			event_candidates[i] += input.event_candidates[i];
+		}
+	}
+
+	vector<Profiler> MPI_gatherProfilers(const Profiler& input, MPI_Comm comm) {
+		int nproc;
+		int procid;
+		MPI_Comm_size(comm, &nproc);
+		MPI_Comm_rank(comm, &procid);
+		// Pack all of the data into one array so that it can be gathered in one call
+		vector<double> data;
+		for (auto vec_ptr : { &input.call_counts, &input.call_times, &input.item_counts, &input.event_counts, &input.event_candidates }) {
+			data.insert(data.end(), vec_ptr->begin(), vec_ptr->end());
+		}
+		int data_size = (int)data.size();
+		vector<double> data_all((procid == 0) ? (size_t)nproc * data_size : 0);
+		MPI_Gather(data.data(), data_size, MPI_DOUBLE, data_all.data(), data_size, MPI_DOUBLE, 0, comm);
+		vector<Profiler> profiles;
+		if (procid != 0) {
+			return profiles;
+		}
+		profiles.resize(nproc);
+		for (int i = 0; i < nproc; i++) {
+			auto data_it = data_all.begin() + (size_t)i * data_size;
+			for (auto vec_ptr : { &profiles[i].call_counts, &profiles[i].call_times, &profiles[i].item_counts, &profiles[i].event_counts, &profiles[i].event_candidates }) {
+				copy(data_it, data_it + vec_ptr->size(), vec_ptr->begin());
+				data_it += vec_ptr->size();
+			}
+		}
+		return profiles;
+	}
+
+}
@@ -0,0 +1,150 @@
+// Copyright (c) 2017-2019 Michael C. Heiber
+// This source file is part of the Excimontec project, which is subject to the MIT License.
+// For more information, see the LICENSE file that accompanies this software.
+// The Excimontec project can be found on Github at https://github.com/MikeHeiber/Excimontec
+
+#ifndef EXCIMONTEC_PROFILER_H
+#define EXCIMONTEC_PROFILER_H
+
+#include "EventTrace.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <mpi.h>
+#include <ostream>
+#include <string>
+#include <vector>
+
+// The profiling macros are only active when Excimontec is compiled with EXCIMONTEC_PROFILING defined (make PROFILE=1),
+// so the hot-path instrumentation has no cost in normal builds
+#ifdef EXCIMONTEC_PROFILING
+#define EXCIMONTEC_PROFILE_SCOPE(profiler, section) Excimontec::Profiler::ScopedTimer profile_scoped_timer((profiler), (section))
+#define EXCIMONTEC_PROFILE_ITEMS(profiler, section, n_items) (profiler).addItems((section), (double)(n_items))
+#define EXCIMONTEC_PROFILE_EVENT(profiler, kind) (profiler).addEvent(kind)
+#else
+#define EXCIMONTEC_PROFILE_SCOPE(profiler, section) ((void)0)
+#define EXCIMONTEC_PROFILE_ITEMS(profiler, section, n_items) ((void)0)
+#define EXCIMONTEC_PROFILE_EVENT(profiler, kind) ((void)0)
+#endif
+
+namespace Excimontec {
+
+	//! \brief This class accumulates the call counts and wall times of the hot-path functions of a simulation and the number of executed events of each type.
+	//! \details The data is collected through the EXCIMONTEC_PROFILE_SCOPE, EXCIMONTEC_PROFILE_ITEMS, and EXCIMONTEC_PROFILE_EVENT macros, which
+	//! are empty unless the code is compiled with EXCIMONTEC_PROFILING defined.  Each section also counts the items that it processes, which are
+	//! the candidate events of the event calculation functions, the events in the event list for chooseNextEvent, and the objects found by
+	//! findRecalcObjects.  Times are measured with std::chrono::steady_clock and include the time of any profiled
+	//! functions that are called within a section, such as the calculateCoulomb calls made by calculatePolaronEvents.
+	//! \copyright MIT License.  For more information, see the LICENSE file that accompanies this software package.
+	//! \author Michael C. Heiber
+	//! \date 2017-2019
+	class Profiler {
+	public:
+
+		//! Identifies the profiled section of the code.
+		enum Section : int {
+			Calculate_coulomb = 0,
+			Calculate_exciton_events,
+			Calculate_polaron_events,
+			Choose_next_event,
+			Find_recalc_objects,
+			Update_steady_data,
+			Update_transient_data,
+			N_sections
+		};
+
+		//! \brief This class measures the wall time from its construction to its destruction and adds it to one section of a profiler.
+		class ScopedTimer {
+		public:
+			//! \brief Starts the timer.
+			//! \param profiler is the profiler that the call is added to.
+			//! \param section is the section of the code that is timed.
+			ScopedTimer(Profiler& profiler, const Section section) : profiler_ref(profiler), section_index(section), time_start(std::chrono::steady_clock::now()) {}
+
+			//! \brief Stops the timer and adds the call and its duration to the profiler.
+			~ScopedTimer() {
+				profiler_ref.addCall(section_index, std::chrono::duration<double>(std::chrono::steady_clock::now() - time_start).count());
+			}
+
+			ScopedTimer(const ScopedTimer&) = delete;
+			ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+		private:
+			Profiler& profiler_ref;
+			Section section_index;
+			std::chrono::steady_clock::time_point time_start;
+		};
+
+		//! \brief Constructs a profiler with zero counts and times.
+		Profiler();
+
+		//! \brief Adds one call of a section and its duration.
+		//! \param section is the section of the code.
+		//! \param duration is the wall time of the call in seconds.
+		void addCall(const Section section, const double duration) {
+			call_counts[section] += 1.0;
+			call_times[section] += duration;
+		}
+
+		//! \brief Adds one executed event of the specified type.
+		//! \details The number of candidate events of the event is taken from the last item count of the Choose_next_event section.
+		//! \param kind is the type of the event.
+		void addEvent(const uint8_t kind) {
+			event_counts[kind] += 1.0;
+			event_candidates[kind] += items_last;
+		}
+
+		//! \brief Adds the number of items that were processed by one call of a section.
+		//! \param section is the section of the code.
+		//! \param n_items is the number of items.
+		void addItems(const Section section, const double n_items) {
+			item_counts[section] += n_items;
+			if (section == Choose_next_event) {
+				items_last = n_items;
+			}
+		}
+
+		//! \brief Resets all counts and times to zero.
+		void clear();
+
+		//! \brief Writes the profile data to a JSON object.
+		//! \param output is the output stream.
+		//! \param indent is the indentation that is added to every line after the first line.
+		void exportJSON(std::ostream& output, const std::string& indent = "") const;
+
+		//! \brief Writes the combined profile data of all processors and the profile data of each processor to a JSON object.
+		//! \param output is the output stream.
+		//! \param profiles is the vector of profiles of each processor.
+		static void exportSummaryJSON(std::ostream& output, const std::vector<Profiler>& profiles);
+
+		//! \brief Gets the name of a section, which is the name of the profiled function.
+		//! \param section is the section of the code.
+		//! \return The section name, or an empty string if the section is not valid.
+		static std::string getSectionName(const int section);
+
+		//! \brief Checks whether the profiling instrumentation was compiled in.
+		static bool isEnabled();
+
+		//! \brief Adds the counts and times from another profiler to this profiler.
+		//! \param input is the profiler to be merged.
+		void merge(const Profiler& input);
+
+	private:
+		friend std::vector<Profiler> MPI_gatherProfilers(const Profiler& input, MPI_Comm comm);
+		std::vector<double> call_counts;
+		std::vector<double> call_times;
+		std::vector<double> item_counts;
+		std::vector<double> event_counts;
+		std::vector<double> event_candidates;
+		double items_last = 0.0;
+	};
+
+	//! \brief Gathers the profilers from all processors in the communicator.
+	//! \param input is the profiler on the calling processor.
+	//! \param comm is the communicator of the processors whose profilers are gathered.
+	//! \return The vector of profilers ordered by processor rank on processor 0 of the communicator and an empty vector on all other processors.
+	std::vector<Profiler> MPI_gatherProfilers(const Profiler& input, MPI_Comm comm = MPI_COMM_WORLD);
+
+}
+
+#endif // EXCIMONTEC_PROFILER_H
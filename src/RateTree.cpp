@@ -0,0 +1,118 @@
+// Copyright (c) 2017-2019 Michael C. Heiber
+// This source file is part of the Excimontec project, which is subject to the MIT License.
+// For more information, see the LICENSE file that accompanies this software.
+// The Excimontec project can be found on Github at https://github.com/MikeHeiber/Excimontec
+
+#include "RateTree.h"
+
+using namespace std;
+
+namespace Excimontec {
+
+	const double RateTree::Drift_tolerance = 1e-9;
+
+	RateTree::RateTree() {
+
+	}
+
+	int RateTree::addSlot() {
+		if (!free_slots.empty()) {
+			int slot = free_slots.back();
+			free_slots.pop_back();
+			N_slots_used++;
+			return slot;
+		}
+		int slot = N_slots_used + (int)free_slots.size();
+		// Double the capacity when the tree is full so that the partial sums only need to be rebuilt O(log N) times while the tree grows
+		if (slot >= capacity) {
+			capacity = max(1, 2 * capacity);
+			N_levels = 1;
+			while ((1 << (N_levels - 1)) < capacity) {
+				N_levels++;
+			}
+			rates.resize(capacity, 0.0);
+			rebuild();
+		}
+		N_slots_used++;
+		return slot;
+	}
+
+	void RateTree::clear() {
+		capacity = 0;
+		N_levels = 0;
+		N_slots_used = 0;
+		update_magnitude = 0.0;
+		rates.clear();
+		tree.clear();
+		free_slots.clear();
+	}
+
+	int RateTree::findSlot(const double target) const {
+		// Descend the tree from the largest power of two, skipping every subtree whose partial sum is not larger than the remaining target
+		int index = 0;
+		// The target is kept below the total rate, and the bound check keeps the descent inside the tree when round-off error still leads past the last slot
+		double remaining = min(target, nextafter(getTotal(), 0.0));
+		for (int step = capacity; step > 0; step >>= 1) {
+			if (index + step <= capacity && tree[index + step] <= remaining) {
+				remaining -= tree[index + step];
+				index += step;
+			}
+		}
+		return index;
+	}
+
+	long int RateTree::getN_rebuilds() const {
+		return N_rebuilds;
+	}
+
+	int RateTree::getN_slots() const {
+		return N_slots_used;
+	}
+
+	double RateTree::getRate(const int slot) const {
+		return rates[slot];
+	}
+
+	void RateTree::rebuild() {
+		tree.assign(capacity + 1, 0.0);
+		for (int i = 1; i <= capacity; i++) {
+			tree[i] += rates[i - 1];
+			int parent = i + (i & -i);
+			if (parent <= capacity) {
+				tree[parent] += tree[i];
+			}
+		}
+		update_magnitude = 0.0;
+	}
+
+	void RateTree::removeSlot(const int slot) {
+		setRate(slot, 0.0);
+		free_slots.push_back(slot);
+		N_slots_used--;
+	}
+
+	int RateTree::sample(const double random_num) {
+		if (!(getTotal() > 0)) {
+			return -1;
+		}
+		int slot = findSlot(random_num*getTotal());
+		// Round-off error in the partial sums can lead to a slot with no rate or past the end of the tree, so the tree is rebuilt and sampled again
+		if (slot >= capacity || !(rates[slot] > 0)) {
+			N_rebuilds++;
+			rebuild();
+			if (!(getTotal() > 0)) {
+				return -1;
+			}
+			slot = findSlot(random_num*getTotal());
+			// A target at the top of the range can still round past the last slot with a nonzero rate
+			if (slot >= capacity || !(rates[slot] > 0)) {
+				slot = min(slot, capacity - 1);
+				while (slot > 0 && !(rates[slot] > 0)) {
+					slot--;
+				}
+			}
+		}
+		return slot;
+	}
+
+}
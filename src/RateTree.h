@@ -0,0 +1,102 @@
+// Copyright (c) 2017-2019 Michael C. Heiber
+// This source file is part of the Excimontec project, which is subject to the MIT License.
+// For more information, see the LICENSE file that accompanies this software.
+// The Excimontec project can be found on Github at https://github.com/MikeHeiber/Excimontec
+
+#ifndef EXCIMONTEC_RATE_TREE_H
+#define EXCIMONTEC_RATE_TREE_H
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+namespace Excimontec {
+
+	//! \brief This class stores a set of rates in a binary indexed (Fenwick) tree so that a rate can be changed and a slot can be sampled with a
+	//! probability proportional to its rate in O(log N) time.
+	//! \details Each rate is stored in a slot, and slots that are removed are reused by later calls to addSlot.  Changing a rate adds the
+	//! difference to the partial sums of the tree, which accumulates floating point round-off error, so the tree is rebuilt from the stored rates
+	//! whenever the upper bound of the accumulated error becomes larger than Drift_tolerance times the total rate.
+	//! \copyright MIT License.  For more information, see the LICENSE file that accompanies this software package.
+	//! \author Michael C. Heiber
+	//! \date 2017-2019
+	class RateTree {
+	public:
+
+		//! The largest accumulated round-off error of the partial sums, relative to the total rate, that is allowed before the tree is rebuilt.
+		static const double Drift_tolerance;
+
+		//! \brief Constructs an empty rate tree with no slots.
+		RateTree();
+
+		//! \brief Adds a new slot with a rate of zero.
+		//! \return The index of the new slot.
+		int addSlot();
+
+		//! \brief Removes all slots and rates from the tree.
+		void clear();
+
+		//! \brief Gets the number of times that the tree has been rebuilt, not including the rebuilds caused by adding slots.
+		long int getN_rebuilds() const;
+
+		//! \brief Gets the number of slots that are in use.
+		int getN_slots() const;
+
+		//! \brief Gets the rate of a slot.
+		//! \param slot is the index of the slot.
+		double getRate(const int slot) const;
+
+		//! \brief Gets the sum of the rates of all slots.
+		double getTotal() const {
+			return tree.empty() ? 0.0 : tree.back();
+		}
+
+		//! \brief Recalculates all partial sums of the tree from the stored rates, which removes the accumulated round-off error.
+		void rebuild();
+
+		//! \brief Removes a slot so that it can be reused by a later call to addSlot.
+		//! \param slot is the index of the slot.
+		void removeSlot(const int slot);
+
+		//! \brief Chooses a slot with a probability proportional to its rate.
+		//! \param random_num is a uniform random number in the range [0,1], where a target that reaches the total rate chooses the last slot with a nonzero rate.
+		//! \return The index of the chosen slot, or -1 if the total rate is not positive.
+		int sample(const double random_num);
+
+		//! \brief Changes the rate of a slot and updates the partial sums of the tree.
+		//! \param slot is the index of the slot.
+		//! \param rate is the new rate, which must not be negative.
+		void setRate(const int slot, const double rate) {
+			const double delta = rate - rates[slot];
+			rates[slot] = rate;
+			for (int i = slot + 1; i <= capacity; i += (i & -i)) {
+				tree[i] += delta;
+			}
+			// Each update can add a round-off error of up to one epsilon of the total rate on every level of the tree
+			update_magnitude += N_levels*(std::abs(delta) + getTotal());
+			if (std::numeric_limits<double>::epsilon()*update_magnitude > Drift_tolerance*getTotal()) {
+				N_rebuilds++;
+				rebuild();
+			}
+		}
+
+	private:
+		// The number of slots that the tree can hold without being resized, which is always a power of two
+		int capacity = 0;
+		int N_levels = 0;
+		int N_slots_used = 0;
+		long int N_rebuilds = 0;
+		// Sum of the magnitudes of the partial sums changed since the last rebuild, used to bound the accumulated round-off error
+		double update_magnitude = 0.0;
+		std::vector<double> rates;
+		// One-indexed partial sums with tree[capacity] holding the total rate
+		std::vector<double> tree;
+		std::vector<int> free_slots;
+
+		int findSlot(const double target) const;
+	};
+
+}
+
+#endif // EXCIMONTEC_RATE_TREE_H
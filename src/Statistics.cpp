@@ -0,0 +1,137 @@
+// Copyright (c) 2017-2019 Michael C. Heiber
+// This source file is part of the Excimontec project, which is subject to the MIT License.
+// For more information, see the LICENSE file that accompanies this software.
+// The Excimontec project can be found on Github at https://github.com/MikeHeiber/Excimontec
+
+#include "Statistics.h"
+
+using namespace std;
+
+namespace Excimontec {
+
+	Statistics::Statistics() {
+
+	}
+
+	void Statistics::add(const double value) {
+		Count += 1.0;
+		double delta = value - Mean;
+		Mean += delta / Count;
+		M2 += delta * (value - Mean);
+		if (value < Min) {
+			Min = value;
+		}
+		if (value > Max) {
+			Max = value;
+		}
+	}
+
+	void Statistics::clear() {
+		*this = Statistics();
+	}
+
+	double Statistics::getCount() const {
+		return Count;
+	}
+
+	double Statistics::getMax() const {
+		return (Count > 0.0) ? Max : NAN;
+	}
+
+	double Statistics::getMean() const {
+		return (Count > 0.0) ? Mean : NAN;
+	}
+
+	double Statistics::getMin() const {
+		return (Count > 0.0) ? Min : NAN;
+	}
+
+	double Statistics::getStdev() const {
+		return (Count > 1.0) ? sqrt(M2 / (Count - 1.0)) : NAN;
+	}
+
+	void Statistics::merge(const Statistics& input) {
+		if (!(input.Count > 0.0)) {
+			return;
+		}
+		if (!(Count > 0.0)) {
+			*this = input;
+			return;
+		}
+		// Combine the moments of the two data sets using the parallel form of Welford's algorithm
+		double count_total = Count + input.Count;
+		double delta = input.Mean - Mean;
+		Mean += delta * input.Count / count_total;
+		M2 += input.M2 + delta * delta*Count*input.Count / count_total;
+		Count = count_total;
+		Min = min(Min, input.Min);
+		Max = max(Max, input.Max);
+	}
+
+	void Statistics::pack(double* data) const {
+		data[0] = Count;
+		data[1] = Mean;
+		data[2] = M2;
+		data[3] = Min;
+		data[4] = Max;
+	}
+
+	bool Statistics::readBinary(istream& input) {
+		double data[N_values];
+		if (!input.read(reinterpret_cast<char*>(data), sizeof(data))) {
+			return false;
+		}
+		unpack(data);
+		return true;
+	}
+
+	void Statistics::unpack(const double* data) {
+		Count = data[0];
+		Mean = data[1];
+		M2 = data[2];
+		Min = data[3];
+		Max = data[4];
+	}
+
+	void Statistics::writeBinary(ostream& output) const {
+		double data[N_values];
+		pack(data);
+		output.write(reinterpret_cast<const char*>(data), sizeof(data));
+	}
+
+	Statistics MPI_mergeStatistics(const Statistics& input, MPI_Comm comm) {
+		int procid;
+		MPI_Comm_rank(comm, &procid);
+		// Each statistics object is sent as a contiguous block of doubles
+		MPI_Datatype stats_type;
+		MPI_Type_contiguous(Statistics::N_values, MPI_DOUBLE, &stats_type);
+		MPI_Type_commit(&stats_type);
+		// The custom reduction merges the statistics of each element of invec into the corresponding element of inoutvec
+		MPI_Op merge_op;
+		MPI_Op_create([](void* invec, void* inoutvec, int* len, MPI_Datatype*) {
+			double* in = static_cast<double*>(invec);
+			double* inout = static_cast<double*>(inoutvec);
+			for (int i = 0; i < *len; i++) {
+				Statistics stats_in;
+				Statistics stats_inout;
+				stats_in.unpack(in + i * Statistics::N_values);
+				stats_inout.unpack(inout + i * Statistics::N_values);
+				stats_inout.merge(stats_in);
+				stats_inout.pack(inout + i * Statistics::N_values);
+			}
+		}, 1, &merge_op);
+		double data_in[Statistics::N_values];
+		double data_out[Statistics::N_values];
+		input.pack(data_in);
+		MPI_Reduce(data_in, data_out, 1, stats_type, merge_op, 0, comm);
+		MPI_Op_free(&merge_op);
+		MPI_Type_free(&stats_type);
+		if (procid != 0) {
+			return input;
+		}
+		Statistics output;
+		output.unpack(data_out);
+		return output;
+	}
+
+}
@@ -0,0 +1,91 @@
+// Copyright (c) 2017-2019 Michael C. Heiber
+// This source file is part of the Excimontec project, which is subject to the MIT License.
+// For more information, see the LICENSE file that accompanies this software.
+// The Excimontec project can be found on Github at https://github.com/MikeHeiber/Excimontec
+
+#ifndef EXCIMONTEC_STATISTICS_H
+#define EXCIMONTEC_STATISTICS_H
+
+#include <algorithm>
+#include <cmath>
+#include <istream>
+#include <limits>
+#include <mpi.h>
+#include <ostream>
+
+namespace Excimontec {
+
+	//! \brief This class accumulates the count, mean, standard deviation, minimum, and maximum of a data set one value at a time without storing the values.
+	//! \details The mean and variance are updated using Welford's algorithm, and the statistics from separate data sets can be merged.
+	//! \copyright MIT License.  For more information, see the LICENSE file that accompanies this software package.
+	//! \author Michael C. Heiber
+	//! \date 2017-2019
+	class Statistics {
+	public:
+
+		//! \brief Constructs an empty statistics object with no data.
+		Statistics();
+
+		//! \brief Adds a value to the data set.
+		//! \param value is the value to be added.
+		void add(const double value);
+
+		//! \brief Removes all data from the statistics object.
+		void clear();
+
+		//! \brief Gets the number of values that have been added.
+		//! \return The number of values in the data set.
+		double getCount() const;
+
+		//! \brief Gets the largest value that has been added.
+		//! \return The maximum value, or NAN if no values have been added.
+		double getMax() const;
+
+		//! \brief Gets the average of the values that have been added.
+		//! \return The mean value, or NAN if no values have been added.
+		double getMean() const;
+
+		//! \brief Gets the smallest value that has been added.
+		//! \return The minimum value, or NAN if no values have been added.
+		double getMin() const;
+
+		//! \brief Gets the sample standard deviation of the values that have been added.
+		//! \return The standard deviation, or NAN if less than two values have been added.
+		double getStdev() const;
+
+		//! \brief Adds the data set from another statistics object to this one.
+		//! \param input is the statistics object to be merged.
+		void merge(const Statistics& input);
+
+		//! \brief Reads the data set summary from a binary stream that was written by writeBinary.
+		//! \param input is the input stream.
+		//! \return true if the data was read successfully.
+		//! \return false if the stream ended before all of the data could be read.
+		bool readBinary(std::istream& input);
+
+		//! \brief Writes the data set summary to a binary stream in the native byte order.
+		//! \param output is the output stream.
+		void writeBinary(std::ostream& output) const;
+
+	private:
+		friend Statistics MPI_mergeStatistics(const Statistics& input, MPI_Comm comm);
+		static const int N_values = 5;
+		double Count = 0.0;
+		double Mean = 0.0;
+		// Sum of squared differences from the mean
+		double M2 = 0.0;
+		double Min = std::numeric_limits<double>::infinity();
+		double Max = -std::numeric_limits<double>::infinity();
+		void pack(double* data) const;
+		void unpack(const double* data);
+	};
+
+	//! \brief Merges the statistics from all processors in the communicator using a custom MPI reduction operation.
+	//! \param input is the statistics object on the calling processor.
+	//! \param comm is the communicator of the processors whose statistics are merged.
+	//! \return The merged statistics on processor 0 of the communicator and the unchanged input statistics on all other processors.
+	Statistics MPI_mergeStatistics(const Statistics& input, MPI_Comm comm = MPI_COMM_WORLD);
+
+}
+
+#endif // EXCIMONTEC_STATISTICS_H
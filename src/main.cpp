@@ -3,6 +3,7 @@
 // For more information, see the LICENSE file that accompanies this software.
 // The Excimontec project can be found on Github at https://github.com/MikeHeiber/Excimontec
 
+#include "EventTrace.h"
 #include "OSC_Sim.h"
 #include "Parameters.h"
 #include <mpi.h>
@@ -12,92 +13,428 @@
 #include <vector>
 #include <ctime>
 #include <functional>
+#include <map>
+#include <numeric>
+#include <sstream>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <cerrno>
+#include <csignal>
+#include <sys/stat.h>
+#ifdef _WIN32
+#define NOMINMAX
+#include <direct.h>
+#include <windows.h>
+#else
+#include <dirent.h>
+#include <unistd.h>
+#endif
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
 
 using namespace std;
 using namespace Excimontec;
 using namespace KMC_Lattice;
 
-int main(int argc, char *argv[]) {
-	string version = "v1.0.0-rc.4";
+const string version = "v1.0.0-rc.4";
+
+// Flags that are set by the signal handler when a checkpoint or a checkpoint followed by a stop is requested
+volatile sig_atomic_t checkpoint_signal = 0;
+volatile sig_atomic_t stop_signal = 0;
+
+//! \brief Handles the signals that request a checkpoint (SIGUSR1) or a checkpoint followed by a stop of the simulation (SIGTERM).
+void handleCheckpointSignal(const int signal_number) {
+	if (signal_number == SIGTERM) {
+		stop_signal = 1;
+	}
+	else {
+		checkpoint_signal = 1;
+	}
+}
+
+//! \brief Opens the binary event trace file of a simulation and connects the event trace to the simulation.
+//! \details Each simulation writes its events to its own trace file named trace#.bin, where # is the simulation ID.
+//! \param sim is the initialized simulation whose events are recorded.
+//! \param trace is the event trace to be opened.
+//! \param params specifies the lattice dimensions that are stored in the trace file header.
+//! \param sim_id is the simulation ID number.
+//! \return true if the event trace file was created successfully.
+//! \return false if the event trace file could not be created.
+bool openEventTrace(OSC_Sim& sim, EventTrace& trace, const Parameters& params, const int sim_id) {
+	string trace_filename = "trace" + to_string(sim_id) + ".bin";
+	if (!trace.open(trace_filename, params.Params_lattice.Length, params.Params_lattice.Width, params.Params_lattice.Height)) {
+		cout << sim_id << ": Error! Event trace file " << trace_filename << " could not be created." << endl;
+		return false;
+	}
+	sim.setEventTrace(&trace);
+	return true;
+}
+
+//! \brief Pins the calling thread to one of the CPU cores that the process is allowed to run on.
+//! \details Threads are assigned to the allowed cores in order, so when the MPI launcher binds each process to a NUMA domain, the threads of
+//! each process stay within that domain and the memory that each thread touches first is allocated on the local memory node.
+//! Thread pinning is only supported on Linux and has no effect on other platforms.
+//! \param thread_index is the index of the calling thread within the process.
+void pinThread(const int thread_index) {
+#ifdef __linux__
+	cpu_set_t allowed_set;
+	if (sched_getaffinity(0, sizeof(cpu_set_t), &allowed_set) != 0) {
+		return;
+	}
+	int target = thread_index % CPU_COUNT(&allowed_set);
+	for (int i = 0, n = 0; i < CPU_SETSIZE; i++) {
+		if (CPU_ISSET(i, &allowed_set)) {
+			if (n == target) {
+				cpu_set_t core_set;
+				CPU_ZERO(&core_set);
+				CPU_SET(i, &core_set);
+				pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &core_set);
+				return;
+			}
+			n++;
+		}
+	}
+#endif
+}
+
+//! Status of a simulation run that is returned by runSimulation.
+enum class RunStatus {
+	//! The simulation run finished without any errors.
+	Finished,
+	//! The simulation run finished, but an error occurred on one or more processors.
+	Error,
+	//! The simulation run was stopped before the simulation started because of invalid input.
+	Aborted,
+	//! The simulation run was stopped by a signal after checkpoints were written.
+	Stopped
+};
+
+//! \brief Sums the input vectors from all processors in the communicator.
+//! \param input is the vector on the calling processor, which must be the same size on all processors.
+//! \param comm is the communicator of the processors whose vectors are summed.
+//! \return The element-wise sum on processor 0 of the communicator and the unchanged input vector on all other processors.
+vector<int> MPI_calculateVectorSum(const vector<int>& input, MPI_Comm comm) {
+	int procid;
+	MPI_Comm_rank(comm, &procid);
+	vector<int> output(input.size(), 0);
+	MPI_Reduce(input.data(), output.data(), (int)input.size(), MPI_INT, MPI_SUM, 0, comm);
+	return (procid == 0) ? output : input;
+}
+
+//! \brief Sums the input vectors from all processors in the communicator.
+//! \param input is the vector on the calling processor, which must be the same size on all processors.
+//! \param comm is the communicator of the processors whose vectors are summed.
+//! \return The element-wise sum on processor 0 of the communicator and the unchanged input vector on all other processors.
+vector<double> MPI_calculateVectorSum(const vector<double>& input, MPI_Comm comm) {
+	int procid;
+	MPI_Comm_rank(comm, &procid);
+	vector<double> output(input.size(), 0.0);
+	MPI_Reduce(input.data(), output.data(), (int)input.size(), MPI_DOUBLE, MPI_SUM, 0, comm);
+	return (procid == 0) ? output : input;
+}
+
+//! \brief Averages the second values of the input pair vectors from all processors in the communicator.
+//! \param input is the pair vector on the calling processor, which must have the same first values on all processors.
+//! \param comm is the communicator of the processors whose data is averaged.
+//! \return The averaged pair vector on processor 0 of the communicator and the unchanged input vector on all other processors.
+vector<pair<double, double>> MPI_calculatePairVectorAvg(const vector<pair<double, double>>& input, MPI_Comm comm) {
+	int nproc;
+	MPI_Comm_size(comm, &nproc);
+	vector<double> values(input.size(), 0.0);
+	for (int i = 0; i < (int)input.size(); i++) {
+		values[i] = input[i].second;
+	}
+	values = MPI_calculateVectorSum(values, comm);
+	auto output = input;
+	for (int i = 0; i < (int)output.size(); i++) {
+		output[i].second = values[i] / nproc;
+	}
+	return output;
+}
+
+//! \brief Gathers one value from each processor in the communicator.
+//! \param input is the value on the calling processor.
+//! \param comm is the communicator of the processors whose values are gathered.
+//! \return A vector of the values from all processors in rank order on processor 0 of the communicator and an empty vector on all other processors.
+vector<double> MPI_gatherValues(const double input, MPI_Comm comm) {
+	int nproc;
+	int procid;
+	MPI_Comm_size(comm, &nproc);
+	MPI_Comm_rank(comm, &procid);
+	vector<double> output((procid == 0) ? nproc : 0, 0.0);
+	MPI_Gather(&input, 1, MPI_DOUBLE, output.data(), 1, MPI_DOUBLE, 0, comm);
+	return output;
+}
+
+//! \brief Checks whether the input path is an absolute path.
+bool isAbsolutePath(const string& path) {
+#ifdef _WIN32
+	return (path.size() > 1 && (path[1] == ':' || (path[0] == '\\' && path[1] == '\\')));
+#else
+	return (!path.empty() && path[0] == '/');
+#endif
+}
+
+//! \brief Checks whether the input path is an existing directory.
+bool isDirectory(const string& path) {
+	struct stat info;
+	return (stat(path.c_str(), &info) == 0 && (info.st_mode & S_IFDIR) != 0);
+}
+
+//! \brief Creates a directory if it does not already exist.
+//! \return true if the directory exists after the function call.
+bool createDirectory(const string& path) {
+#ifdef _WIN32
+	_mkdir(path.c_str());
+#else
+	mkdir(path.c_str(), 0755);
+#endif
+	return isDirectory(path);
+}
+
+//! \brief Gets the current working directory.
+string getWorkingDirectory() {
+	char buffer[4096];
+#ifdef _WIN32
+	return (_getcwd(buffer, sizeof(buffer)) != NULL) ? string(buffer) : string(".");
+#else
+	return (getcwd(buffer, sizeof(buffer)) != NULL) ? string(buffer) : string(".");
+#endif
+}
+
+//! \brief Changes the current working directory.
+//! \return true if the working directory was changed successfully.
+bool setWorkingDirectory(const string& path) {
+#ifdef _WIN32
+	return (_chdir(path.c_str()) == 0);
+#else
+	return (chdir(path.c_str()) == 0);
+#endif
+}
+
+//! \brief Gets the name of a file without the directory and the file extension.
+string getFileStem(const string& path) {
+	size_t pos = path.find_last_of("/\\");
+	string name = (pos == string::npos) ? path : path.substr(pos + 1);
+	pos = name.find_last_of('.');
+	return (pos == string::npos || pos == 0) ? name : name.substr(0, pos);
+}
+
+//! \brief Gets the parameter file names for a batch of simulation runs.
+//! \param path is either a directory, in which case all .txt files in the directory are used in alphabetical order, or a text file that
+//! lists one parameter file per line, where empty lines and lines starting with # are skipped.
+//! \param filenames is the output vector of parameter file names.
+//! \return true if the parameter file names were read successfully.
+//! \return false if the path could not be read.
+bool getBatchParameterFiles(const string& path, vector<string>& filenames) {
+	filenames.clear();
+	if (isDirectory(path)) {
+#ifdef _WIN32
+		WIN32_FIND_DATAA file_data;
+		HANDLE find_handle = FindFirstFileA((path + "\\*.txt").c_str(), &file_data);
+		if (find_handle == INVALID_HANDLE_VALUE) {
+			return true;
+		}
+		do {
+			filenames.push_back(path + "\\" + file_data.cFileName);
+		} while (FindNextFileA(find_handle, &file_data));
+		FindClose(find_handle);
+#else
+		DIR* dir = opendir(path.c_str());
+		if (dir == NULL) {
+			return false;
+		}
+		struct dirent* entry;
+		while ((entry = readdir(dir)) != NULL) {
+			string name(entry->d_name);
+			if (name.size() > 4 && name.compare(name.size() - 4, 4, ".txt") == 0 && !isDirectory(path + "/" + name)) {
+				filenames.push_back(path + "/" + name);
+			}
+		}
+		closedir(dir);
+#endif
+		sort(filenames.begin(), filenames.end());
+		return true;
+	}
+	ifstream listfile(path);
+	if (!listfile.good()) {
+		return false;
+	}
+	string line;
+	while (getline(listfile, line)) {
+		// Remove trailing whitespace and carriage returns
+		line.erase(line.find_last_not_of(" \t\r") + 1);
+		if (line.empty() || line[0] == '#') {
+			continue;
+		}
+		filenames.push_back(line);
+	}
+	return true;
+}
+
+//! \brief Gets the peak resident memory usage of the process.
+//! \details The peak memory usage is only available on Linux.
+//! \return The peak resident memory usage in MB, or -1 if it is not available.
+double getPeakMemoryUsage() {
+#ifdef __linux__
+	ifstream statusfile("/proc/self/status");
+	string line;
+	while (getline(statusfile, line)) {
+		if (line.compare(0, 6, "VmHWM:") == 0) {
+			return stod(line.substr(6)) / 1024.0;
+		}
+	}
+#endif
+	return -1.0;
+}
+
+//! \brief Resets the peak resident memory usage of the process to the current resident memory usage.
+//! \details Resetting the peak memory usage is only supported on Linux and has no effect on other platforms.
+void resetPeakMemoryUsage() {
+#ifdef __linux__
+	ofstream clearfile("/proc/self/clear_refs");
+	clearfile << "5";
+#endif
+}
+
+//! \brief Imports the event rates of each case from an earlier benchmark results file.
+//! \param filename is the name of the benchmark_results.txt file that is used as the baseline.
+//! \param event_rates is the output map from the case name to the number of events executed per second.
+//! \return true if the baseline file was imported successfully.
+//! \return false if the baseline file could not be opened or does not contain any benchmark cases.
+bool importBenchmarkBaseline(const string& filename, map<string, double>& event_rates) {
+	event_rates.clear();
+	ifstream baselinefile(filename);
+	if (!baselinefile.good()) {
+		return false;
+	}
+	string line;
+	// Skip the header lines until the column names are found
+	while (getline(baselinefile, line) && line.compare(0, 5, "Case,") != 0) {}
+	while (getline(baselinefile, line)) {
+		stringstream linestream(line);
+		vector<string> values;
+		string value;
+		while (getline(linestream, value, ',')) {
+			values.push_back(value);
+		}
+		if (values.size() < 5) {
+			continue;
+		}
+		try {
+			event_rates[values[0]] = stod(values[4]);
+		}
+		catch (exception&) {
+			continue;
+		}
+	}
+	return !event_rates.empty();
+}
+
+//! \brief Runs the simulation that is defined by one parameter file on all processors in the communicator.
+//! \details Each processor in the communicator runs one simulation, or several simulation replicas in multi-threaded mode, and the results
+//! from all processors in the communicator are combined and written to the output directory.
+//! \param params contains the options that were set by command line arguments, which are kept when the parameter file is imported.
+//! \param parameter_filename is the name of the parameter file.
+//! \param output_dir is the directory where all output files are written, which is created if it does not exist.  An empty string
+//! specifies the current working directory.  The working directory is not changed back when the run ends.
+//! \param comm is the communicator of the processors that run the simulation.
+//! \return The status of the simulation run.
+RunStatus runSimulation(Parameters params, const string& parameter_filename, const string& output_dir, MPI_Comm comm) {
 	// Parameters
 	bool End_sim = false;
 	// File declaration
 	ifstream parameterfile;
 	ofstream logfile;
+	EventTrace event_trace;
 	ofstream resultsfile;
 	ofstream analysisfile;
 	// Initialize variables
 	string logfilename;
-	Parameters params;
 	int nproc = 1;
 	int procid = 0;
 	int elapsedtime;
 	time_t time_start, time_end;
 	bool success;
 	bool all_finished = false;
-	vector<bool> proc_finished;
 	vector<bool> error_status_vec;
 	vector<string> error_messages;
 	char error_found = (char)0;
 	// Start timer
 	time_start = time(NULL);
-	// Check command line arguments
-	if (argc < 2) {
-		cout << "Error! You must input the parameter file name as a command line argument." << endl;
-		return 0;
-	}
-	// Check for command line enabled logging
-	// Set default
-	params.Enable_logging = false;
-	if (argc == 3) {
-		string argument(argv[2]);
-		if (argument.compare("-enable_logging") == 0) {
-			params.Enable_logging = true;
-		}
-		else {
-			cout << "Error! Invalid command line argument." << endl;
-			return 0;
-		}
-	}
-	// Check for too many command line arguments
-	if (argc > 3) {
-		cout << "Error! Too many command line arguments." << endl;
-		return 0;
-	}
-	// Import parameters and options from parameter file and command line arguments
+	// Import parameters from the parameter file, while keeping the options that were set by command line arguments
 	cout << "Loading input parameters from file... " << endl;
-	parameterfile.open(argv[1], ifstream::in);
+	parameterfile.open(parameter_filename, ifstream::in);
 	if (!parameterfile.good()) {
 		cout << "Error loading parameter file.  Program will now exit." << endl;
-		return 0;
+		return RunStatus::Aborted;
 	}
 	success = params.importParameters(parameterfile);
 	parameterfile.close();
 	if (!success) {
 		cout << "Error importing parameters from parameter file.  Program will now exit." << endl;
-		return 0;
+		return RunStatus::Aborted;
 	}
 	cout << "Parameter loading complete!" << endl;
-	// Initialize mpi options
-	cout << "Initializing MPI options... ";
-	MPI_Init(&argc, &argv);
-	MPI_Comm_size(MPI_COMM_WORLD, &nproc);
-	MPI_Comm_rank(MPI_COMM_WORLD, &procid);
-	cout << procid << ": MPI initialization complete!" << endl;
+	// Check the dynamic test distribution options
+	if (params.Test_chunk_size > 0 && params.Enable_steady_transport_test) {
+		cout << "Error! Dynamic test distribution cannot be used with the steady state charge transport test." << endl;
+		return RunStatus::Aborted;
+	}
+	if (params.Test_chunk_size > params.N_tests) {
+		cout << "Error! The test chunk size cannot be larger than the number of tests." << endl;
+		return RunStatus::Aborted;
+	}
+	// Check the multi-threaded mode options
+	if (params.N_threads > 1 && params.Enable_steady_transport_test) {
+		cout << "Error! Multi-threaded mode cannot be used with the steady state charge transport test." << endl;
+		return RunStatus::Aborted;
+	}
+	if (params.N_threads > 1 && params.Test_chunk_size > 0) {
+		cout << "Error! Multi-threaded mode cannot be used with dynamic test distribution." << endl;
+		return RunStatus::Aborted;
+	}
+	// Check the checkpoint options
+	if ((params.Checkpoint_interval > 0 || params.Enable_restart) && params.Test_chunk_size > 0) {
+		cout << "Error! Checkpoints cannot be used with dynamic test distribution." << endl;
+		return RunStatus::Aborted;
+	}
+	MPI_Comm_size(comm, &nproc);
+	MPI_Comm_rank(comm, &procid);
+	// Change to the output directory
+	// Relative file paths in the parameter file are converted to absolute paths first, so that they still refer to the original working directory
+	if (!output_dir.empty()) {
+		string working_dir = getWorkingDirectory();
+		auto makeAbsolute = [&working_dir](string& path) {
+			if (!path.empty() && !isAbsolutePath(path)) {
+				path = working_dir + "/" + path;
+			}
+		};
+		makeAbsolute(params.Morphology_filename);
+		makeAbsolute(params.Morphology_set_format);
+		makeAbsolute(params.Energies_import_filename);
+		if (!createDirectory(output_dir) || !setWorkingDirectory(output_dir)) {
+			cout << procid << ": Error! The output directory " << output_dir << " could not be created." << endl;
+			return RunStatus::Aborted;
+		}
+	}
 	// Initialize error monitoring vectors
-	proc_finished.assign(nproc, false);
 	error_status_vec.assign(nproc, false);
 	error_messages.assign(nproc, "");
 	// Morphology set import handling
 	if (params.Enable_import_morphology_set && params.N_test_morphologies > nproc) {
 		cout << "Error! The number of requested processors cannot be less than the number of morphologies tested." << endl;
 		cout << "You have requested " << nproc << " processors for " << params.N_test_morphologies << " morphologies." << endl;
-		return 0;
+		return RunStatus::Aborted;
 	}
 	if (params.Enable_import_morphology_set && params.N_test_morphologies > params.N_morphology_set_size) {
 		cout << "Error! The number of tested morphologies cannot be greater than the number of morphologies in the set." << endl;
 		cout << "You have asked to test " << params.N_test_morphologies << " morphologies out of a " << params.N_morphology_set_size << " morphology set." << endl;
-		return 0;
+		return RunStatus::Aborted;
 	}
 	if (params.Enable_import_morphology_set) {
 		int* selected_morphologies = new int[nproc];
@@ -126,8 +463,8 @@ int main(int argc, char *argv[]) {
 				morphology_set.pop_back();
 			}
 		}
-		MPI_Barrier(MPI_COMM_WORLD);
-		MPI_Bcast(selected_morphologies, nproc, MPI_INT, 0, MPI_COMM_WORLD);
+		MPI_Barrier(comm);
+		MPI_Bcast(selected_morphologies, nproc, MPI_INT, 0, comm);
 		// Parse input morphology set file format
 		int pos = (int)params.Morphology_set_format.find("#");
 		string prefix = params.Morphology_set_format.substr(0, pos);
@@ -140,18 +477,149 @@ int main(int argc, char *argv[]) {
 	}
 	// Setup file output
 	cout << procid << ": Creating output files..." << endl;
-	if (params.Enable_logging) {
+	if (params.Enable_logging && params.N_threads == 1) {
 		logfilename = "log" + to_string(procid) + ".txt";
 		logfile.open(logfilename);
 	}
 	params.Logfile = &logfile;
 	// Initialize Simulation
 	cout << procid << ": Initializing simulation " << procid << "..." << endl;
-	OSC_Sim sim;
-	success = sim.init(params, procid);
-	if (!success) {
-		cout << procid << ": Initialization failed, simulation will now terminate." << endl;
-		return 0;
+	// Setup dynamic test distribution
+	// The total number of tests is N_tests on each proc, and each proc starts with one chunk of tests
+	// Additional chunks are handed out by atomically incrementing a counter of assigned tests that is located on proc 0
+	int N_tests_total = params.N_tests * nproc;
+	bool tests_exhausted = true;
+	MPI_Win tests_win = MPI_WIN_NULL;
+	if (params.Test_chunk_size > 0) {
+		int* tests_assigned_ptr;
+		MPI_Win_allocate((procid == 0) ? (MPI_Aint)sizeof(int) : 0, sizeof(int), MPI_INFO_NULL, comm, &tests_assigned_ptr, &tests_win);
+		if (procid == 0) {
+			MPI_Win_lock(MPI_LOCK_EXCLUSIVE, 0, 0, tests_win);
+			*tests_assigned_ptr = nproc * params.Test_chunk_size;
+			MPI_Win_unlock(0, tests_win);
+		}
+		MPI_Barrier(comm);
+		params.N_tests = params.Test_chunk_size;
+		tests_exhausted = false;
+	}
+	// In multi-threaded mode, each thread runs its own simulation replica with a separate ID and random number stream
+	// Only the main thread makes MPI calls, and it monitors the replicas through the atomic counters below
+	vector<OSC_Sim> sims(params.N_threads);
+	OSC_Sim& sim = sims[0];
+	// Each simulation has its own checkpoint file, and when restarts are enabled, a simulation is restarted from its checkpoint file if it exists
+	auto getCheckpointFilename = [](const int sim_id) {
+		return "checkpoint" + to_string(sim_id) + ".bin";
+	};
+	auto initializeSim = [&getCheckpointFilename](OSC_Sim& sim_target, const Parameters& params_target, const int sim_id) {
+		if (params_target.Enable_restart && ifstream(getCheckpointFilename(sim_id)).good()) {
+			cout << sim_id << ": Restarting simulation from " << getCheckpointFilename(sim_id) << "..." << endl;
+			return sim_target.importCheckpoint(params_target, sim_id, getCheckpointFilename(sim_id));
+		}
+		return sim_target.init(params_target, sim_id);
+	};
+	atomic<int> N_checkpoint_requests(0);
+	vector<thread> replica_threads;
+	vector<char> replica_success(params.N_threads, (char)1);
+	atomic<int> N_replicas_initialized(0);
+	atomic<int> N_replicas_running(params.N_threads);
+	atomic<int> N_replica_errors(0);
+	atomic<bool> stop_replicas(false);
+	// The Coulomb table and the imported site energies are identical for all replicas, so they are created once and shared by the replicas
+	shared_ptr<const OSC_Sim::SharedData> shared_data;
+	if (params.N_threads > 1) {
+		shared_data = OSC_Sim::createSharedData(params);
+	}
+	auto runReplica = [&](const int thread_index) {
+		// Each replica is initialized by its own pinned thread so that its data is allocated on the local memory node
+		pinThread(thread_index);
+		OSC_Sim& replica = sims[thread_index];
+		int replica_id = procid * params.N_threads + thread_index;
+		Parameters params_replica = params;
+		ofstream replica_logfile;
+		string replica_logfilename = "log" + to_string(replica_id) + ".txt";
+		if (params.Enable_logging) {
+			replica_logfile.open(replica_logfilename);
+		}
+		params_replica.Logfile = &replica_logfile;
+		EventTrace replica_trace;
+		replica.setSharedData(shared_data);
+		bool replica_ok = initializeSim(replica, params_replica, replica_id);
+		if (!replica_ok) {
+			cout << replica_id << ": Initialization failed, simulation will now terminate." << endl;
+		}
+		else if (params.Enable_event_trace) {
+			replica_ok = openEventTrace(replica, replica_trace, params, replica_id);
+		}
+		replica_success[thread_index] = replica_ok ? (char)1 : (char)0;
+		N_replicas_initialized++;
+		auto checkpoint_time_prev = chrono::steady_clock::now();
+		int checkpoint_requests_done = 0;
+		while (replica_ok && !stop_replicas && !replica.checkFinished()) {
+			replica_ok = replica.executeNextEvent();
+			if (!replica_ok) {
+				cout << replica_id << ": Event execution failed, simulation will now terminate." << endl;
+			}
+			// Output status
+			if (replica.getN_events_executed() % 1000000 == 0) {
+				replica.outputStatus();
+			}
+			// Write a checkpoint when the checkpoint interval has elapsed or when a checkpoint is requested by a signal
+			if (params.Checkpoint_interval > 0 && replica_ok && replica.getN_events_executed() % 1000 == 0) {
+				if (checkpoint_requests_done < N_checkpoint_requests || chrono::duration<double>(chrono::steady_clock::now() - checkpoint_time_prev).count() >= params.Checkpoint_interval) {
+					replica.exportCheckpoint(getCheckpointFilename(replica_id));
+					checkpoint_time_prev = chrono::steady_clock::now();
+					checkpoint_requests_done = N_checkpoint_requests;
+				}
+			}
+			// Reset logfile
+			if (params.Enable_logging) {
+				if (replica.getN_events_executed() % 1000 == 0) {
+					replica_logfile.close();
+					replica_logfile.open(replica_logfilename);
+				}
+			}
+		}
+		if (!replica_ok) {
+			replica_success[thread_index] = (char)0;
+			N_replica_errors++;
+		}
+		replica.setEventTrace(nullptr);
+		N_replicas_running--;
+	};
+	if (params.N_threads == 1) {
+		success = initializeSim(sim, params, procid);
+		if (success && params.Enable_event_trace) {
+			success = openEventTrace(sim, event_trace, params, procid);
+		}
+	}
+	else {
+		for (int i = 0; i < params.N_threads; i++) {
+			replica_threads.push_back(thread(runReplica, i));
+		}
+		while (N_replicas_initialized < params.N_threads) {
+			this_thread::sleep_for(chrono::milliseconds(1));
+		}
+		success = all_of(replica_success.begin(), replica_success.end(), [](const char status) { return status == (char)1; });
+	}
+	// All procs must agree on the initialization status, so that all procs of the communicator leave the run together when any proc fails
+	int init_success_local = success ? 1 : 0;
+	int init_success_global = 0;
+	MPI_Allreduce(&init_success_local, &init_success_global, 1, MPI_INT, MPI_LAND, comm);
+	if (init_success_global == 0) {
+		stop_replicas = true;
+		for (auto& item : replica_threads) {
+			item.join();
+		}
+		if (tests_win != MPI_WIN_NULL) {
+			MPI_Win_free(&tests_win);
+		}
+		if (!success) {
+			cout << procid << ": Initialization failed, simulation will now terminate." << endl;
+		}
+		else {
+			cout << procid << ": Initialization failed on another processor, simulation will now terminate." << endl;
+		}
+		return RunStatus::Aborted;
 	}
 	cout << procid << ": Simulation initialization complete" << endl;
 	if (params.Enable_exciton_diffusion_test) {
@@ -170,101 +638,170 @@ int main(int argc, char *argv[]) {
 		cout << procid << ": Starting steady state charge transport test..." << endl;
 	}
 	// Begin Simulation loop
-	// Simulation ends for all procs with procid >0 when End_sim is true
-	// Proc 0 only ends when End_sim is true and all_finished is true
-	while (!End_sim || (procid == 0 && !all_finished)) {
-		if (!End_sim) {
-			success = sim.executeNextEvent();
-			if (!success) {
-				cout << procid << ": Event execution failed, simulation will now terminate." << endl;
-			}
-			End_sim = sim.checkFinished();
-		}
-		// Check for errors
-		if (!success || sim.getN_events_executed() % 500000 == 0 || End_sim) {
-			// Send completion status, error status, message length, and message content to proc 0
-			char finished_status;
-			char error_status;
-			char msg_length;
-			for (int i = 1; i < nproc; i++) {
-				// Send status messages to proc 0
-				if (procid == i) {
-					finished_status = End_sim ? (char)1 : (char)0;
-					error_status = !success ? (char)1 : (char)0;
-					MPI_Send(&error_status, 1, MPI_CHAR, 0, i, MPI_COMM_WORLD);
-					// If the proc has an error, send the error message to proc 0
-					if (!success) {
-						msg_length = (char)sim.getErrorMessage().size();
-						MPI_Send(&msg_length, 1, MPI_CHAR, 0, i, MPI_COMM_WORLD);
-						char* error_msg = &sim.getErrorMessage()[0];
-						MPI_Send(&error_msg, (int)msg_length, MPI_CHAR, 0, i, MPI_COMM_WORLD);
-					}
-					MPI_Send(&finished_status, 1, MPI_CHAR, 0, i, MPI_COMM_WORLD);
+	// Completion and error status is exchanged between all procs with a nonblocking reduction that is polled without stopping the simulation
+	// Finished procs keep taking part in the status exchanges until all procs are finished
+	// Simulation ends for all procs when a completed status exchange shows that all procs are finished or that an error has occurred
+	MPI_Request status_request = MPI_REQUEST_NULL;
+	int status_local[3] = { 0, 0, 0 };
+	int status_global[3] = { 0, 0, 0 };
+	double status_time_prev = MPI_Wtime();
+	double checkpoint_time_prev = MPI_Wtime();
+	bool stop_requested = false;
+	// Starts a new status exchange once the previous one is complete and the status check interval has elapsed, or right away when the proc is idle,
+	// and then checks whether the current status exchange is complete
+	auto exchangeStatus = [&](const bool is_error, const bool is_finished) {
+		bool is_idle = is_error || is_finished;
+		if (status_request == MPI_REQUEST_NULL && (is_idle || MPI_Wtime() - status_time_prev >= params.Status_check_interval)) {
+			// The first value counts the procs with errors, the second value counts the procs that are not finished,
+			// and the third value counts the procs that received a stop signal
+			status_local[0] = is_error ? 1 : 0;
+			status_local[1] = !is_finished ? 1 : 0;
+			status_local[2] = (stop_signal != 0) ? 1 : 0;
+			MPI_Iallreduce(status_local, status_global, 3, MPI_INT, MPI_SUM, comm, &status_request);
+			status_time_prev = MPI_Wtime();
+		}
+		if (status_request != MPI_REQUEST_NULL) {
+			int status_ready;
+			MPI_Test(&status_request, &status_ready, MPI_STATUS_IGNORE);
+			if (status_ready) {
+				if (status_global[0] > 0) {
+					error_found = (char)1;
 				}
-				// Receive messages from any processors not previously finished
-				if (procid == 0 && !proc_finished[i]) {
-					// Receive error status message
-					MPI_Recv(&error_status, 1, MPI_CHAR, i, i, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
-					error_status_vec[i] = (error_status == (char)1) ? true : false;
-					// If the proc has an error, then receive the error message
-					if (error_status_vec[i]) {
-						MPI_Recv(&msg_length, 1, MPI_CHAR, i, i, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
-						char* error_msg = new char[(int)msg_length];
-						MPI_Recv(error_msg, (int)msg_length, MPI_CHAR, i, i, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
-						error_messages[i] = string(error_msg);
-						error_found = (char)1;
-						delete[] error_msg;
-					}
-					MPI_Recv(&finished_status, 1, MPI_CHAR, i, i, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
-					proc_finished[i] = (finished_status == (char)1) ? true : false;
+				if (status_global[1] == 0) {
+					all_finished = true;
+				}
+				if (status_global[2] > 0) {
+					stop_requested = true;
 				}
 			}
-			// Check error status of proc 0
-			if (!success) {
-				error_found = (char)1;
-			}
-			// Send error status from proc 0 to all unfinished procs
-			for (int i = 1; i < nproc; i++) {
-				if (procid == 0) {
-					MPI_Send(&error_found, 1, MPI_CHAR, i, i, MPI_COMM_WORLD);
+		}
+	};
+	if (params.N_threads == 1) {
+		while (!all_finished && !stop_requested && error_found == (char)0) {
+			if (!End_sim && success) {
+				success = sim.executeNextEvent();
+				if (!success) {
+					cout << procid << ": Event execution failed, simulation will now terminate." << endl;
 				}
-				if (procid == i && !proc_finished[i]) {
-					MPI_Recv(&error_found, 1, MPI_CHAR, 0, i, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+				End_sim = sim.checkFinished();
+				// Request another chunk of tests when dynamic test distribution is enabled
+				if (End_sim && success && !tests_exhausted) {
+					int tests_assigned_prev;
+					MPI_Win_lock(MPI_LOCK_SHARED, 0, 0, tests_win);
+					MPI_Fetch_and_op(&params.Test_chunk_size, &tests_assigned_prev, MPI_INT, 0, 0, MPI_SUM, tests_win);
+					MPI_Win_unlock(0, tests_win);
+					int N_tests_granted = min(params.Test_chunk_size, N_tests_total - tests_assigned_prev);
+					if (N_tests_granted > 0 && sim.addTests(N_tests_granted)) {
+						End_sim = sim.checkFinished();
+					}
+					else {
+						tests_exhausted = true;
+					}
 				}
-			}
-			// Update info for proc 0
-			error_status_vec[0] = !success;
-			proc_finished[0] = End_sim;
-			error_messages[0] = sim.getErrorMessage();
-			if (error_found == (char)1) {
-				break;
-			}
-			// Update completion status
-			if (procid == 0) {
-				all_finished = true;
-				for (int i = 0; i < nproc; i++) {
-					if (!proc_finished[i]) {
-						all_finished = false;
-						break;
+				// Output status
+				if (sim.getN_events_executed() % 1000000 == 0) {
+					sim.outputStatus();
+				}
+				// Reset logfile
+				if (params.Enable_logging) {
+					if (sim.getN_events_executed() % 1000 == 0) {
+						logfile.close();
+						logfile.open(logfilename);
+					}
+				}
+				// Write a checkpoint when the checkpoint interval has elapsed or when a checkpoint is requested by a signal
+				if (params.Checkpoint_interval > 0 && success && !End_sim && sim.getN_events_executed() % 1000 == 0) {
+					if (checkpoint_signal != 0 || MPI_Wtime() - checkpoint_time_prev >= params.Checkpoint_interval) {
+						checkpoint_signal = 0;
+						sim.exportCheckpoint(getCheckpointFilename(procid));
+						checkpoint_time_prev = MPI_Wtime();
 					}
 				}
 			}
+			if (End_sim || !success || sim.getN_events_executed() % 1000 == 0) {
+				exchangeStatus(!success, End_sim);
+			}
 		}
-		// Output status
-		if (sim.getN_events_executed() % 1000000 == 0) {
-			sim.outputStatus();
+	}
+	else {
+		// The main thread only takes part in the status exchanges and passes checkpoint requests to the replicas while the replicas run
+		while (!all_finished && !stop_requested && error_found == (char)0) {
+			bool is_error = N_replica_errors > 0;
+			bool is_finished = N_replicas_running == 0;
+			if (checkpoint_signal != 0) {
+				checkpoint_signal = 0;
+				N_checkpoint_requests++;
+			}
+			exchangeStatus(is_error, is_finished);
+			if (!is_error && !is_finished) {
+				this_thread::sleep_for(chrono::milliseconds(10));
+			}
+		}
+		// Stop any replicas that are still running when an error has occurred on any proc
+		stop_replicas = true;
+		for (auto& item : replica_threads) {
+			item.join();
+		}
+		success = all_of(replica_success.begin(), replica_success.end(), [](const char status) { return status == (char)1; });
+	}
+	if (tests_win != MPI_WIN_NULL) {
+		MPI_Win_free(&tests_win);
+	}
+	// When a stop signal is received by any proc, checkpoints of all simulations are written and the run is stopped without any output of results
+	if (stop_requested && !all_finished && error_found == (char)0) {
+		for (int i = 0; i < params.N_threads; i++) {
+			sims[i].exportCheckpoint(getCheckpointFilename(procid * params.N_threads + i));
 		}
-		// Reset logfile
+		cout << procid << ": Simulation stopped after writing checkpoints." << endl;
 		if (params.Enable_logging) {
-			if (sim.getN_events_executed() % 1000 == 0) {
-				logfile.close();
-				logfile.open(logfilename);
+			logfile.close();
+		}
+		MPI_Barrier(comm);
+		return RunStatus::Stopped;
+	}
+	// Get the error message from the first replica with an error
+	string error_msg = "";
+	for (auto& item : sims) {
+		if (item.getErrorMessage().size() > 0) {
+			error_msg = item.getErrorMessage();
+			break;
+		}
+	}
+	// Gather the error status and error messages from all procs to proc 0
+	if (error_found == (char)1) {
+		char error_status = !success ? (char)1 : (char)0;
+		vector<char> error_status_all(nproc, (char)0);
+		MPI_Gather(&error_status, 1, MPI_CHAR, error_status_all.data(), 1, MPI_CHAR, 0, comm);
+		string error_msg_local = !success ? error_msg : "";
+		int msg_length = (int)error_msg_local.size();
+		vector<int> msg_lengths(nproc, 0);
+		MPI_Gather(&msg_length, 1, MPI_INT, msg_lengths.data(), 1, MPI_INT, 0, comm);
+		vector<int> msg_displacements(nproc, 0);
+		for (int i = 1; i < nproc; i++) {
+			msg_displacements[i] = msg_displacements[i - 1] + msg_lengths[i - 1];
+		}
+		vector<char> error_msgs_all(accumulate(msg_lengths.begin(), msg_lengths.end(), 0) + 1, '\0');
+		MPI_Gatherv(error_msg_local.data(), msg_length, MPI_CHAR, error_msgs_all.data(), msg_lengths.data(), msg_displacements.data(), MPI_CHAR, 0, comm);
+		if (procid == 0) {
+			for (int i = 0; i < nproc; i++) {
+				error_status_vec[i] = (error_status_all[i] == (char)1);
+				error_messages[i] = string(error_msgs_all.data() + msg_displacements[i], msg_lengths[i]);
 			}
 		}
 	}
 	if (params.Enable_logging) {
 		logfile.close();
 	}
+	// Combine the results of all replicas on this proc before the results are combined across procs
+	double time_simulated = 0.0;
+	for (auto& item : sims) {
+		time_simulated += item.getTime();
+	}
+	if (success) {
+		for (int i = 1; i < params.N_threads; i++) {
+			sim.mergeResults(sims[i]);
+		}
+	}
 	cout << procid << ": Simulation finished." << endl;
 	time_end = time(NULL);
 	elapsedtime = (int)difftime(time_end, time_start);
@@ -277,19 +814,29 @@ int main(int argc, char *argv[]) {
 	resultsfile.open("results" + to_string(procid) + ".txt");
 	resultsfile << "Excimontec " << version << " Results:\n";
 	resultsfile << "Calculation time elapsed is " << (double)elapsedtime / 60 << " minutes.\n";
-	resultsfile << sim.getTime() << " seconds have been simulated.\n";
-	resultsfile << sim.getN_events_executed() << " events have been executed.\n\n";
+	resultsfile << time_simulated << " seconds have been simulated.\n";
+	resultsfile << sim.getN_events_executed() << " events have been executed.\n";
+	if (params.Enable_superbasin_acceleration) {
+		resultsfile << sim.getN_superbasin_exits() << " of the events were accelerated superbasin exits.\n";
+	}
+	if (params.Enable_rate_thinning) {
+		resultsfile << sim.getN_null_events() << " null events have been rejected by rate thinning.\n";
+	}
+	if (params.Enable_escape_rate_cache) {
+		resultsfile << sim.getN_null_events() << " null events have been rejected as cached hops to occupied sites.\n";
+	}
+	resultsfile << "\n";
 	if (!success) {
 		resultsfile << "An error occurred during the simulation:" << endl;
-		resultsfile << sim.getErrorMessage() << endl;
+		resultsfile << error_msg << endl;
 	}
 	else {
 		if (params.Enable_exciton_diffusion_test) {
 			resultsfile << "Exciton diffusion test results:\n";
 			resultsfile << sim.getN_excitons_created() << " excitons have been created.\n";
-			resultsfile << "Exciton diffusion length is " << vector_avg(sim.getExcitonDiffusionData()) << "  " << vector_stdev(sim.getExcitonDiffusionData()) << " nm.\n";
-			resultsfile << "Exciton hop distance is " << vector_avg(sim.getExcitonHopLengthData()) << "  " << vector_stdev(sim.getExcitonHopLengthData()) << " nm.\n";
-			resultsfile << "Exciton lifetime is " << vector_avg(sim.getExcitonLifetimeData()) << "  " << vector_stdev(sim.getExcitonLifetimeData()) << " s.\n";
+			resultsfile << "Exciton diffusion length is " << sim.getExcitonDiffusionStats().getMean() << "  " << sim.getExcitonDiffusionStats().getStdev() << " nm.\n";
+			resultsfile << "Exciton hop distance is " << sim.getExcitonHopLengthStats().getMean() << "  " << sim.getExcitonHopLengthStats().getStdev() << " nm.\n";
+			resultsfile << "Exciton lifetime is " << sim.getExcitonLifetimeStats().getMean() << "  " << sim.getExcitonLifetimeStats().getStdev() << " s.\n";
 		}
 		else if (params.Enable_ToF_test) {
 			resultsfile << "Time-of-flight charge transport test results:\n";
@@ -299,8 +846,8 @@ int main(int argc, char *argv[]) {
 			else {
 				resultsfile << sim.getN_holes_collected() << " of " << sim.getN_holes_created() << " holes have been collected.\n";
 			}
-			resultsfile << "Transit time is " << vector_avg(sim.getTransitTimeData()) << "  " << vector_stdev(sim.getTransitTimeData()) << " s.\n";
-			resultsfile << "Charge carrier mobility is " << vector_avg(sim.calculateMobilityData(sim.getTransitTimeData())) << "  " << vector_stdev(sim.calculateMobilityData(sim.getTransitTimeData())) << " cm^2 V^-1 s^-1.\n";
+			resultsfile << "Transit time is " << sim.getTransitTimeStats().getMean() << "  " << sim.getTransitTimeStats().getStdev() << " s.\n";
+			resultsfile << "Charge carrier mobility is " << sim.getTransitMobilityStats().getMean() << "  " << sim.getTransitMobilityStats().getStdev() << " cm^2 V^-1 s^-1.\n";
 		}
 		if (params.Enable_dynamics_test) {
 			resultsfile << "Dynamics test results:\n";
@@ -360,13 +907,44 @@ int main(int argc, char *argv[]) {
 			outputVectorToFile(extraction_data, filename);
 		}
 	}
+	// Output the individual exciton and transit time samples of each processor when raw data retention is enabled
+	if (success && params.Enable_raw_data_retention) {
+		if (params.Enable_exciton_diffusion_test) {
+			outputVectorToFile(sim.getExcitonDiffusionData(), "Exciton_diffusion_data" + to_string(procid) + ".txt");
+			outputVectorToFile(sim.getExcitonHopLengthData(), "Exciton_hop_length_data" + to_string(procid) + ".txt");
+			outputVectorToFile(sim.getExcitonLifetimeData(), "Exciton_lifetime_data" + to_string(procid) + ".txt");
+		}
+		if (params.Enable_ToF_test) {
+			outputVectorToFile(sim.getTransitTimeData(), "Transit_time_data" + to_string(procid) + ".txt");
+		}
+	}
+	// Output the hot-path profile of each processor and the profile summary of all processors when the profiling instrumentation is compiled in
+	if (Profiler::isEnabled()) {
+		Profiler profile_local = sims[0].getProfiler();
+		for (int i = 1; i < params.N_threads; i++) {
+			profile_local.merge(sims[i].getProfiler());
+		}
+		ofstream profilefile("profile" + to_string(procid) + ".json");
+		profile_local.exportJSON(profilefile);
+		profilefile << endl;
+		profilefile.close();
+		auto profiles = MPI_gatherProfilers(profile_local, comm);
+		if (procid == 0) {
+			ofstream profile_summaryfile("profile_summary.json");
+			Profiler::exportSummaryJSON(profile_summaryfile, profiles);
+			profile_summaryfile.close();
+		}
+	}
 	// Output overall analysis results from all processors
 	int elapsedtime_sum;
-	MPI_Reduce(&elapsedtime, &elapsedtime_sum, 1, MPI_INT, MPI_SUM, 0, MPI_COMM_WORLD);
+	MPI_Reduce(&elapsedtime, &elapsedtime_sum, 1, MPI_INT, MPI_SUM, 0, comm);
 	if (procid == 0) {
 		analysisfile.open("analysis_summary.txt");
 		analysisfile << "Excimontec " << version << " Results Summary:\n";
 		analysisfile << "Simulation was performed on " << nproc << " processors.\n";
+		if (params.N_threads > 1) {
+			analysisfile << "Each processor ran " << params.N_threads << " simulation replicas in separate threads.\n";
+		}
 		analysisfile << "Average calculation time was " << (double)elapsedtime_sum / (60 * nproc) << " minutes.\n\n";
 		if (error_found == (char)1) {
 			analysisfile << endl << "An error occurred on one or more processors:" << endl;
@@ -378,40 +956,38 @@ int main(int argc, char *argv[]) {
 		}
 	}
 	if (error_found == (char)0 && params.Enable_exciton_diffusion_test) {
-		vector<double> exciton_diffusion_data;
-		vector<int> exciton_hop_length_data;
-		vector<double> exciton_lifetime_data;
-		exciton_diffusion_data = MPI_gatherVectors(sim.getExcitonDiffusionData());
-		exciton_hop_length_data = MPI_gatherVectors(sim.getExcitonHopLengthData());
-		exciton_lifetime_data = MPI_gatherVectors(sim.getExcitonLifetimeData());
+		Statistics exciton_diffusion_stats = MPI_mergeStatistics(sim.getExcitonDiffusionStats(), comm);
+		Statistics exciton_hop_length_stats = MPI_mergeStatistics(sim.getExcitonHopLengthStats(), comm);
+		Statistics exciton_lifetime_stats = MPI_mergeStatistics(sim.getExcitonLifetimeStats(), comm);
 		if (procid == 0) {
 			analysisfile << "Overall exciton diffusion test results:\n";
-			analysisfile << nproc * (sim.getN_singlet_excitons_recombined() + sim.getN_triplet_excitons_recombined()) << " total excitons tested." << endl;
-			analysisfile << "Exciton diffusion length is " << vector_avg(exciton_diffusion_data) << "  " << vector_stdev(exciton_diffusion_data) << " nm.\n";
-			analysisfile << "Exciton hop distance is " << sqrt(vector_avg(exciton_hop_length_data))*params.Params_lattice.Unit_size << "  " << sqrt(vector_stdev(exciton_hop_length_data))*params.Params_lattice.Unit_size << " nm.\n";
-			analysisfile << "Exciton lifetime is " << vector_avg(exciton_lifetime_data) << "  " << vector_stdev(exciton_lifetime_data) << " s.\n";
+			analysisfile << (int)exciton_lifetime_stats.getCount() << " total excitons tested." << endl;
+			analysisfile << "Exciton diffusion length is " << exciton_diffusion_stats.getMean() << "  " << exciton_diffusion_stats.getStdev() << " nm.\n";
+			analysisfile << "Exciton hop distance is " << sqrt(exciton_hop_length_stats.getMean())*params.Params_lattice.Unit_size << "  " << sqrt(exciton_hop_length_stats.getStdev())*params.Params_lattice.Unit_size << " nm.\n";
+			analysisfile << "Exciton lifetime is " << exciton_lifetime_stats.getMean() << "  " << exciton_lifetime_stats.getStdev() << " s.\n";
 		}
 	}
 	if (error_found == (char)0 && params.Enable_ToF_test) {
 		int N_transient_cycles = sim.getN_transient_cycles();
 		int N_transient_cycles_sum;
-		MPI_Reduce(&N_transient_cycles, &N_transient_cycles_sum, 1, MPI_INT, MPI_SUM, 0, MPI_COMM_WORLD);
-		vector<double> transit_times_all = MPI_gatherVectors(sim.getTransitTimeData());
+		MPI_Reduce(&N_transient_cycles, &N_transient_cycles_sum, 1, MPI_INT, MPI_SUM, 0, comm);
+		Statistics transit_time_stats = MPI_mergeStatistics(sim.getTransitTimeStats(), comm);
+		Statistics mobility_stats = MPI_mergeStatistics(sim.getTransitMobilityStats(), comm);
+		Histogram transit_time_hist = MPI_mergeHistograms(sim.getTransitTimeHistogram(), comm);
 		int transit_attempts = ((sim.getN_electrons_collected() > sim.getN_holes_collected()) ? sim.getN_electrons_created() : (sim.getN_holes_created()));
 		int transit_attempts_total;
-		MPI_Reduce(&transit_attempts, &transit_attempts_total, 1, MPI_INT, MPI_SUM, 0, MPI_COMM_WORLD);
-		vector<int> counts = MPI_calculateVectorSum(sim.getToFTransientCounts());
-		vector<double> energies = MPI_calculateVectorSum(sim.getToFTransientEnergies());
-		vector<double> velocities = MPI_calculateVectorSum(sim.getToFTransientVelocities());
+		MPI_Reduce(&transit_attempts, &transit_attempts_total, 1, MPI_INT, MPI_SUM, 0, comm);
+		vector<int> counts = MPI_calculateVectorSum(sim.getToFTransientCounts(), comm);
+		vector<double> energies = MPI_calculateVectorSum(sim.getToFTransientEnergies(), comm);
+		vector<double> velocities = MPI_calculateVectorSum(sim.getToFTransientVelocities(), comm);
 		vector<double> times = sim.getToFTransientTimes();
 		if (procid == 0) {
 			// ToF main results output
-			vector<double> mobility_data_all = sim.calculateMobilityData(transit_times_all);
 			double electric_field = fabs(sim.getInternalField());
 			ofstream tof_resultsfile;
 			tof_resultsfile.open("ToF_results.txt");
 			tof_resultsfile << "Electric Field (V/cm),Transit Time Avg (s),Transit Time Stdev (s),Mobility Avg (cm^2 V^-1 s^-1),Mobility Stdev (cm^2 V^-1 s^-1)" << endl;
-			tof_resultsfile << electric_field << "," << vector_avg(transit_times_all) << "," << vector_stdev(transit_times_all) << "," << vector_avg(mobility_data_all) << "," << vector_stdev(mobility_data_all) << endl;
+			tof_resultsfile << electric_field << "," << transit_time_stats.getMean() << "," << transit_time_stats.getStdev() << "," << mobility_stats.getMean() << "," << mobility_stats.getStdev() << endl;
 			tof_resultsfile.close();
 			// ToF transient output
 			ofstream transientfile;
@@ -433,7 +1009,7 @@ int main(int argc, char *argv[]) {
 			// ToF transit time distribution output
 			ofstream transitdistfile;
 			transitdistfile.open("ToF_transit_time_hist.txt");
-			auto transit_dist = sim.calculateTransitTimeHist(transit_times_all, transit_attempts_total);
+			auto transit_dist = sim.calculateTransitTimeHist(transit_time_hist, transit_attempts_total);
 			transitdistfile << "Transit Time (s),Probability" << endl;
 			for (int i = 0; i < (int)transit_dist.size(); i++) {
 				transitdistfile << transit_dist[i].first << "," << transit_dist[i].second << endl;
@@ -442,31 +1018,31 @@ int main(int argc, char *argv[]) {
 			// Analysis Output
 			analysisfile << "Overall time-of-flight charge transport test results:\n";
 			if (!params.ToF_polaron_type) {
-				analysisfile << nproc * sim.getN_electrons_collected() << " total electrons collected out of " << transit_attempts_total << " total attempts.\n";
+				analysisfile << (int)transit_time_stats.getCount() << " total electrons collected out of " << transit_attempts_total << " total attempts.\n";
 			}
 			else {
-				analysisfile << nproc * sim.getN_holes_collected() << " total holes collected out of " << transit_attempts_total << " total attempts.\n";
+				analysisfile << (int)transit_time_stats.getCount() << " total holes collected out of " << transit_attempts_total << " total attempts.\n";
 			}
 
-			analysisfile << "Transit time is " << vector_avg(transit_times_all) << "  " << vector_stdev(transit_times_all) << " s.\n";
-			analysisfile << "Charge carrier mobility is " << vector_avg(mobility_data_all) << "  " << vector_stdev(mobility_data_all) << " cm^2 V^-1 s^-1.\n";
+			analysisfile << "Transit time is " << transit_time_stats.getMean() << "  " << transit_time_stats.getStdev() << " s.\n";
+			analysisfile << "Charge carrier mobility is " << mobility_stats.getMean() << "  " << mobility_stats.getStdev() << " cm^2 V^-1 s^-1.\n";
 		}
 	}
 	if (error_found == (char)0 && params.Enable_dynamics_test) {
 		int N_transient_cycles = sim.getN_transient_cycles();
 		int N_transient_cycles_sum;
-		MPI_Reduce(&N_transient_cycles, &N_transient_cycles_sum, 1, MPI_INT, MPI_SUM, 0, MPI_COMM_WORLD);
+		MPI_Reduce(&N_transient_cycles, &N_transient_cycles_sum, 1, MPI_INT, MPI_SUM, 0, comm);
 		vector<double> times = sim.getDynamicsTransientTimes();
-		vector<int> singlets_total = MPI_calculateVectorSum(sim.getDynamicsTransientSinglets());
-		vector<int> triplets_total = MPI_calculateVectorSum(sim.getDynamicsTransientTriplets());
-		vector<int> electrons_total = MPI_calculateVectorSum(sim.getDynamicsTransientElectrons());
-		vector<int> holes_total = MPI_calculateVectorSum(sim.getDynamicsTransientHoles());
-		vector<double> exciton_energies = MPI_calculateVectorSum(sim.getDynamicsExcitonEnergies());
-		vector<double> electron_energies = MPI_calculateVectorSum(sim.getDynamicsElectronEnergies());
-		vector<double> hole_energies = MPI_calculateVectorSum(sim.getDynamicsHoleEnergies());
-		vector<double> exciton_msdv = MPI_calculateVectorSum(sim.getDynamicsExcitonMSDV());
-		vector<double> electron_msdv = MPI_calculateVectorSum(sim.getDynamicsElectronMSDV());
-		vector<double> hole_msdv = MPI_calculateVectorSum(sim.getDynamicsHoleMSDV());
+		vector<int> singlets_total = MPI_calculateVectorSum(sim.getDynamicsTransientSinglets(), comm);
+		vector<int> triplets_total = MPI_calculateVectorSum(sim.getDynamicsTransientTriplets(), comm);
+		vector<int> electrons_total = MPI_calculateVectorSum(sim.getDynamicsTransientElectrons(), comm);
+		vector<int> holes_total = MPI_calculateVectorSum(sim.getDynamicsTransientHoles(), comm);
+		vector<double> exciton_energies = MPI_calculateVectorSum(sim.getDynamicsExcitonEnergies(), comm);
+		vector<double> electron_energies = MPI_calculateVectorSum(sim.getDynamicsElectronEnergies(), comm);
+		vector<double> hole_energies = MPI_calculateVectorSum(sim.getDynamicsHoleEnergies(), comm);
+		vector<double> exciton_msdv = MPI_calculateVectorSum(sim.getDynamicsExcitonMSDV(), comm);
+		vector<double> electron_msdv = MPI_calculateVectorSum(sim.getDynamicsElectronMSDV(), comm);
+		vector<double> hole_msdv = MPI_calculateVectorSum(sim.getDynamicsHoleMSDV(), comm);
 		if (procid == 0) {
 			ofstream transientfile;
 			transientfile.open("dynamics_average_transients.txt");
@@ -511,49 +1087,49 @@ int main(int argc, char *argv[]) {
 	if (error_found == (char)0 && (params.Enable_dynamics_test || params.Enable_IQE_test || params.Enable_exciton_diffusion_test)) {
 		int excitons_created = sim.getN_excitons_created();
 		int excitons_created_total;
-		MPI_Reduce(&excitons_created, &excitons_created_total, 1, MPI_INT, MPI_SUM, 0, MPI_COMM_WORLD);
+		MPI_Reduce(&excitons_created, &excitons_created_total, 1, MPI_INT, MPI_SUM, 0, comm);
 		int excitons_created_donor = sim.getN_excitons_created((short)1);
 		int excitons_created_donor_total;
-		MPI_Reduce(&excitons_created_donor, &excitons_created_donor_total, 1, MPI_INT, MPI_SUM, 0, MPI_COMM_WORLD);
+		MPI_Reduce(&excitons_created_donor, &excitons_created_donor_total, 1, MPI_INT, MPI_SUM, 0, comm);
 		int excitons_created_acceptor = sim.getN_excitons_created((short)2);
 		int excitons_created_acceptor_total;
-		MPI_Reduce(&excitons_created_acceptor, &excitons_created_acceptor_total, 1, MPI_INT, MPI_SUM, 0, MPI_COMM_WORLD);
+		MPI_Reduce(&excitons_created_acceptor, &excitons_created_acceptor_total, 1, MPI_INT, MPI_SUM, 0, comm);
 		int excitons_dissociated = sim.getN_singlet_excitons_dissociated() + sim.getN_triplet_excitons_dissociated();
 		int excitons_dissociated_total;
-		MPI_Reduce(&excitons_dissociated, &excitons_dissociated_total, 1, MPI_INT, MPI_SUM, 0, MPI_COMM_WORLD);
+		MPI_Reduce(&excitons_dissociated, &excitons_dissociated_total, 1, MPI_INT, MPI_SUM, 0, comm);
 		int singlet_excitons_recombined = sim.getN_singlet_excitons_recombined();
 		int singlet_excitons_recombined_total;
-		MPI_Reduce(&singlet_excitons_recombined, &singlet_excitons_recombined_total, 1, MPI_INT, MPI_SUM, 0, MPI_COMM_WORLD);
+		MPI_Reduce(&singlet_excitons_recombined, &singlet_excitons_recombined_total, 1, MPI_INT, MPI_SUM, 0, comm);
 		int triplet_excitons_recombined = sim.getN_triplet_excitons_recombined();
 		int triplet_excitons_recombined_total;
-		MPI_Reduce(&triplet_excitons_recombined, &triplet_excitons_recombined_total, 1, MPI_INT, MPI_SUM, 0, MPI_COMM_WORLD);
+		MPI_Reduce(&triplet_excitons_recombined, &triplet_excitons_recombined_total, 1, MPI_INT, MPI_SUM, 0, comm);
 		int singlet_singlet_annihilations = sim.getN_singlet_singlet_annihilations();
 		int singlet_singlet_annihilations_total;
-		MPI_Reduce(&singlet_singlet_annihilations, &singlet_singlet_annihilations_total, 1, MPI_INT, MPI_SUM, 0, MPI_COMM_WORLD);
+		MPI_Reduce(&singlet_singlet_annihilations, &singlet_singlet_annihilations_total, 1, MPI_INT, MPI_SUM, 0, comm);
 		int singlet_triplet_annihilations = sim.getN_singlet_triplet_annihilations();
 		int singlet_triplet_annihilations_total;
-		MPI_Reduce(&singlet_triplet_annihilations, &singlet_triplet_annihilations_total, 1, MPI_INT, MPI_SUM, 0, MPI_COMM_WORLD);
+		MPI_Reduce(&singlet_triplet_annihilations, &singlet_triplet_annihilations_total, 1, MPI_INT, MPI_SUM, 0, comm);
 		int triplet_triplet_annihilations = sim.getN_triplet_triplet_annihilations();
 		int triplet_triplet_annihilations_total;
-		MPI_Reduce(&triplet_triplet_annihilations, &triplet_triplet_annihilations_total, 1, MPI_INT, MPI_SUM, 0, MPI_COMM_WORLD);
+		MPI_Reduce(&triplet_triplet_annihilations, &triplet_triplet_annihilations_total, 1, MPI_INT, MPI_SUM, 0, comm);
 		int singlet_polaron_annihilations = sim.getN_singlet_polaron_annihilations();
 		int singlet_polaron_annihilations_total;
-		MPI_Reduce(&singlet_polaron_annihilations, &singlet_polaron_annihilations_total, 1, MPI_INT, MPI_SUM, 0, MPI_COMM_WORLD);
+		MPI_Reduce(&singlet_polaron_annihilations, &singlet_polaron_annihilations_total, 1, MPI_INT, MPI_SUM, 0, comm);
 		int triplet_polaron_annihilations = sim.getN_triplet_polaron_annihilations();
 		int triplet_polaron_annihilations_total;
-		MPI_Reduce(&triplet_polaron_annihilations, &triplet_polaron_annihilations_total, 1, MPI_INT, MPI_SUM, 0, MPI_COMM_WORLD);
+		MPI_Reduce(&triplet_polaron_annihilations, &triplet_polaron_annihilations_total, 1, MPI_INT, MPI_SUM, 0, comm);
 		int geminate_recombinations = sim.getN_geminate_recombinations();
 		int geminate_recombinations_total;
-		MPI_Reduce(&geminate_recombinations, &geminate_recombinations_total, 1, MPI_INT, MPI_SUM, 0, MPI_COMM_WORLD);
+		MPI_Reduce(&geminate_recombinations, &geminate_recombinations_total, 1, MPI_INT, MPI_SUM, 0, comm);
 		int bimolecular_recombinations = sim.getN_bimolecular_recombinations();
 		int bimolecular_recombinations_total;
-		MPI_Reduce(&bimolecular_recombinations, &bimolecular_recombinations_total, 1, MPI_INT, MPI_SUM, 0, MPI_COMM_WORLD);
+		MPI_Reduce(&bimolecular_recombinations, &bimolecular_recombinations_total, 1, MPI_INT, MPI_SUM, 0, comm);
 		int electrons_collected = sim.getN_electrons_collected();
 		int electrons_collected_total;
-		MPI_Reduce(&electrons_collected, &electrons_collected_total, 1, MPI_INT, MPI_SUM, 0, MPI_COMM_WORLD);
+		MPI_Reduce(&electrons_collected, &electrons_collected_total, 1, MPI_INT, MPI_SUM, 0, comm);
 		int holes_collected = sim.getN_holes_collected();
 		int holes_collected_total;
-		MPI_Reduce(&holes_collected, &holes_collected_total, 1, MPI_INT, MPI_SUM, 0, MPI_COMM_WORLD);
+		MPI_Reduce(&holes_collected, &holes_collected_total, 1, MPI_INT, MPI_SUM, 0, comm);
 		if (procid == 0 && params.Enable_dynamics_test) {
 			analysisfile << "Overall dynamics test results:\n";
 		}
@@ -587,19 +1163,26 @@ int main(int argc, char *argv[]) {
 	}
 	if (error_found == (char)0 && params.Enable_steady_transport_test) {
 		// Calculate the average DOOS
-		auto doos_avg1 = MPI_calculatePairVectorAvg(sim.getSteadyDOOS());
-		auto dos_avg1 = MPI_calculatePairVectorAvg(sim.getSteadyDOS());
-		auto doos_avg2 = MPI_calculatePairVectorAvg(sim.getSteadyDOOS_Coulomb());
-		auto dos_avg2 = MPI_calculatePairVectorAvg(sim.getSteadyDOS_Coulomb());
+		auto doos_avg1 = MPI_calculatePairVectorAvg(sim.getSteadyDOOS(), comm);
+		auto dos_avg1 = MPI_calculatePairVectorAvg(sim.getSteadyDOS(), comm);
+		auto doos_avg2 = MPI_calculatePairVectorAvg(sim.getSteadyDOOS_Coulomb(), comm);
+		auto dos_avg2 = MPI_calculatePairVectorAvg(sim.getSteadyDOS_Coulomb(), comm);
+		auto out_of_range_counts = MPI_gatherValues(sim.getSteadyDOSOutOfRangeCount(), comm);
 		// Gather results from all procs
-		auto current_densities = MPI_gatherValues(sim.getSteadyCurrentDensity());
-		auto mobilities = MPI_gatherValues(sim.getSteadyMobility());
-		auto equilibration_energies1 = MPI_gatherValues(sim.getSteadyEquilibrationEnergy());
-		auto equilibration_energies2 = MPI_gatherValues(sim.getSteadyEquilibrationEnergy_Coulomb());
-		auto transport_energies1 = MPI_gatherValues(sim.getSteadyTransportEnergy());
-		auto transport_energies2 = MPI_gatherValues(sim.getSteadyTransportEnergy_Coulomb());
+		auto current_densities = MPI_gatherValues(sim.getSteadyCurrentDensity(), comm);
+		auto mobilities = MPI_gatherValues(sim.getSteadyMobility(), comm);
+		auto equilibration_energies1 = MPI_gatherValues(sim.getSteadyEquilibrationEnergy(), comm);
+		auto equilibration_energies2 = MPI_gatherValues(sim.getSteadyEquilibrationEnergy_Coulomb(), comm);
+		auto transport_energies1 = MPI_gatherValues(sim.getSteadyTransportEnergy(), comm);
+		auto transport_energies2 = MPI_gatherValues(sim.getSteadyTransportEnergy_Coulomb(), comm);
 		// Output overall results from all procs
 		if (procid == 0) {
+			// State energies outside of the histogram range are not included in the DOOS and DOS data
+			double out_of_range_total = accumulate(out_of_range_counts.begin(), out_of_range_counts.end(), 0.0);
+			if (out_of_range_total > 0) {
+				cout << "Warning! " << out_of_range_total << " DOOS and DOS samples were outside of the histogram energy range and are not included in the DOOS and DOS data." << endl;
+				analysisfile << "Warning! " << out_of_range_total << " DOOS and DOS samples were outside of the histogram energy range and are not included in the DOOS and DOS data.\n";
+			}
 			// Output the DOOS and DOS data
 			ofstream doos_file1("DOOS_data.txt");
 			doos_file1 << "Energy (eV),Density (cm^-3 eV^-1)\n";
@@ -651,7 +1234,442 @@ int main(int argc, char *argv[]) {
 	if (procid == 0) {
 		analysisfile.close();
 	}
+	MPI_Barrier(comm);
+	return (error_found == (char)0) ? RunStatus::Finished : RunStatus::Error;
+}
+
+//! \brief Runs the end-to-end throughput benchmark on the calling processor.
+//! \details Each parameter file defines one benchmark case.  The simulation of each case is initialized with a fixed random number seed and
+//! then executes events until the event budget is used up or the simulation finishes.  The initialization time, the number of executed events,
+//! the number of events executed per second, and the peak memory usage of each case are written to the console and to benchmark_results.txt.
+//! When a baseline file is given, the event rate of each case is compared to the event rate of the baseline case with the same name.
+//! \param params contains the options that were set by command line arguments, which are kept when the parameter files are imported.
+//! \param parameter_filenames is the vector of parameter file names of the benchmark cases.
+//! \param N_events_max is the maximum number of events that are executed in each case.
+//! \param baseline_filename is the name of the benchmark_results.txt file from an earlier benchmark run, or an empty string for no comparison.
+//! \return true if all benchmark cases ran without errors.
+//! \return false if any parameter file could not be imported or any simulation had an error.
+bool runBenchmark(Parameters params, const vector<string>& parameter_filenames, const long int N_events_max, const string& baseline_filename) {
+	// Every benchmark run uses the same random number seed so that the same events are executed
+	const int Benchmark_seed = 1;
+	bool success = true;
+	map<string, double> baseline_rates;
+	if (!baseline_filename.empty() && !importBenchmarkBaseline(baseline_filename, baseline_rates)) {
+		cout << "Error! Benchmark baseline file " << baseline_filename << " could not be imported." << endl;
+		return false;
+	}
+	stringstream results;
+	results << "Case,Events,Initialization Time (s),Run Time (s),Events per Second,Peak Memory (MB)";
+	results << (baseline_rates.empty() ? "\n" : ",Baseline Events per Second,Speedup\n");
+	for (auto& parameter_filename : parameter_filenames) {
+		string case_name = getFileStem(parameter_filename);
+		cout << "Running benchmark case " << case_name << "..." << endl;
+		Parameters case_params = params;
+		ifstream parameterfile(parameter_filename, ifstream::in);
+		if (!parameterfile.good() || !case_params.importParameters(parameterfile)) {
+			cout << "Error! Parameter file " << parameter_filename << " could not be imported." << endl;
+			success = false;
+			continue;
+		}
+		parameterfile.close();
+		// Logging and event traces are disabled so that only the simulation itself is timed
+		case_params.Enable_logging = false;
+		case_params.Enable_event_trace = false;
+		case_params.Enable_raw_data_retention = false;
+		case_params.Generator_seed = Benchmark_seed;
+		resetPeakMemoryUsage();
+		OSC_Sim sim;
+		auto time_start = chrono::steady_clock::now();
+		if (!sim.init(case_params, 0)) {
+			cout << "Error! The simulation of benchmark case " << case_name << " could not be initialized: " << sim.getErrorMessage() << endl;
+			success = false;
+			continue;
+		}
+		auto time_init = chrono::steady_clock::now();
+		long int N_events = 0;
+		while (N_events < N_events_max && !sim.checkFinished()) {
+			if (!sim.executeNextEvent()) {
+				cout << "Error! Benchmark case " << case_name << " stopped after " << N_events << " events: " << sim.getErrorMessage() << endl;
+				success = false;
+				break;
+			}
+			N_events++;
+		}
+		auto time_end = chrono::steady_clock::now();
+		double init_time = chrono::duration<double>(time_init - time_start).count();
+		double run_time = chrono::duration<double>(time_end - time_init).count();
+		double event_rate = (run_time > 0) ? N_events / run_time : 0.0;
+		double peak_memory = getPeakMemoryUsage();
+		cout << case_name << ": " << N_events << " events in " << run_time << " s (" << event_rate << " events/s), initialization in " << init_time << " s, peak memory " << peak_memory << " MB." << endl;
+		results << case_name << "," << N_events << "," << init_time << "," << run_time << "," << event_rate << "," << peak_memory;
+		if (!baseline_rates.empty()) {
+			auto baseline_it = baseline_rates.find(case_name);
+			if (baseline_it != baseline_rates.end() && baseline_it->second > 0) {
+				cout << case_name << ": Speedup relative to the baseline is " << event_rate / baseline_it->second << "." << endl;
+				results << "," << baseline_it->second << "," << event_rate / baseline_it->second;
+			}
+			else {
+				cout << case_name << ": No baseline result was found." << endl;
+				results << ",,";
+			}
+		}
+		results << "\n";
+	}
+	ofstream resultsfile("benchmark_results.txt");
+	resultsfile << "Excimontec " << version << " Benchmark Results:\n";
+	resultsfile << parameter_filenames.size() << " cases were run with a budget of " << N_events_max << " events per case and a random number seed of " << Benchmark_seed << ".\n\n";
+	resultsfile << results.str();
+	resultsfile.close();
+	cout << "Benchmark results were written to benchmark_results.txt." << endl;
+	return success;
+}
+
+int main(int argc, char *argv[]) {
+	// Initialize variables
+	Parameters params;
+	string batch_path = "";
+	int N_procs_per_run = 1;
+	string benchmark_path = "";
+	long int N_benchmark_events = 100000;
+	string baseline_filename = "";
+	int nproc = 1;
+	int procid = 0;
+	// Check command line arguments
+	if (argc < 2) {
+		cout << "Error! You must input the parameter file name or a batch of parameter files as a command line argument." << endl;
+		return 0;
+	}
+	// Check for command line site energies file conversion between the text and binary formats
+	if (argc == 4 && string(argv[1]).compare("-convert_energies") == 0) {
+		cout << "Converting site energies file " << argv[2] << " to " << argv[3] << "... " << endl;
+		if (OSC_Sim::convertEnergiesFile(argv[2], argv[3])) {
+			cout << "Site energies file conversion complete!" << endl;
+		}
+		return 0;
+	}
+	// Check for command line event trace decoding to the text log format
+	if (argc == 4 && string(argv[1]).compare("-decode_trace") == 0) {
+		cout << "Decoding event trace file " << argv[2] << " to " << argv[3] << "... " << endl;
+		if (EventTrace::decode(argv[2], argv[3])) {
+			cout << "Event trace decoding complete!" << endl;
+		}
+		return 0;
+	}
+	// Check for too many command line arguments
+	if (argc > 23) {
+		cout << "Error! Too many command line arguments." << endl;
+		return 0;
+	}
+	// Check for command line batch mode
+	int arg_start = 2;
+	if (string(argv[1]).compare("-batch") == 0) {
+		if (argc < 3) {
+			cout << "Error! You must input a directory or a list file of parameter files after the -batch option." << endl;
+			return 0;
+		}
+		batch_path = argv[2];
+		arg_start = 3;
+	}
+	// Check for command line benchmark mode, where the benchmark parameter files are taken from bench/parameters unless a path is given
+	if (string(argv[1]).compare("-benchmark") == 0) {
+		benchmark_path = "bench/parameters";
+		arg_start = 2;
+		if (argc > 2 && argv[2][0] != '-') {
+			benchmark_path = argv[2];
+			arg_start = 3;
+		}
+	}
+	// Check for command line enabled logging, event trace, raw data output, superbasin acceleration, rate thinning, escape rate cache, status check interval, test chunk size, number of threads, processors per run, checkpoint, and benchmark options
+	// Set default
+	// Results are calculated from the streaming statistics, so individual samples are only stored when requested
+	params.Enable_logging = false;
+	params.Enable_raw_data_retention = false;
+	for (int i = arg_start; i < argc; i++) {
+		string argument(argv[i]);
+		if (argument.compare("-enable_logging") == 0) {
+			params.Enable_logging = true;
+		}
+		else if (argument.compare("-enable_trace") == 0) {
+			params.Enable_event_trace = true;
+		}
+		else if (argument.compare("-enable_raw_data") == 0) {
+			params.Enable_raw_data_retention = true;
+		}
+		else if (argument.compare("-enable_superbasin") == 0) {
+			params.Enable_superbasin_acceleration = true;
+		}
+		else if (argument.compare("-enable_thinning") == 0) {
+			params.Enable_rate_thinning = true;
+		}
+		else if (argument.compare("-thinning_margin") == 0 && i + 1 < argc) {
+			i++;
+			try {
+				params.Thinning_energy_margin = stod(argv[i]);
+			}
+			catch (exception&) {
+				params.Thinning_energy_margin = -1.0;
+			}
+			if (!(params.Thinning_energy_margin > 0)) {
+				cout << "Error! The rate thinning energy margin must be a positive energy in eV." << endl;
+				return 0;
+			}
+		}
+		else if (argument.compare("-enable_escape_cache") == 0) {
+			params.Enable_escape_rate_cache = true;
+		}
+		else if (argument.compare("-escape_cache_size") == 0 && i + 1 < argc) {
+			i++;
+			try {
+				params.Escape_rate_cache_size = stoi(argv[i]);
+			}
+			catch (exception&) {
+				params.Escape_rate_cache_size = -1;
+			}
+			if (!(params.Escape_rate_cache_size > 0)) {
+				cout << "Error! The escape rate cache size must be a positive integer." << endl;
+				return 0;
+			}
+		}
+		else if (argument.compare("-status_interval") == 0 && i + 1 < argc) {
+			i++;
+			try {
+				params.Status_check_interval = stod(argv[i]);
+			}
+			catch (exception&) {
+				params.Status_check_interval = -1.0;
+			}
+			if (!(params.Status_check_interval > 0)) {
+				cout << "Error! The status check interval must be a positive number of seconds." << endl;
+				return 0;
+			}
+		}
+		else if (argument.compare("-test_chunk_size") == 0 && i + 1 < argc) {
+			i++;
+			try {
+				params.Test_chunk_size = stoi(argv[i]);
+			}
+			catch (exception&) {
+				params.Test_chunk_size = -1;
+			}
+			if (!(params.Test_chunk_size > 0)) {
+				cout << "Error! The test chunk size must be a positive integer." << endl;
+				return 0;
+			}
+		}
+		else if (argument.compare("-threads") == 0 && i + 1 < argc) {
+			i++;
+			try {
+				params.N_threads = stoi(argv[i]);
+			}
+			catch (exception&) {
+				params.N_threads = -1;
+			}
+			if (!(params.N_threads > 0)) {
+				cout << "Error! The number of threads must be a positive integer." << endl;
+				return 0;
+			}
+		}
+		else if (argument.compare("-checkpoint_interval") == 0 && i + 1 < argc) {
+			i++;
+			try {
+				params.Checkpoint_interval = stod(argv[i]);
+			}
+			catch (exception&) {
+				params.Checkpoint_interval = -1.0;
+			}
+			if (!(params.Checkpoint_interval > 0)) {
+				cout << "Error! The checkpoint interval must be a positive number of seconds." << endl;
+				return 0;
+			}
+		}
+		else if (argument.compare("-restart") == 0) {
+			params.Enable_restart = true;
+		}
+		else if (argument.compare("-procs_per_run") == 0 && i + 1 < argc && !batch_path.empty()) {
+			i++;
+			try {
+				N_procs_per_run = stoi(argv[i]);
+			}
+			catch (exception&) {
+				N_procs_per_run = -1;
+			}
+			if (!(N_procs_per_run > 0)) {
+				cout << "Error! The number of processors per run must be a positive integer." << endl;
+				return 0;
+			}
+		}
+		else if (argument.compare("-benchmark_events") == 0 && i + 1 < argc && !benchmark_path.empty()) {
+			i++;
+			try {
+				N_benchmark_events = stol(argv[i]);
+			}
+			catch (exception&) {
+				N_benchmark_events = -1;
+			}
+			if (!(N_benchmark_events > 0)) {
+				cout << "Error! The number of benchmark events must be a positive integer." << endl;
+				return 0;
+			}
+		}
+		else if (argument.compare("-baseline") == 0 && i + 1 < argc && !benchmark_path.empty()) {
+			i++;
+			baseline_filename = argv[i];
+		}
+		else {
+			cout << "Error! Invalid command line argument." << endl;
+			return 0;
+		}
+	}
+	// Initialize mpi options
+	cout << "Initializing MPI options... ";
+	if (params.N_threads == 1) {
+		MPI_Init(&argc, &argv);
+	}
+	else {
+		// Only the main thread makes MPI calls in multi-threaded mode
+		int thread_support;
+		MPI_Init_thread(&argc, &argv, MPI_THREAD_FUNNELED, &thread_support);
+		if (thread_support < MPI_THREAD_FUNNELED) {
+			cout << "Error! The MPI library does not support multi-threaded processes." << endl;
+			MPI_Finalize();
+			return 0;
+		}
+	}
+	MPI_Comm_size(MPI_COMM_WORLD, &nproc);
+	MPI_Comm_rank(MPI_COMM_WORLD, &procid);
+	cout << procid << ": MPI initialization complete!" << endl;
+	// Checkpoints are written on request when the process receives SIGUSR1, and SIGTERM stops the simulation after checkpoints are written
+	if (params.Checkpoint_interval > 0) {
+		signal(SIGTERM, handleCheckpointSignal);
+#ifdef SIGUSR1
+		signal(SIGUSR1, handleCheckpointSignal);
+#endif
+	}
+	// Benchmark mode
+	// The benchmark cases only run on proc 0, so that the timings are not affected by other procs
+	if (!benchmark_path.empty()) {
+		if (procid == 0) {
+			vector<string> parameter_filenames;
+			if (!getBatchParameterFiles(benchmark_path, parameter_filenames) || parameter_filenames.empty()) {
+				cout << procid << ": Error! No benchmark parameter files could be found in " << benchmark_path << "." << endl;
+			}
+			else if (!runBenchmark(params, parameter_filenames, N_benchmark_events, baseline_filename)) {
+				cout << procid << ": Error! One or more benchmark cases could not be completed." << endl;
+			}
+		}
+		MPI_Finalize();
+		return 0;
+	}
+	// Run a single simulation on all procs
+	if (batch_path.empty()) {
+		if (runSimulation(params, argv[1], "", MPI_COMM_WORLD) == RunStatus::Aborted) {
+			return 0;
+		}
+		MPI_Finalize();
+		return 0;
+	}
+	// Batch mode
+	// The procs are split into groups of N_procs_per_run procs with a separate communicator for each group
+	// Each group claims the next run from a shared counter on proc 0 whenever it finishes a run, and the output of each run is written to a
+	// subdirectory named after the parameter file
+	vector<string> parameter_filenames;
+	if (!getBatchParameterFiles(batch_path, parameter_filenames) || parameter_filenames.empty()) {
+		cout << procid << ": Error! No parameter files could be found in " << batch_path << "." << endl;
+		MPI_Finalize();
+		return 0;
+	}
+	vector<string> output_dirs;
+	for (auto& item : parameter_filenames) {
+		output_dirs.push_back(getFileStem(item));
+	}
+	vector<string> output_dirs_sorted = output_dirs;
+	sort(output_dirs_sorted.begin(), output_dirs_sorted.end());
+	if (adjacent_find(output_dirs_sorted.begin(), output_dirs_sorted.end()) != output_dirs_sorted.end()) {
+		cout << procid << ": Error! The parameter files in a batch must have different file names." << endl;
+		MPI_Finalize();
+		return 0;
+	}
+	if (nproc % N_procs_per_run != 0) {
+		cout << procid << ": Error! The number of processors must be a multiple of the number of processors per run." << endl;
+		MPI_Finalize();
+		return 0;
+	}
+	int N_runs = (int)parameter_filenames.size();
+	string launch_dir = getWorkingDirectory();
+	int group_id = procid / N_procs_per_run;
+	MPI_Comm run_comm;
+	MPI_Comm_split(MPI_COMM_WORLD, group_id, procid, &run_comm);
+	int run_procid;
+	MPI_Comm_rank(run_comm, &run_procid);
+	int* runs_claimed_ptr;
+	MPI_Win runs_win;
+	MPI_Win_allocate((procid == 0) ? (MPI_Aint)sizeof(int) : 0, sizeof(int), MPI_INFO_NULL, MPI_COMM_WORLD, &runs_claimed_ptr, &runs_win);
+	if (procid == 0) {
+		MPI_Win_lock(MPI_LOCK_EXCLUSIVE, 0, 0, runs_win);
+		*runs_claimed_ptr = 0;
+		MPI_Win_unlock(0, runs_win);
+	}
 	MPI_Barrier(MPI_COMM_WORLD);
+	// Each run record contains the run index, the run status, and the calculation time
+	vector<double> run_records;
+	while (true) {
+		// No more runs are claimed after a stop signal
+		int run_index = N_runs;
+		if (run_procid == 0 && stop_signal == 0) {
+			int increment = 1;
+			MPI_Win_lock(MPI_LOCK_SHARED, 0, 0, runs_win);
+			MPI_Fetch_and_op(&increment, &run_index, MPI_INT, 0, 0, MPI_SUM, runs_win);
+			MPI_Win_unlock(0, runs_win);
+		}
+		MPI_Bcast(&run_index, 1, MPI_INT, 0, run_comm);
+		if (run_index >= N_runs) {
+			break;
+		}
+		if (run_procid == 0) {
+			cout << procid << ": Starting run " << run_index << " with " << parameter_filenames[run_index] << " on processor group " << group_id << "..." << endl;
+		}
+		double run_start = MPI_Wtime();
+		RunStatus status = runSimulation(params, parameter_filenames[run_index], output_dirs[run_index], run_comm);
+		setWorkingDirectory(launch_dir);
+		if (run_procid == 0) {
+			run_records.push_back((double)run_index);
+			run_records.push_back((double)status);
+			run_records.push_back(MPI_Wtime() - run_start);
+		}
+		if (status == RunStatus::Stopped) {
+			break;
+		}
+	}
+	MPI_Win_free(&runs_win);
+	// Gather the run records to proc 0 and write the batch summary
+	int N_records_local = (int)run_records.size();
+	vector<int> N_records(nproc, 0);
+	MPI_Gather(&N_records_local, 1, MPI_INT, N_records.data(), 1, MPI_INT, 0, MPI_COMM_WORLD);
+	vector<int> record_displacements(nproc, 0);
+	for (int i = 1; i < nproc; i++) {
+		record_displacements[i] = record_displacements[i - 1] + N_records[i - 1];
+	}
+	vector<double> run_records_all(accumulate(N_records.begin(), N_records.end(), 0), 0.0);
+	MPI_Gatherv(run_records.data(), N_records_local, MPI_DOUBLE, run_records_all.data(), N_records.data(), record_displacements.data(), MPI_DOUBLE, 0, MPI_COMM_WORLD);
+	if (procid == 0) {
+		vector<string> status_names = { "Finished", "Error", "Aborted", "Stopped" };
+		vector<string> run_status(N_runs, "Not run");
+		vector<double> run_times(N_runs, 0.0);
+		for (int i = 0; i + 2 < (int)run_records_all.size(); i += 3) {
+			int run_index = (int)run_records_all[i];
+			run_status[run_index] = status_names[(int)run_records_all[i + 1]];
+			run_times[run_index] = run_records_all[i + 2];
+		}
+		ofstream summaryfile("batch_summary.txt");
+		summaryfile << "Excimontec " << version << " Batch Summary:\n";
+		summaryfile << N_runs << " runs were performed on " << nproc << " processors with " << N_procs_per_run << " processors per run.\n\n";
+		summaryfile << "Run,Parameter File,Output Directory,Status,Calculation Time (min)\n";
+		for (int i = 0; i < N_runs; i++) {
+			summaryfile << i << "," << parameter_filenames[i] << "," << output_dirs[i] << "," << run_status[i] << "," << run_times[i] / 60 << "\n";
+		}
+		summaryfile.close();
+	}
+	MPI_Comm_free(&run_comm);
 	MPI_Finalize();
 	return 0;
 }
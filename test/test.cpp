@@ -4,16 +4,54 @@
 // The Excimontec project can be found on Github at https://github.com/MikeHeiber/Excimontec
 
 #include "gtest/gtest.h"
+#include "EscapeRateCache.h"
+#include "EventHeap.h"
+#include "EventTrace.h"
 #include "OSC_Sim.h"
 #include "Parameters.h"
 #include "Exciton.h"
+#include "Histogram.h"
+#include "RateTree.h"
+#include "Statistics.h"
 #include "Utils.h"
 #include <cmath>
+#include <cstdio>
+#include <random>
+#include <set>
+#include <tuple>
 
 using namespace std;
 using namespace KMC_Lattice;
 using namespace Excimontec;
 
+namespace Excimontec {
+
+	//! \brief This class gives the unit tests access to the private functions of the OSC_Sim class.
+	class OSC_SimTestAccess {
+	public:
+		static double calculateCoulomb(const OSC_Sim& sim, const bool charge, const Coords& coords) {
+			return sim.calculateCoulomb(charge, coords);
+		}
+
+		static void calculateCoulombField(const OSC_Sim& sim, const bool charge, vector<double>& energies) {
+			sim.calculateCoulombField(charge, energies);
+		}
+
+		static void generateElectron(OSC_Sim& sim, const Coords& coords) {
+			sim.generateElectron(coords, 0);
+		}
+
+		static void generateHole(OSC_Sim& sim, const Coords& coords) {
+			sim.generateHole(coords, 0);
+		}
+
+		static long int getSiteIndex(const OSC_Sim& sim, const Coords& coords) {
+			return sim.lattice.getSiteIndex(coords);
+		}
+	};
+
+}
+
 namespace OSC_SimTests {
 
 	class OSC_SimTest : public ::testing::Test {
@@ -506,6 +544,59 @@ namespace OSC_SimTests {
 		params = params_default;
 		params.Coulomb_cutoff = 0;
 		EXPECT_FALSE(sim.init(params, 0));
+		// Superbasin acceleration options
+		params = params_default;
+		params.Enable_superbasin_acceleration = true;
+		params.Superbasin_max_sites = 1;
+		EXPECT_FALSE(sim.init(params, 0));
+		params = params_default;
+		params.Enable_superbasin_acceleration = true;
+		params.Superbasin_min_hops = 0;
+		EXPECT_FALSE(sim.init(params, 0));
+		params = params_default;
+		params.Enable_exciton_diffusion_test = false;
+		params.Enable_steady_transport_test = true;
+		params.Steady_carrier_density = 1e18;
+		params.Internal_potential = -1.0;
+		params.Enable_superbasin_acceleration = true;
+		EXPECT_FALSE(sim.init(params, 0));
+		// Rate thinning options
+		params = params_default;
+		params.Enable_rate_thinning = true;
+		params.Thinning_energy_margin = 0;
+		EXPECT_FALSE(sim.init(params, 0));
+		// Escape rate cache options
+		params = params_default;
+		params.Enable_escape_rate_cache = true;
+		params.Escape_rate_cache_size = 0;
+		EXPECT_FALSE(sim.init(params, 0));
+		params = params_default;
+		params.Enable_escape_rate_cache = true;
+		params.Enable_rate_thinning = true;
+		EXPECT_FALSE(sim.init(params, 0));
+		params = params_default;
+		params.Enable_exciton_diffusion_test = false;
+		params.Enable_IQE_test = true;
+		params.Enable_neat = false;
+		params.Enable_bilayer = true;
+		params.Params_lattice.Enable_periodic_z = false;
+		params.Params_lattice.Height = 20;
+		params.Thickness_donor = 10;
+		params.Thickness_acceptor = 10;
+		params.Enable_escape_rate_cache = true;
+		EXPECT_FALSE(sim.init(params, 0));
+		params = params_default;
+		params.Enable_exciton_diffusion_test = false;
+		params.Enable_dynamics_test = true;
+		params.Enable_escape_rate_cache = true;
+		EXPECT_FALSE(sim.init(params, 0));
+		params = params_default;
+		params.Enable_exciton_diffusion_test = false;
+		params.Enable_steady_transport_test = true;
+		params.Steady_carrier_density = 1e18;
+		params.Internal_potential = -1.0;
+		params.Enable_escape_rate_cache = true;
+		EXPECT_FALSE(sim.init(params, 0));
 	}
 
 	TEST_F(OSC_SimTest, SetupTests) {
@@ -515,6 +606,221 @@ namespace OSC_SimTests {
 		auto params = params_default;
 		EXPECT_TRUE(sim.init(params, 0));
 		EXPECT_EQ(params.Params_lattice.Length*params.Params_lattice.Width*params.Params_lattice.Height*1e-21, sim.getVolume());
+		// Check that simulations with the same fixed random number seed execute the same events
+		params.Generator_seed = 7;
+		params.Enable_gaussian_dos = true;
+		OSC_Sim sim2;
+		EXPECT_TRUE(sim.init(params, 0));
+		EXPECT_TRUE(sim2.init(params, 0));
+		for (int i = 0; i < 1000; i++) {
+			EXPECT_TRUE(sim.executeNextEvent());
+			EXPECT_TRUE(sim2.executeNextEvent());
+		}
+		EXPECT_DOUBLE_EQ(sim.getTime(), sim2.getTime());
+		EXPECT_EQ(sim.getExcitonDiffusionData(), sim2.getExcitonDiffusionData());
+	}
+
+	TEST_F(OSC_SimTest, ResetTests) {
+		cout << "Starting OSC_SimTest.ResetTests..." << endl;
+		// Start an IQE test and stop it while objects and events are still present
+		sim = OSC_Sim();
+		auto params = params_default;
+		params.Enable_exciton_diffusion_test = false;
+		params.Enable_IQE_test = true;
+		params.Enable_neat = false;
+		params.Enable_bilayer = true;
+		params.Params_lattice.Enable_periodic_z = false;
+		params.Params_lattice.Height = 20;
+		params.Thickness_donor = 10;
+		params.Thickness_acceptor = 10;
+		params.Exciton_generation_rate_donor = 1e25;
+		params.N_tests = 1000;
+		EXPECT_TRUE(sim.init(params, 0));
+		for (int i = 0; i < 5000; i++) {
+			EXPECT_TRUE(sim.executeNextEvent());
+		}
+		EXPECT_TRUE(sim.getN_excitons_created() > 0);
+		// Reset to an exciton diffusion test with a different architecture, which requires a full initialization
+		params = params_default;
+		params.N_tests = 1000;
+		EXPECT_TRUE(sim.reset(params));
+		EXPECT_EQ(0, sim.getN_excitons_created());
+		EXPECT_EQ(0, sim.getN_events_executed());
+		EXPECT_DOUBLE_EQ(0.0, sim.getTime());
+		while (!sim.checkFinished()) {
+			EXPECT_TRUE(sim.executeNextEvent());
+		}
+		EXPECT_EQ(params.N_tests, sim.getN_excitons_created());
+		EXPECT_EQ((double)params.N_tests, sim.getExcitonLifetimeStats().getCount());
+		// Reset with the same architecture and a different exciton lifetime
+		params.Singlet_lifetime_donor = 2 * params_default.Singlet_lifetime_donor;
+		EXPECT_TRUE(sim.reset(params));
+		EXPECT_EQ(0, sim.getN_excitons_created());
+		EXPECT_DOUBLE_EQ(0.0, sim.getTime());
+		while (!sim.checkFinished()) {
+			EXPECT_TRUE(sim.executeNextEvent());
+		}
+		EXPECT_EQ(params.N_tests, sim.getN_excitons_created());
+		EXPECT_EQ(params.N_tests, sim.getN_singlet_excitons_recombined() + sim.getN_triplet_excitons_recombined());
+		EXPECT_EQ((double)params.N_tests, sim.getExcitonLifetimeStats().getCount());
+		EXPECT_NEAR(params.Singlet_lifetime_donor, sim.getExcitonLifetimeStats().getMean(), 0.1*params.Singlet_lifetime_donor);
+		// Check that invalid parameters are detected
+		params.Params_lattice.Length = 0;
+		EXPECT_FALSE(sim.reset(params));
+	}
+
+	TEST_F(OSC_SimTest, CheckpointTests) {
+		cout << "Starting OSC_SimTest.CheckpointTests..." << endl;
+		// Run an IQE test past the point where a checkpoint is written
+		sim = OSC_Sim();
+		auto params = params_default;
+		params.Enable_exciton_diffusion_test = false;
+		params.Enable_IQE_test = true;
+		params.Enable_neat = false;
+		params.Enable_bilayer = true;
+		params.Params_lattice.Enable_periodic_z = false;
+		params.Params_lattice.Height = 20;
+		params.Thickness_donor = 10;
+		params.Thickness_acceptor = 10;
+		params.Exciton_generation_rate_donor = 1e25;
+		params.Internal_potential = -1.0;
+		params.N_tests = 1000;
+		EXPECT_TRUE(sim.init(params, 0));
+		for (int i = 0; i < 5000; i++) {
+			EXPECT_TRUE(sim.executeNextEvent());
+		}
+		EXPECT_TRUE(sim.exportCheckpoint("./test/checkpoint_test.bin"));
+		ifstream temp_file("./test/checkpoint_test.bin.tmp");
+		EXPECT_FALSE(temp_file.good());
+		temp_file.close();
+		for (int i = 0; i < 5000; i++) {
+			EXPECT_TRUE(sim.executeNextEvent());
+		}
+		// Check that the restarted simulation follows the same trajectory
+		OSC_Sim sim2;
+		EXPECT_TRUE(sim2.importCheckpoint(params, 0, "./test/checkpoint_test.bin"));
+		EXPECT_EQ(5000, sim2.getN_events_executed());
+		for (int i = 0; i < 5000; i++) {
+			EXPECT_TRUE(sim2.executeNextEvent());
+		}
+		EXPECT_EQ(sim.getN_events_executed(), sim2.getN_events_executed());
+		EXPECT_DOUBLE_EQ(sim.getTime(), sim2.getTime());
+		EXPECT_EQ(sim.getN_excitons_created(), sim2.getN_excitons_created());
+		EXPECT_EQ(sim.getN_singlet_excitons_dissociated(), sim2.getN_singlet_excitons_dissociated());
+		EXPECT_EQ(sim.getN_electrons_collected(), sim2.getN_electrons_collected());
+		EXPECT_EQ(sim.getN_holes_collected(), sim2.getN_holes_collected());
+		EXPECT_EQ(sim.getN_geminate_recombinations(), sim2.getN_geminate_recombinations());
+		EXPECT_EQ(sim.getN_bimolecular_recombinations(), sim2.getN_bimolecular_recombinations());
+		// Check that the restarted simulation finishes with the same results
+		while (!sim.checkFinished()) {
+			EXPECT_TRUE(sim.executeNextEvent());
+		}
+		while (!sim2.checkFinished()) {
+			EXPECT_TRUE(sim2.executeNextEvent());
+		}
+		EXPECT_EQ(sim.getN_events_executed(), sim2.getN_events_executed());
+		EXPECT_DOUBLE_EQ(sim.getTime(), sim2.getTime());
+		EXPECT_EQ(sim.getN_electrons_collected(), sim2.getN_electrons_collected());
+		EXPECT_EQ(sim.getN_holes_collected(), sim2.getN_holes_collected());
+		// Check that the steady transport test continues on the same trajectory after a restart
+		params = params_default;
+		params.Enable_exciton_diffusion_test = false;
+		params.Enable_steady_transport_test = true;
+		params.Steady_carrier_density = 1e18;
+		params.N_equilibration_events = 1000;
+		params.N_tests = 5000;
+		params.Internal_potential = -1.0;
+		params.Enable_gaussian_dos = true;
+		params.Energy_stdev_donor = 0.075;
+		params.Energy_stdev_acceptor = 0.075;
+		sim = OSC_Sim();
+		EXPECT_TRUE(sim.init(params, 0));
+		for (int i = 0; i < 2000; i++) {
+			EXPECT_TRUE(sim.executeNextEvent());
+		}
+		EXPECT_TRUE(sim.exportCheckpoint("./test/checkpoint_test.bin"));
+		while (!sim.checkFinished()) {
+			EXPECT_TRUE(sim.executeNextEvent());
+		}
+		sim2 = OSC_Sim();
+		EXPECT_TRUE(sim2.importCheckpoint(params, 0, "./test/checkpoint_test.bin"));
+		while (!sim2.checkFinished()) {
+			EXPECT_TRUE(sim2.executeNextEvent());
+		}
+		EXPECT_DOUBLE_EQ(sim.getTime(), sim2.getTime());
+		EXPECT_DOUBLE_EQ(sim.getSteadyMobility(), sim2.getSteadyMobility());
+		EXPECT_DOUBLE_EQ(sim.getSteadyTransportEnergy(), sim2.getSteadyTransportEnergy());
+		// Check that the steady transport test with rate thinning continues on the same trajectory after a restart
+		params.Enable_rate_thinning = true;
+		sim = OSC_Sim();
+		EXPECT_TRUE(sim.init(params, 0));
+		for (int i = 0; i < 2000; i++) {
+			EXPECT_TRUE(sim.executeNextEvent());
+		}
+		EXPECT_TRUE(sim.exportCheckpoint("./test/checkpoint_test.bin"));
+		while (!sim.checkFinished()) {
+			EXPECT_TRUE(sim.executeNextEvent());
+		}
+		sim2 = OSC_Sim();
+		EXPECT_TRUE(sim2.importCheckpoint(params, 0, "./test/checkpoint_test.bin"));
+		while (!sim2.checkFinished()) {
+			EXPECT_TRUE(sim2.executeNextEvent());
+		}
+		EXPECT_GT(sim.getN_null_events(), 0);
+		EXPECT_EQ(sim.getN_null_events(), sim2.getN_null_events());
+		EXPECT_DOUBLE_EQ(sim.getTime(), sim2.getTime());
+		EXPECT_DOUBLE_EQ(sim.getSteadyMobility(), sim2.getSteadyMobility());
+		EXPECT_DOUBLE_EQ(sim.getSteadyTransportEnergy(), sim2.getSteadyTransportEnergy());
+		// Check that the ToF test with superbasin acceleration and the escape rate cache continues on the same trajectory after a restart
+		params = params_default;
+		params.Params_lattice.Enable_periodic_z = false;
+		params.Params_lattice.Height = 100;
+		params.Internal_potential = -2.0;
+		params.Enable_exciton_diffusion_test = false;
+		params.Enable_ToF_test = true;
+		params.N_tests = 50;
+		params.Enable_gaussian_dos = true;
+		params.Energy_stdev_donor = 0.1;
+		params.Enable_superbasin_acceleration = true;
+		params.Enable_escape_rate_cache = true;
+		sim = OSC_Sim();
+		EXPECT_TRUE(sim.init(params, 0));
+		for (int i = 0; i < 100000; i++) {
+			EXPECT_TRUE(sim.executeNextEvent());
+		}
+		EXPECT_TRUE(sim.exportCheckpoint("./test/checkpoint_test.bin"));
+		while (!sim.checkFinished()) {
+			EXPECT_TRUE(sim.executeNextEvent());
+		}
+		sim2 = OSC_Sim();
+		EXPECT_TRUE(sim2.importCheckpoint(params, 0, "./test/checkpoint_test.bin"));
+		EXPECT_EQ(100000, sim2.getN_events_executed());
+		while (!sim2.checkFinished()) {
+			EXPECT_TRUE(sim2.executeNextEvent());
+		}
+		EXPECT_GT(sim.getN_superbasin_exits(), 0);
+		EXPECT_EQ(sim.getN_events_executed(), sim2.getN_events_executed());
+		EXPECT_EQ(sim.getN_superbasin_exits(), sim2.getN_superbasin_exits());
+		EXPECT_EQ(sim.getN_null_events(), sim2.getN_null_events());
+		EXPECT_DOUBLE_EQ(sim.getTime(), sim2.getTime());
+		EXPECT_EQ(sim.getTransitTimeData(), sim2.getTransitTimeData());
+		// Check that a checkpoint from a simulation with a different ID or lattice is rejected
+		sim2 = OSC_Sim();
+		EXPECT_FALSE(sim2.importCheckpoint(params, 1, "./test/checkpoint_test.bin"));
+		params.Params_lattice.Length = 40;
+		EXPECT_FALSE(sim2.importCheckpoint(params, 0, "./test/checkpoint_test.bin"));
+		params.Params_lattice.Length = params_default.Params_lattice.Length;
+		// Check that a missing or truncated checkpoint file is rejected
+		EXPECT_FALSE(sim2.importCheckpoint(params, 0, "./test/checkpoint_missing.bin"));
+		ifstream checkpoint_file("./test/checkpoint_test.bin", ifstream::in | ifstream::binary);
+		string checkpoint_data((istreambuf_iterator<char>(checkpoint_file)), istreambuf_iterator<char>());
+		checkpoint_file.close();
+		ofstream truncated_file("./test/checkpoint_test.bin", ofstream::out | ofstream::binary);
+		truncated_file.write(checkpoint_data.data(), checkpoint_data.size() - 100);
+		truncated_file.close();
+		EXPECT_FALSE(sim2.importCheckpoint(params, 0, "./test/checkpoint_test.bin"));
+		EXPECT_TRUE(sim2.getErrorMessage().size() > 0);
+		remove("./test/checkpoint_test.bin");
 	}
 
 	TEST_F(OSC_SimTest, GetSiteTests) {
@@ -668,6 +974,21 @@ namespace OSC_SimTests {
 		// Try to create another exciton
 		sim.createExciton(Coords(0, 0, 0), false);
 		EXPECT_TRUE(sim.getErrorStatus());
+		// Test random exciton creation until every site of a small lattice is filled
+		params.Params_lattice.Length = 3;
+		params.Params_lattice.Width = 3;
+		params.Params_lattice.Height = 3;
+		sim = OSC_Sim();
+		EXPECT_TRUE(sim.init(params, 0));
+		for (int i = 0; i < 27; i++) {
+			sim.createExciton(true);
+		}
+		EXPECT_FALSE(sim.getErrorStatus());
+		EXPECT_EQ(27, sim.getN_excitons_created());
+		// Try to create another exciton
+		sim.createExciton(true);
+		EXPECT_TRUE(sim.getErrorStatus());
+		EXPECT_EQ("An empty site for exciton creation could not be found.", sim.getErrorMessage());
 	}
 
 	TEST_F(OSC_SimTest, LoggingTests) {
@@ -734,6 +1055,111 @@ namespace OSC_SimTests {
 		}
 	}
 
+	TEST_F(OSC_SimTest, EventTraceTests) {
+		cout << "Starting OSC_SimTest.EventTraceTests..." << endl;
+		// Check that the trace record kinds match the event types of the event classes
+		EXPECT_EQ(Exciton::Creation::event_type, EventTrace::getEventType(EventTrace::Exciton_creation));
+		EXPECT_EQ(Exciton::Hop::event_type, EventTrace::getEventType(EventTrace::Exciton_hop));
+		EXPECT_EQ(Exciton::Recombination::event_type, EventTrace::getEventType(EventTrace::Exciton_recombination));
+		EXPECT_EQ(Exciton::Dissociation::event_type, EventTrace::getEventType(EventTrace::Exciton_dissociation));
+		EXPECT_EQ(Exciton::Exciton_Annihilation::event_type, EventTrace::getEventType(EventTrace::Exciton_exciton_annihilation));
+		EXPECT_EQ(Exciton::Polaron_Annihilation::event_type, EventTrace::getEventType(EventTrace::Exciton_polaron_annihilation));
+		EXPECT_EQ(Exciton::Intersystem_Crossing::event_type, EventTrace::getEventType(EventTrace::Exciton_intersystem_crossing));
+		EXPECT_EQ(Polaron::Hop::event_type, EventTrace::getEventType(EventTrace::Polaron_hop));
+		EXPECT_EQ(Polaron::Recombination::event_type, EventTrace::getEventType(EventTrace::Polaron_recombination));
+		EXPECT_EQ(Polaron::Extraction::event_type, EventTrace::getEventType(EventTrace::Polaron_extraction));
+		EXPECT_EQ("", EventTrace::getEventType(EventTrace::N_kinds));
+		sim = OSC_Sim();
+		auto params = params_default;
+		// Enable logging so that the decoded trace can be compared to the text log
+		params.Enable_logging = true;
+		ofstream logfile("./test/log.txt");
+		params.Logfile = &logfile;
+		// Run the same high generation rate random blend IQE test as the logging test to record a variety of event types
+		params.Enable_neat = false;
+		params.Enable_random_blend = true;
+		params.Acceptor_conc = 0.2;
+		params.Triplet_lifetime_donor = 1e-7;
+		params.Triplet_lifetime_acceptor = 1e-7;
+		params.Enable_FRET_triplet_annihilation = true;
+		params.R_triplet_hopping_donor = 1e10;
+		params.R_triplet_hopping_acceptor = 1e10;
+		params.R_exciton_exciton_annihilation_donor = 1e14;
+		params.R_exciton_exciton_annihilation_acceptor = 1e14;
+		params.R_exciton_polaron_annihilation_donor = 1e14;
+		params.R_exciton_polaron_annihilation_acceptor = 1e14;
+		params.R_exciton_isc_donor = 1e11;
+		params.R_exciton_isc_acceptor = 1e11;
+		params.R_exciton_risc_donor = 1e11;
+		params.R_exciton_risc_acceptor = 1e11;
+		params.E_exciton_ST_donor = 0.1;
+		params.E_exciton_ST_acceptor = 0.1;
+		params.R_polaron_hopping_donor = 1e10;
+		params.R_polaron_hopping_acceptor = 1e10;
+		params.R_polaron_recombination = 1e11;
+		params.Enable_gaussian_polaron_delocalization = true;
+		params.Polaron_delocalization_length = 4.0;
+		params.Exciton_generation_rate_donor = 1e26;
+		params.Exciton_generation_rate_acceptor = 1e26;
+		params.Internal_potential = -0.5;
+		EXPECT_TRUE(sim.init(params, 0));
+		// Use a small ring buffer so that the buffer wraps around and fills up many times
+		EventTrace trace;
+		EXPECT_FALSE(trace.open("./test/trace.bin", params.Params_lattice.Length, params.Params_lattice.Width, params.Params_lattice.Height, 0));
+		EXPECT_TRUE(trace.open("./test/trace.bin", params.Params_lattice.Length, params.Params_lattice.Width, params.Params_lattice.Height, 64));
+		EXPECT_TRUE(trace.isOpen());
+		EXPECT_FALSE(trace.open("./test/trace.bin", params.Params_lattice.Length, params.Params_lattice.Width, params.Params_lattice.Height, 64));
+		sim.setEventTrace(&trace);
+		for (int i = 0; i < 5000; i++) {
+			sim.executeNextEvent();
+		}
+		sim.setEventTrace(nullptr);
+		trace.close();
+		EXPECT_FALSE(trace.isOpen());
+		logfile.close();
+		// Decode the trace and check that every decoded line appears in the text log in the same order
+		// Exciton dissociations are logged as the creation of the new polarons, so the decoded exciton dissociation lines are not in the text log
+		EXPECT_TRUE(EventTrace::decode("./test/trace.bin", "./test/trace.txt"));
+		ifstream logfile_in("./test/log.txt");
+		ifstream tracefile_in("./test/trace.txt");
+		string line;
+		vector<string> log_lines;
+		while (getline(logfile_in, line)) {
+			log_lines.push_back(line);
+		}
+		int N_event_lines = 0;
+		int N_dissociation_lines = 0;
+		auto log_it = log_lines.begin();
+		while (getline(tracefile_in, line)) {
+			if (line.find("Event " + to_string(N_event_lines) + ": ") == 0) {
+				N_event_lines++;
+			}
+			if (line.find(" dissociated at site ") != string::npos) {
+				N_dissociation_lines++;
+				continue;
+			}
+			log_it = find(log_it, log_lines.end(), line);
+			EXPECT_TRUE(log_it != log_lines.end()) << line;
+			if (log_it == log_lines.end()) {
+				break;
+			}
+		}
+		EXPECT_EQ(5000, N_event_lines);
+		EXPECT_GT(N_dissociation_lines, 0);
+		logfile_in.close();
+		tracefile_in.close();
+		// Check that files that are not complete trace files are rejected
+		EXPECT_FALSE(EventTrace::decode("./test/trace_missing.bin", "./test/trace.txt"));
+		EXPECT_FALSE(EventTrace::decode("./test/log.txt", "./test/trace.txt"));
+		ifstream trace_in("./test/trace.bin", ifstream::in | ifstream::binary);
+		string trace_data((istreambuf_iterator<char>(trace_in)), istreambuf_iterator<char>());
+		trace_in.close();
+		ofstream trace_out("./test/trace_truncated.bin", ofstream::out | ofstream::binary);
+		trace_out.write(trace_data.data(), trace_data.size() - 1);
+		trace_out.close();
+		EXPECT_FALSE(EventTrace::decode("./test/trace_truncated.bin", "./test/trace.txt"));
+	}
+
 	TEST_F(OSC_SimTest, EnergiesImportTests) {
 		cout << "Starting OSC_SimTest.EnergiesImportTests..." << endl;
 		// Create sample energies file
@@ -760,6 +1186,51 @@ namespace OSC_SimTests {
 		auto site_energies = sim.getSiteEnergies(1);
 		EXPECT_NEAR(0, vector_avg(site_energies), 5e-3);
 		EXPECT_NEAR(energies_stdev1, vector_stdev(site_energies), 1e-4);
+		// Test binary export and import
+		EXPECT_TRUE(sim.exportEnergiesBinary("./test/energies.bin", true));
+		// Test binary export to a directory that does not exist
+		EXPECT_FALSE(sim.exportEnergiesBinary("./test/missing_dir/energies.bin", true));
+		sim = OSC_Sim();
+		params.Energies_import_filename = "./test/energies.bin";
+		EXPECT_TRUE(sim.init(params, 0));
+		EXPECT_TRUE(site_energies == sim.getSiteEnergies(1));
+		// Test replicas that share the imported site energies
+		auto shared_data = OSC_Sim::createSharedData(params);
+		EXPECT_EQ(params.Params_lattice.Length*params.Params_lattice.Width*params.Params_lattice.Height, (int)shared_data->site_energies.size());
+		OSC_Sim sim2;
+		sim.setSharedData(shared_data);
+		sim2.setSharedData(shared_data);
+		EXPECT_TRUE(sim.init(params, 0));
+		EXPECT_TRUE(sim2.init(params, 1));
+		EXPECT_TRUE(site_energies == sim.getSiteEnergies(1));
+		EXPECT_TRUE(site_energies == sim2.getSiteEnergies(1));
+		// Regenerating the site energies of one replica does not change the shared site energies
+		auto params_gaussian = params;
+		params_gaussian.Enable_import_energies = false;
+		params_gaussian.Enable_gaussian_dos = true;
+		EXPECT_TRUE(sim.reset(params_gaussian));
+		EXPECT_FALSE(site_energies == sim.getSiteEnergies(1));
+		EXPECT_TRUE(site_energies == sim2.getSiteEnergies(1));
+		sim.setSharedData(nullptr);
+		// Test conversion from binary to text and back to binary
+		EXPECT_TRUE(OSC_Sim::convertEnergiesFile("./test/energies.bin", "./test/energies_converted.txt"));
+		EXPECT_TRUE(OSC_Sim::convertEnergiesFile("./test/energies_converted.txt", "./test/energies_converted.bin"));
+		// Test conversion to a directory that does not exist
+		EXPECT_FALSE(OSC_Sim::convertEnergiesFile("./test/energies.bin", "./test/missing_dir/energies_converted.txt"));
+		EXPECT_FALSE(OSC_Sim::convertEnergiesFile("./test/energies_converted.txt", "./test/missing_dir/energies_converted.bin"));
+		sim = OSC_Sim();
+		params.Energies_import_filename = "./test/energies_converted.bin";
+		EXPECT_TRUE(sim.init(params, 0));
+		EXPECT_TRUE(site_energies == sim.getSiteEnergies(1));
+		// Test binary energies file with corrupted data
+		fstream binary_file("./test/energies_converted.bin", ios::in | ios::out | ios::binary);
+		binary_file.seekg(100);
+		char byte = (char)binary_file.get();
+		binary_file.seekp(100);
+		binary_file.put((char)~byte);
+		binary_file.close();
+		sim = OSC_Sim();
+		EXPECT_FALSE(sim.init(params, 0));
 		// Test export of electron energies
 		sim = OSC_Sim();
 		params.Enable_import_energies = false;
@@ -1050,6 +1521,81 @@ namespace OSC_SimTests {
 		double dim = 3.0;
 		double expected_ratio = sqrt(2.0 / dim)*(tgamma((dim + 1.0) / 2.0) / tgamma(dim / 2.0));
 		EXPECT_NEAR(expected_ratio, vector_avg(ratio_data), 2e-2*expected_ratio);
+		// Check that the streaming statistics match the raw data
+		EXPECT_EQ((double)lifetime_data.size(), sim.getExcitonLifetimeStats().getCount());
+		EXPECT_NEAR(vector_avg(lifetime_data), sim.getExcitonLifetimeStats().getMean(), 1e-9*vector_avg(lifetime_data));
+		EXPECT_NEAR(vector_stdev(lifetime_data), sim.getExcitonLifetimeStats().getStdev(), 1e-9*vector_stdev(lifetime_data));
+		EXPECT_NEAR(diffusion_length1, sim.getExcitonDiffusionStats().getMean(), 1e-9*diffusion_length1);
+		EXPECT_DOUBLE_EQ(1.0, sim.getExcitonHopLengthStats().getMean());
+		// Check the singlet exciton diffusion results when the events are chosen with the FRM
+		sim = OSC_Sim();
+		params.Enable_FRM = true;
+		EXPECT_TRUE(sim.init(params, 0));
+		while (!sim.checkFinished()) {
+			EXPECT_TRUE(sim.executeNextEvent());
+		}
+		EXPECT_EQ(params.N_tests, sim.getN_excitons_created());
+		lifetime_data = sim.getExcitonLifetimeData();
+		EXPECT_NEAR(params.Singlet_lifetime_donor, vector_avg(lifetime_data), 5e-2*params.Singlet_lifetime_donor);
+		displacement_data = sim.getExcitonDiffusionData();
+		transform(displacement_data.begin(), displacement_data.end(), lifetime_data.begin(), ratio_data.begin(), [params](double& displacement_element, double& lifetime_element) {
+			return displacement_element / sqrt(6 * params.R_singlet_hopping_donor*lifetime_element);
+		});
+		EXPECT_NEAR(expected_ratio, vector_avg(ratio_data), 2e-2*expected_ratio);
+		params.Enable_FRM = false;
+		// Check the singlet exciton diffusion results when the hops are sampled from the escape rate cache
+		sim = OSC_Sim();
+		params.Enable_escape_rate_cache = true;
+		EXPECT_TRUE(sim.init(params, 0));
+		while (!sim.checkFinished()) {
+			EXPECT_TRUE(sim.executeNextEvent());
+		}
+		EXPECT_EQ(params.N_tests, sim.getN_excitons_created());
+		lifetime_data = sim.getExcitonLifetimeData();
+		EXPECT_NEAR(params.Singlet_lifetime_donor, vector_avg(lifetime_data), 5e-2*params.Singlet_lifetime_donor);
+		EXPECT_DOUBLE_EQ(1.0, vector_avg(sim.getExcitonHopLengthData()));
+		displacement_data = sim.getExcitonDiffusionData();
+		transform(displacement_data.begin(), displacement_data.end(), lifetime_data.begin(), ratio_data.begin(), [params](double& displacement_element, double& lifetime_element) {
+			return displacement_element / sqrt(6 * params.R_singlet_hopping_donor*lifetime_element);
+		});
+		EXPECT_NEAR(expected_ratio, vector_avg(ratio_data), 2e-2*expected_ratio);
+		params.Enable_escape_rate_cache = false;
+		// Check that raw data is not stored when raw data retention is disabled
+		sim = OSC_Sim();
+		params.Enable_raw_data_retention = false;
+		EXPECT_TRUE(sim.init(params, 0));
+		while (!sim.checkFinished()) {
+			EXPECT_TRUE(sim.executeNextEvent());
+		}
+		EXPECT_TRUE(sim.getExcitonLifetimeData().empty());
+		EXPECT_TRUE(sim.getExcitonDiffusionData().empty());
+		EXPECT_TRUE(sim.getExcitonHopLengthData().empty());
+		EXPECT_EQ((double)params.N_tests, sim.getExcitonLifetimeStats().getCount());
+		EXPECT_NEAR(params.Singlet_lifetime_donor, sim.getExcitonLifetimeStats().getMean(), 5e-2*params.Singlet_lifetime_donor);
+		// Check adding more tests to a finished simulation
+		EXPECT_FALSE(sim.addTests(0));
+		EXPECT_TRUE(sim.addTests(100));
+		EXPECT_FALSE(sim.checkFinished());
+		while (!sim.checkFinished()) {
+			EXPECT_TRUE(sim.executeNextEvent());
+		}
+		EXPECT_EQ(params.N_tests + 100, sim.getN_singlet_excitons_recombined() + sim.getN_triplet_excitons_recombined());
+		EXPECT_EQ((double)(params.N_tests + 100), sim.getExcitonLifetimeStats().getCount());
+		// Check merging the results of a simulation replica
+		OSC_Sim sim_replica;
+		EXPECT_TRUE(sim_replica.init(params, 1));
+		while (!sim_replica.checkFinished()) {
+			EXPECT_TRUE(sim_replica.executeNextEvent());
+		}
+		auto events_executed = sim.getN_events_executed() + sim_replica.getN_events_executed();
+		auto lifetime_stats = sim.getExcitonLifetimeStats();
+		lifetime_stats.merge(sim_replica.getExcitonLifetimeStats());
+		EXPECT_TRUE(sim.mergeResults(sim_replica));
+		EXPECT_EQ(events_executed, sim.getN_events_executed());
+		EXPECT_EQ(2 * params.N_tests + 100, sim.getN_excitons_created());
+		EXPECT_EQ(2 * params.N_tests + 100, sim.getN_singlet_excitons_recombined() + sim.getN_triplet_excitons_recombined());
+		EXPECT_EQ(lifetime_stats.getCount(), sim.getExcitonLifetimeStats().getCount());
+		EXPECT_DOUBLE_EQ(lifetime_stats.getMean(), sim.getExcitonLifetimeStats().getMean());
 		// Triplet exciton diffusion test
 		sim = OSC_Sim();
 		params = params_default;
@@ -1286,6 +1832,374 @@ namespace OSC_SimTests {
 		EXPECT_GT(N_bimolecular_recombinations2, N_bimolecular_recombinations1);
 	}
 
+	TEST_F(OSC_SimTest, HistogramTests) {
+		cout << "Starting OSC_SimTest.HistogramTests..." << endl;
+		// Check the bin layout
+		Histogram hist(-5.3, -4.7, 0.1);
+		EXPECT_EQ(7, hist.getNumBins());
+		auto data = hist.getData();
+		EXPECT_NEAR(-5.3, data.front().first, 1e-12);
+		EXPECT_NEAR(-4.7, data.back().first, 1e-12);
+		// Check that values are counted in the nearest bin
+		hist.add(-5.0);
+		hist.add(-5.04);
+		hist.add(-4.96);
+		hist.add(-5.33);
+		data = hist.getData();
+		EXPECT_DOUBLE_EQ(3.0, data[3].second);
+		EXPECT_DOUBLE_EQ(1.0, data[0].second);
+		EXPECT_DOUBLE_EQ(0.0, hist.getOutOfRangeCount());
+		// Check that out of range values are counted in the underflow and overflow bins
+		hist.add(-6.0);
+		hist.add(10.0);
+		hist.add(-1e300);
+		hist.add(NAN);
+		EXPECT_DOUBLE_EQ(4.0, hist.getOutOfRangeCount());
+		EXPECT_DOUBLE_EQ(8.0, hist.getTotalCount());
+		// Check merging of histograms
+		Histogram hist2(-5.3, -4.7, 0.1);
+		hist2.add(-5.0);
+		EXPECT_TRUE(hist.merge(hist2));
+		EXPECT_DOUBLE_EQ(4.0, hist.getData()[3].second);
+		EXPECT_DOUBLE_EQ(9.0, hist.getTotalCount());
+		Histogram hist3(-5.3, -4.6, 0.1);
+		EXPECT_FALSE(hist.merge(hist3));
+		// Check clearing of the histogram
+		hist.clear();
+		EXPECT_DOUBLE_EQ(0.0, hist.getTotalCount());
+	}
+
+	TEST_F(OSC_SimTest, StatisticsTests) {
+		cout << "Starting OSC_SimTest.StatisticsTests..." << endl;
+		// Check that an empty data set gives undefined results
+		Statistics stats;
+		EXPECT_DOUBLE_EQ(0.0, stats.getCount());
+		EXPECT_TRUE(std::isnan(stats.getMean()));
+		EXPECT_TRUE(std::isnan(stats.getStdev()));
+		// Check the statistics against the stored data
+		mt19937_64 generator(0);
+		normal_distribution<double> dist(1e-9, 3e-10);
+		vector<double> data(10000);
+		for (auto& item : data) {
+			item = dist(generator);
+		}
+		Statistics stats1;
+		Statistics stats2;
+		for (int i = 0; i < (int)data.size(); i++) {
+			stats.add(data[i]);
+			if (i < 3000) {
+				stats1.add(data[i]);
+			}
+			else {
+				stats2.add(data[i]);
+			}
+		}
+		EXPECT_DOUBLE_EQ((double)data.size(), stats.getCount());
+		EXPECT_NEAR(vector_avg(data), stats.getMean(), 1e-12*vector_avg(data));
+		EXPECT_NEAR(vector_stdev(data), stats.getStdev(), 1e-9*vector_stdev(data));
+		EXPECT_DOUBLE_EQ(*min_element(data.begin(), data.end()), stats.getMin());
+		EXPECT_DOUBLE_EQ(*max_element(data.begin(), data.end()), stats.getMax());
+		// Check merging of statistics from separate data sets
+		stats1.merge(stats2);
+		EXPECT_DOUBLE_EQ(stats.getCount(), stats1.getCount());
+		EXPECT_NEAR(stats.getMean(), stats1.getMean(), 1e-12*stats.getMean());
+		EXPECT_NEAR(stats.getStdev(), stats1.getStdev(), 1e-9*stats.getStdev());
+		EXPECT_DOUBLE_EQ(stats.getMin(), stats1.getMin());
+		EXPECT_DOUBLE_EQ(stats.getMax(), stats1.getMax());
+		// Check merging with an empty data set
+		stats2.clear();
+		stats2.merge(stats1);
+		EXPECT_DOUBLE_EQ(stats1.getMean(), stats2.getMean());
+	}
+
+	TEST_F(OSC_SimTest, RateTreeTests) {
+		cout << "Starting OSC_SimTest.RateTreeTests..." << endl;
+		// Check that an empty tree cannot be sampled
+		RateTree tree;
+		EXPECT_DOUBLE_EQ(0.0, tree.getTotal());
+		EXPECT_EQ(-1, tree.sample(0.5));
+		// Check the total rate and the slot boundaries
+		for (int i = 0; i < 5; i++) {
+			EXPECT_EQ(i, tree.addSlot());
+			tree.setRate(i, (double)(i + 1));
+		}
+		EXPECT_EQ(5, tree.getN_slots());
+		EXPECT_DOUBLE_EQ(15.0, tree.getTotal());
+		EXPECT_EQ(0, tree.sample(0.0));
+		EXPECT_EQ(1, tree.sample(1.5 / 15.0));
+		EXPECT_EQ(4, tree.sample(0.9999));
+		// Check that a target at the total rate chooses the last slot instead of descending past the end of the tree
+		EXPECT_EQ(4, tree.sample(1.0));
+		// Check that a slot with zero rate is never chosen
+		tree.setRate(2, 0.0);
+		EXPECT_DOUBLE_EQ(12.0, tree.getTotal());
+		EXPECT_EQ(3, tree.sample(3.0 / 12.0));
+		// Check that the slots are chosen in proportion to their rates
+		mt19937_64 generator(0);
+		uniform_real_distribution<double> dist(0.0, 1.0);
+		vector<double> counts(5, 0.0);
+		for (int i = 0; i < 100000; i++) {
+			counts[tree.sample(dist(generator))] += 1.0;
+		}
+		EXPECT_DOUBLE_EQ(0.0, counts[2]);
+		for (int i = 0; i < 5; i++) {
+			EXPECT_NEAR(tree.getRate(i) / tree.getTotal(), counts[i] / 100000.0, 0.01);
+		}
+		// Check that removed slots are reused
+		tree.removeSlot(1);
+		EXPECT_EQ(4, tree.getN_slots());
+		EXPECT_DOUBLE_EQ(10.0, tree.getTotal());
+		EXPECT_EQ(1, tree.addSlot());
+		EXPECT_DOUBLE_EQ(0.0, tree.getRate(1));
+		// Check that the tree grows beyond its initial capacity
+		for (int i = 0; i < 100; i++) {
+			tree.setRate(tree.addSlot(), 1.0);
+		}
+		EXPECT_EQ(105, tree.getN_slots());
+		EXPECT_DOUBLE_EQ(110.0, tree.getTotal());
+		// Check that the round-off error from rates that span many orders of magnitude is removed by rebuilding the tree
+		for (int i = 0; i < 10000; i++) {
+			tree.setRate(0, 1e12 + 0.1*i);
+			tree.setRate(0, 1.0);
+		}
+		EXPECT_TRUE(tree.getN_rebuilds() > 0);
+		EXPECT_NEAR(110.0, tree.getTotal(), 1e-9*110.0);
+		// Check clearing of the tree
+		tree.clear();
+		EXPECT_EQ(0, tree.getN_slots());
+		EXPECT_DOUBLE_EQ(0.0, tree.getTotal());
+	}
+
+	TEST_F(OSC_SimTest, EventHeapTests) {
+		cout << "Starting OSC_SimTest.EventHeapTests..." << endl;
+		// Check that an empty heap has no top slot
+		EventHeap heap;
+		EXPECT_EQ(-1, heap.getTop());
+		// Check that new slots have an infinite time
+		EXPECT_EQ(0, heap.addSlot());
+		EXPECT_TRUE(std::isinf(heap.getTime(0)));
+		heap.setTime(0, 2.0);
+		EXPECT_EQ(1, heap.addSlot());
+		heap.setTime(1, 1.0);
+		EXPECT_EQ(1, heap.getTop());
+		heap.setTime(1, 3.0);
+		EXPECT_EQ(0, heap.getTop());
+		heap.clear();
+		EXPECT_EQ(0, heap.getN_slots());
+		// Check the top slot against a linear search after every step of a random sequence of insertions, updates, and removals
+		mt19937_64 generator(0);
+		uniform_real_distribution<double> dist(0.0, 1.0);
+		vector<double> times;
+		vector<int> active_slots;
+		bool success = true;
+		for (int i = 0; i < 100000 && success; i++) {
+			double random_num = dist(generator);
+			// Insert a new slot
+			if (active_slots.size() < 10 || random_num < 0.3) {
+				int slot = heap.addSlot();
+				if (slot >= (int)times.size()) {
+					times.resize(slot + 1);
+				}
+				times[slot] = dist(generator);
+				heap.setTime(slot, times[slot]);
+				active_slots.push_back(slot);
+			}
+			// Remove a random slot
+			else if (random_num < 0.6) {
+				int index = (int)(dist(generator)*active_slots.size());
+				heap.removeSlot(active_slots[index]);
+				active_slots[index] = active_slots.back();
+				active_slots.pop_back();
+			}
+			// Move the time of a random slot earlier or later
+			else {
+				int slot = active_slots[(int)(dist(generator)*active_slots.size())];
+				times[slot] = (dist(generator) < 0.5) ? 0.5*times[slot] : times[slot] + dist(generator);
+				heap.setTime(slot, times[slot]);
+			}
+			int slot_min = -1;
+			for (auto slot : active_slots) {
+				if (slot_min < 0 || times[slot] < times[slot_min]) {
+					slot_min = slot;
+				}
+			}
+			success = (heap.getN_slots() == (int)active_slots.size()) && (heap.getTop() == slot_min);
+		}
+		EXPECT_TRUE(success);
+		for (auto slot : active_slots) {
+			EXPECT_DOUBLE_EQ(times[slot], heap.getTime(slot));
+		}
+		// Check that removed slots are reused
+		int slot_removed = active_slots.back();
+		heap.removeSlot(slot_removed);
+		EXPECT_EQ(slot_removed, heap.addSlot());
+	}
+
+	TEST_F(OSC_SimTest, EscapeRateCacheTests) {
+		cout << "Starting OSC_SimTest.EscapeRateCacheTests..." << endl;
+		// Check that a missing key is not found
+		EscapeRateCache cache(2);
+		EXPECT_EQ(nullptr, cache.find(0));
+		EXPECT_EQ(1, cache.getN_misses());
+		// Check that an entry without targets cannot be sampled
+		auto entry = cache.insert(0, {}, {});
+		EXPECT_DOUBLE_EQ(0.0, entry.rate_total);
+		EXPECT_EQ(-1, EscapeRateCache::sample(entry, 0.5, 0.5));
+		// Check the total rate and that the targets are chosen in proportion to their rates
+		vector<int> targets = { 10, 11, 12, 13, 14 };
+		vector<double> rates = { 1.0, 0.0, 5.0, 1e-3, 3.999 };
+		entry = cache.insert(1, targets, rates);
+		EXPECT_DOUBLE_EQ(10.0, entry.rate_total);
+		mt19937_64 generator(0);
+		uniform_real_distribution<double> dist(0.0, 1.0);
+		vector<double> counts(5, 0.0);
+		for (int i = 0; i < 200000; i++) {
+			int target = EscapeRateCache::sample(entry, dist(generator), dist(generator));
+			counts[target - 10] += 1.0;
+		}
+		EXPECT_DOUBLE_EQ(0.0, counts[1]);
+		for (int i = 0; i < 5; i++) {
+			EXPECT_NEAR(rates[i] / 10.0, counts[i] / 200000.0, 0.005);
+		}
+		// Check that the least recently used entry is removed when the cache is full
+		ASSERT_NE(nullptr, cache.find(0));
+		cache.insert(2, { 20 }, { 1.0 });
+		EXPECT_EQ(2, cache.size());
+		EXPECT_EQ(1, cache.getN_evictions());
+		EXPECT_EQ(nullptr, cache.find(1));
+		ASSERT_NE(nullptr, cache.find(2));
+		EXPECT_EQ(20, EscapeRateCache::sample(*cache.find(2), 0.99, 0.99));
+		EXPECT_EQ(3, cache.getN_hits());
+		// Check that reducing the capacity removes the least recently used entries
+		cache.setCapacity(1);
+		EXPECT_EQ(1, cache.size());
+		EXPECT_EQ(nullptr, cache.find(0));
+		EXPECT_NE(nullptr, cache.find(2));
+		// Check clearing of the cache
+		cache.clear();
+		EXPECT_EQ(0, cache.size());
+		EXPECT_EQ(0, cache.getN_evictions());
+		EXPECT_EQ(1, cache.getCapacity());
+	}
+
+	TEST_F(OSC_SimTest, ProfilerTests) {
+		cout << "Starting OSC_SimTest.ProfilerTests..." << endl;
+		// Check the section names
+		EXPECT_EQ("calculateCoulomb", Profiler::getSectionName(Profiler::Calculate_coulomb));
+		EXPECT_EQ("updateTransientData", Profiler::getSectionName(Profiler::Update_transient_data));
+		EXPECT_EQ("", Profiler::getSectionName(Profiler::N_sections));
+		// Check the JSON export of calls, items, and events
+		Profiler profiler1;
+		profiler1.addCall(Profiler::Choose_next_event, 2e-6);
+		profiler1.addItems(Profiler::Choose_next_event, 10);
+		profiler1.addEvent(EventTrace::Polaron_hop);
+		profiler1.addCall(Profiler::Choose_next_event, 4e-6);
+		profiler1.addItems(Profiler::Choose_next_event, 30);
+		profiler1.addEvent(EventTrace::Polaron_hop);
+		stringstream ss1;
+		profiler1.exportJSON(ss1);
+		EXPECT_NE(string::npos, ss1.str().find("\"chooseNextEvent\": { \"calls\": 2, \"total_time_s\": 6e-06, \"mean_time_ns\": 3000, \"mean_items\": 20 }"));
+		EXPECT_NE(string::npos, ss1.str().find("\"Polaron Hop\": { \"count\": 2, \"mean_candidates\": 20 }"));
+		EXPECT_NE(string::npos, ss1.str().find("\"Exciton Hop\": { \"count\": 0, \"mean_candidates\": 0 }"));
+		// Check merging of profiles and the summary of multiple profiles
+		Profiler profiler2;
+		profiler2.addCall(Profiler::Choose_next_event, 6e-6);
+		profiler2.addItems(Profiler::Choose_next_event, 50);
+		profiler2.addEvent(EventTrace::Polaron_hop);
+		stringstream ss2;
+		Profiler::exportSummaryJSON(ss2, { profiler1, profiler2 });
+		EXPECT_NE(string::npos, ss2.str().find("\"N_procs\": 2"));
+		EXPECT_NE(string::npos, ss2.str().find("\"chooseNextEvent\": { \"calls\": 3, \"total_time_s\": 1.2e-05, \"mean_time_ns\": 4000, \"mean_items\": 30 }"));
+		EXPECT_NE(string::npos, ss2.str().find("\"Polaron Hop\": { \"count\": 3, \"mean_candidates\": 30 }"));
+		profiler1.merge(profiler2);
+		stringstream ss3;
+		profiler1.exportJSON(ss3);
+		EXPECT_NE(string::npos, ss3.str().find("\"Polaron Hop\": { \"count\": 3, \"mean_candidates\": 30 }"));
+		// Check clearing of a profile
+		profiler1.clear();
+		stringstream ss4;
+		profiler1.exportJSON(ss4);
+		EXPECT_NE(string::npos, ss4.str().find("\"chooseNextEvent\": { \"calls\": 0, \"total_time_s\": 0, \"mean_time_ns\": 0, \"mean_items\": 0 }"));
+		// Check that a simulation only collects profile data when the profiling instrumentation is compiled in
+		sim = OSC_Sim();
+		EXPECT_TRUE(sim.init(params_default, 0));
+		for (int i = 0; i < 100; i++) {
+			EXPECT_TRUE(sim.executeNextEvent());
+		}
+		stringstream ss5;
+		sim.getProfiler().exportJSON(ss5);
+		EXPECT_EQ(Profiler::isEnabled(), ss5.str().find("\"chooseNextEvent\": { \"calls\": 100,") != string::npos);
+	}
+
+	TEST_F(OSC_SimTest, CoulombFieldTests) {
+		cout << "Starting OSC_SimTest.CoulombFieldTests..." << endl;
+		// Lattices with odd and even sizes, periodic and non-periodic boundaries, and cutoffs that are larger and smaller than the lattice
+		struct LatticeCase {
+			int length;
+			int width;
+			int height;
+			bool periodic_x;
+			bool periodic_y;
+			bool periodic_z;
+			int cutoff;
+		};
+		vector<LatticeCase> lattice_cases = {
+			{ 10, 11, 9, true, true, true, 20 },
+			{ 11, 10, 12, true, true, false, 20 },
+			{ 9, 12, 10, false, false, false, 20 },
+			{ 12, 12, 12, true, true, true, 4 },
+			{ 13, 12, 11, true, false, false, 3 }
+		};
+		mt19937 generator(12345);
+		for (const auto& lattice_case : lattice_cases) {
+			auto params = params_default;
+			params.Params_lattice.Length = lattice_case.length;
+			params.Params_lattice.Width = lattice_case.width;
+			params.Params_lattice.Height = lattice_case.height;
+			params.Params_lattice.Enable_periodic_x = lattice_case.periodic_x;
+			params.Params_lattice.Enable_periodic_y = lattice_case.periodic_y;
+			params.Params_lattice.Enable_periodic_z = lattice_case.periodic_z;
+			params.Coulomb_cutoff = lattice_case.cutoff;
+			sim = OSC_Sim();
+			ASSERT_TRUE(sim.init(params, 0));
+			// Place electrons and holes on distinct random sites
+			set<tuple<int, int, int>> occupied_sites;
+			uniform_int_distribution<int> dist_x(0, lattice_case.length - 1);
+			uniform_int_distribution<int> dist_y(0, lattice_case.width - 1);
+			uniform_int_distribution<int> dist_z(0, lattice_case.height - 1);
+			while (occupied_sites.size() < 40) {
+				Coords coords(dist_x(generator), dist_y(generator), dist_z(generator));
+				if (!occupied_sites.insert(make_tuple(coords.x, coords.y, coords.z)).second) {
+					continue;
+				}
+				if (occupied_sites.size() % 2 == 0) {
+					OSC_SimTestAccess::generateElectron(sim, coords);
+				}
+				else {
+					OSC_SimTestAccess::generateHole(sim, coords);
+				}
+			}
+			// Check that the Coulomb field matches the per-site calculation at every site for both charges
+			for (bool charge : { false, true }) {
+				vector<double> energies;
+				OSC_SimTestAccess::calculateCoulombField(sim, charge, energies);
+				int N_mismatches = 0;
+				for (int x = 0; x < lattice_case.length; x++) {
+					for (int y = 0; y < lattice_case.width; y++) {
+						for (int z = 0; z < lattice_case.height; z++) {
+							Coords coords(x, y, z);
+							double energy_expected = OSC_SimTestAccess::calculateCoulomb(sim, charge, coords);
+							if (fabs(energies[OSC_SimTestAccess::getSiteIndex(sim, coords)] - energy_expected) > 1e-9) {
+								N_mismatches++;
+							}
+						}
+					}
+				}
+				EXPECT_EQ(0, N_mismatches);
+			}
+		}
+	}
+
 	TEST_F(OSC_SimTest, SteadyTransportTests) {
 		cout << "Starting OSC_SimTest.SteadyTransportTests..." << endl;
 		// Check that error is generated when there are not enough donor sites to create the specified number of initial polarons with phase restriction
@@ -1401,6 +2315,8 @@ namespace OSC_SimTests {
 		EXPECT_NEAR(peak_position, expected_energy, 1e-2*params.Homo_donor);
 		// Check the DOOS integral
 		EXPECT_NEAR(params.Steady_carrier_density, integrateData(DOOS_data), 5e-2*params.Steady_carrier_density);
+		// Check that all of the sampled state energies are within the histogram range
+		EXPECT_DOUBLE_EQ(0.0, sim.getSteadyDOSOutOfRangeCount());
 		// Steady transport test with Gaussian disorder at medium field
 		sim = OSC_Sim();
 		params = params_default;
@@ -1493,9 +2409,21 @@ namespace OSC_SimTests {
 		auto hist = sim.calculateTransitTimeHist(transit_time_data, (int)transit_time_data.size());
 		auto cum_hist = calculateCumulativeHist(hist);
 		EXPECT_NEAR(1.0, cum_hist.back().second, 1e-3);
+		// Check that the log-binned transit time histogram matches the histogram calculated from the raw data
+		auto hist_streaming = sim.calculateTransitTimeHist(sim.getTransitTimeHistogram(), (int)transit_time_data.size());
+		ASSERT_EQ(hist.size(), hist_streaming.size());
+		for (int i = 0; i < (int)hist.size(); i++) {
+			EXPECT_NEAR(hist[i].first, hist_streaming[i].first, 1e-6*hist[i].first);
+			EXPECT_NEAR(hist[i].second, hist_streaming[i].second, 1e-2);
+		}
 		// Check the mobility compared to analytical expectation
 		auto mobility_data = sim.calculateMobilityData(transit_time_data);
 		double mobility1 = vector_avg(mobility_data);
+		// Check that the streaming statistics match the raw data
+		EXPECT_NEAR(vector_avg(transit_time_data), sim.getTransitTimeStats().getMean(), 1e-9*vector_avg(transit_time_data));
+		EXPECT_NEAR(vector_stdev(transit_time_data), sim.getTransitTimeStats().getStdev(), 1e-9*vector_stdev(transit_time_data));
+		EXPECT_NEAR(mobility1, sim.getTransitMobilityStats().getMean(), 1e-9*mobility1);
+		EXPECT_NEAR(vector_stdev(mobility_data), sim.getTransitMobilityStats().getStdev(), 1e-9*vector_stdev(mobility_data));
 		double dim = 3.0;
 		double rate_constant = params.R_polaron_hopping_donor*exp(-2.0*params.Polaron_localization_donor);
 		double expected_mobility = (rate_constant*1e-14) * (2.0 / 3.0) * (tgamma((dim + 1.0) / 2.0) / tgamma(dim / 2.0)) * (1 / (K_b*params.Temperature));
@@ -1619,6 +2547,77 @@ namespace OSC_SimTests {
 		vec = sim.getChargeExtractionMap(true);
 		EXPECT_EQ(vec[0], "X-Position,Y-Position,Extraction Probability");
 		EXPECT_EQ(vec[1], "0,0,0");
+		// Hole ToF test with rate thinning and a large recalculation cutoff
+		sim = OSC_Sim();
+		params = params_default;
+		params.Params_lattice.Enable_periodic_z = false;
+		params.Internal_potential = -4.0;
+		params.Enable_exciton_diffusion_test = false;
+		params.Enable_ToF_test = true;
+		params.Params_lattice.Height = 200;
+		params.N_tests = 1000;
+		params.Recalc_cutoff = 15;
+		params.Enable_rate_thinning = true;
+		EXPECT_TRUE(sim.init(params, 0));
+		while (!sim.checkFinished()) {
+			EXPECT_TRUE(sim.executeNextEvent());
+		}
+		// Check that some hops were rejected as null events
+		EXPECT_GT(sim.getN_null_events(), 0);
+		// Check the mobility compared to analytical expectation
+		mobility_data = sim.calculateMobilityData(sim.getTransitTimeData());
+		rate_constant = params.R_polaron_hopping_donor*exp(-2.0*params.Polaron_localization_donor);
+		expected_mobility = (rate_constant*1e-14) * (2.0 / 3.0) * (tgamma((dim + 1.0) / 2.0) / tgamma(dim / 2.0)) * (1 / (K_b*params.Temperature));
+		EXPECT_NEAR(expected_mobility, vector_avg(mobility_data), 1.5e-1*expected_mobility);
+		// Hole ToF test with the hops sampled from the escape rate cache
+		sim = OSC_Sim();
+		params.Enable_rate_thinning = false;
+		params.Recalc_cutoff = params_default.Recalc_cutoff;
+		params.Enable_escape_rate_cache = true;
+		EXPECT_TRUE(sim.init(params, 0));
+		while (!sim.checkFinished()) {
+			EXPECT_TRUE(sim.executeNextEvent());
+		}
+		EXPECT_EQ(params.N_tests, (int)sim.getTransitTimeData().size());
+		mobility_data = sim.calculateMobilityData(sim.getTransitTimeData());
+		EXPECT_NEAR(expected_mobility, vector_avg(mobility_data), 1.5e-1*expected_mobility);
+		// Hole ToF test with Gaussian disorder and without superbasin acceleration
+		sim = OSC_Sim();
+		params = params_default;
+		params.Params_lattice.Enable_periodic_z = false;
+		params.Internal_potential = -2.0;
+		params.Enable_exciton_diffusion_test = false;
+		params.Enable_ToF_test = true;
+		params.Params_lattice.Height = 100;
+		params.N_tests = 200;
+		params.ToF_transient_end = 1e-2;
+		params.Enable_gaussian_dos = true;
+		params.Energy_stdev_donor = 0.1;
+		params.Generator_seed = 3;
+		EXPECT_TRUE(sim.init(params, 0));
+		while (!sim.checkFinished()) {
+			EXPECT_TRUE(sim.executeNextEvent());
+		}
+		mobility_data = sim.calculateMobilityData(sim.getTransitTimeData());
+		double mobility_reference = vector_avg(mobility_data);
+		energy_transient = sim.getToFTransientEnergies();
+		counts_data = sim.getToFTransientCounts();
+		double energy_reference = accumulate(energy_transient.begin(), energy_transient.end(), 0.0) / accumulate(counts_data.begin(), counts_data.end(), 0.0);
+		// Hole ToF test with the same seed and site energies and with superbasin acceleration
+		sim = OSC_Sim();
+		params.Enable_superbasin_acceleration = true;
+		EXPECT_TRUE(sim.init(params, 0));
+		while (!sim.checkFinished()) {
+			EXPECT_TRUE(sim.executeNextEvent());
+		}
+		// Check that the trapped holes have left superbasins with accelerated exit events
+		EXPECT_GT(sim.getN_superbasin_exits(), 0);
+		// Check that the mobility and the average transport energy are close to those without superbasin acceleration
+		mobility_data = sim.calculateMobilityData(sim.getTransitTimeData());
+		EXPECT_NEAR(mobility_reference, vector_avg(mobility_data), 2.5e-1*mobility_reference);
+		energy_transient = sim.getToFTransientEnergies();
+		counts_data = sim.getToFTransientCounts();
+		EXPECT_NEAR(energy_reference, accumulate(energy_transient.begin(), energy_transient.end(), 0.0) / accumulate(counts_data.begin(), counts_data.end(), 0.0), 1e-2);
 	}
 
 	TEST_F(OSC_SimTest, InterfacialEnergyShiftTests) {